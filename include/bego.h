@@ -5,6 +5,8 @@
 #include <stdexcept>
 #include <memory>
 #include <optional>
+#include <chrono>
+#include <string_view>
 
 /**
  * @file bego.h
@@ -140,6 +142,12 @@ public:
      * @brief Whether mouse movements are subject to Windows acceleration
      */
     bool windows_subject_to_mouse_speed_and_acceleration_level = false;
+    
+    /**
+     * @brief Maximum time a key, scan code or button may stay held
+     * @details Anything held for longer is released automatically. Zero disables the limit.
+     */
+    std::chrono::milliseconds max_hold_duration{0};
 };
 
 /**
@@ -148,6 +156,12 @@ public:
  */
 constexpr unsigned int EVENT_MARKER = 0x12345678;
 
+/**
+ * @brief Library version, matching the CMake project version
+ * @details Part of the key of cached data that depends on library internals
+ */
+constexpr const char* LIBRARY_VERSION = "0.1.0";
+
 /**
  * @class Mouse
  * @brief Interface for mouse functionality
@@ -271,6 +285,31 @@ enum class Key {
     Unicode
 };
 
+/**
+ * @brief Look up a key by name
+ * @details Names match the Key enumerators case-insensitively ("PageUp", "f5", "num1"),
+ * and a few common aliases are accepted ("enter", "esc", "ctrl", "win", "0"-"9")
+ * @param name The key name
+ * @return std::optional<Key> The key, or std::nullopt if the name is unknown
+ */
+std::optional<Key> key_from_name(std::string_view name);
+
+/**
+ * @brief Get the canonical name of a key
+ * @param key The key
+ * @return const char* The enumerator name, e.g. "PageUp"
+ */
+const char* key_name(Key key);
+
+/**
+ * @brief Look up a mouse button by name
+ * @details Names match the Button enumerators case-insensitively; "x1" and "x2"
+ * are accepted for Back and Forward
+ * @param name The button name
+ * @return std::optional<Button> The button, or std::nullopt if the name is unknown
+ */
+std::optional<Button> button_from_name(std::string_view name);
+
 /**
  * @brief Helper function to set DPI awareness (Windows-specific)
  * @return bool True if successful, false otherwise
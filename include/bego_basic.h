@@ -0,0 +1,468 @@
+#pragma once
+
+#include "bego_static.h"
+#include "bego_win.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @file bego_basic.h
+ * @author Eterninety
+ * @brief Policy-based variant of Bego whose optional features compile out
+ * @version 1.0
+ *
+ * @details Bego decides at run time what to do around every call: it locks a mutex,
+ * dispatches through a virtual backend, updates the held key lists and the hold
+ * scheduler, and checks its settings. BasicBego takes those decisions as template
+ * parameters instead, so a configuration that does not need a feature does not pay
+ * for it. Each policy is an empty class unless it keeps state, and is stored as a
+ * base so that empty policies take no space.
+ *
+ * @code
+ * // Sends straight to SendInput, throws on failure, remembers nothing
+ * bego::BasicBego<bego::Win32Backend, bego::NoTracking> lean;
+ *
+ * // Counts dispatches and records errors instead of throwing
+ * bego::BasicBego<bego::Win32Backend, bego::HeldTracking, bego::CountingInstrumentation,
+ *                 bego::RecordErrors> checked;
+ * @endcode
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace bego {
+
+/**
+ * @struct NoTracking
+ * @brief Tracking policy that remembers nothing; held inputs stay down when the instance goes away
+ */
+struct NoTracking {
+    void track(const Event*, size_t) {}
+    void release_events(std::vector<Event>&) {}
+};
+
+/**
+ * @struct HeldTracking
+ * @brief Tracking policy that remembers held keys, scan codes and buttons and releases them at the end
+ *
+ * @details This is the equivalent of Settings::release_keys_when_dropped. Inputs are
+ * identified the way Windows identifies them: scan code events by scan code, other key
+ * events by virtual key and buttons by button. Unicode events are always clicked and
+ * are not tracked.
+ */
+class HeldTracking {
+public:
+    /**
+     * @brief Update the held inputs from dispatched events
+     * @param events Pointer to the first event
+     * @param count Number of events
+     */
+    void track(const Event* events, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            const Event& event = events[i];
+            bool down = event.kind == EventKind::KeyDown || event.kind == EventKind::ButtonDown;
+            bool up = event.kind == EventKind::KeyUp || event.kind == EventKind::ButtonUp;
+            if ((!down && !up) || (event.flags & event_flags::Unicode)) {
+                continue;
+            }
+
+            uint32_t id = identity(event);
+            auto it = std::find_if(held.begin(), held.end(), [id](const Event& e) { return identity(e) == id; });
+            if (down && it == held.end()) {
+                held.push_back(event);
+            } else if (up && it != held.end()) {
+                held.erase(it);
+            }
+        }
+    }
+
+    /**
+     * @brief Queue the releases of everything held, most recent first, and forget it
+     * @param input_queue The queue to add the releases to
+     */
+    void release_events(std::vector<Event>& input_queue) {
+        for (auto it = held.rbegin(); it != held.rend(); ++it) {
+            Event release = *it;
+            release.kind = release.kind == EventKind::KeyDown ? EventKind::KeyUp : EventKind::ButtonUp;
+            input_queue.push_back(release);
+        }
+        held.clear();
+    }
+
+    /**
+     * @brief Get the press events of the inputs currently held, oldest first
+     * @return const std::vector<Event>& The held inputs
+     */
+    const std::vector<Event>& held_events() const { return held; }
+
+private:
+    static uint32_t identity(const Event& event) {
+        if (event.kind == EventKind::ButtonDown || event.kind == EventKind::ButtonUp) {
+            return 0x20000u | event.code;
+        }
+        if (event.flags & event_flags::Scancode) {
+            return 0x10000u | ((event.flags & event_flags::Extended) ? 0x100u : 0u) | (event.payload & 0xFF);
+        }
+        return event.code;
+    }
+
+    std::vector<Event> held;
+};
+
+/**
+ * @struct NoInstrumentation
+ * @brief Instrumentation policy that observes nothing
+ */
+struct NoInstrumentation {
+    void before_dispatch(const Event*, size_t) {}
+    void after_dispatch(const Event*, size_t) {}
+};
+
+/**
+ * @class CountingInstrumentation
+ * @brief Instrumentation policy that counts dispatches and events and times the backend
+ */
+class CountingInstrumentation {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    void before_dispatch(const Event*, size_t) {
+        started = Clock::now();
+    }
+
+    void after_dispatch(const Event*, size_t count) {
+        dispatches++;
+        events += count;
+        busy += Clock::now() - started;
+    }
+
+    /**
+     * @brief Get the number of batches handed to the backend
+     * @return uint64_t The dispatch count
+     */
+    uint64_t dispatch_count() const { return dispatches; }
+
+    /**
+     * @brief Get the number of events handed to the backend
+     * @return uint64_t The event count
+     */
+    uint64_t event_count() const { return events; }
+
+    /**
+     * @brief Get the time spent in the backend
+     * @return Clock::duration The total dispatch time
+     */
+    Clock::duration dispatch_time() const { return busy; }
+
+private:
+    uint64_t dispatches = 0;
+    uint64_t events = 0;
+    Clock::duration busy{};
+    Clock::time_point started;
+};
+
+/**
+ * @struct ThrowOnError
+ * @brief Error policy that lets InputError propagate, as Bego does
+ */
+struct ThrowOnError {
+    template <typename F>
+    bool run(F&& f) {
+        f();
+        return true;
+    }
+};
+
+/**
+ * @class RecordErrors
+ * @brief Error policy that catches InputError, counts it and keeps its message
+ */
+class RecordErrors {
+public:
+    template <typename F>
+    bool run(F&& f) {
+        try {
+            f();
+            return true;
+        } catch (const InputError& e) {
+            failures++;
+            last = e.what();
+            return false;
+        }
+    }
+
+    /**
+     * @brief Get the number of calls that failed
+     * @return uint64_t The failure count
+     */
+    uint64_t failure_count() const { return failures; }
+
+    /**
+     * @brief Get the message of the last failure
+     * @return const std::string& The message, empty if nothing failed
+     */
+    const std::string& last_error() const { return last; }
+
+private:
+    uint64_t failures = 0;
+    std::string last;
+};
+
+namespace detail {
+
+template <typename T, typename = void>
+struct has_screen_size : std::false_type {};
+
+template <typename T>
+struct has_screen_size<T, std::void_t<decltype(std::declval<T&>().screen_size())>> : std::true_type {};
+
+template <typename T, typename = void>
+struct has_cursor_position : std::false_type {};
+
+template <typename T>
+struct has_cursor_position<T, std::void_t<decltype(std::declval<T&>().cursor_position())>> : std::true_type {};
+
+} // namespace detail
+
+/**
+ * @class BasicBego
+ * @brief Input simulation with its backend and optional features chosen at compile time
+ *
+ * @details The backend is stored by value and called without virtual dispatch; it only
+ * needs a dispatch(const Event*, size_t) member, and may answer screen_size() and
+ * cursor_position() like a Backend. Events are built by the same static queue functions
+ * as Bego's into a buffer that is reused between calls.
+ *
+ * Unlike Bego, a BasicBego is not synchronized and has no hold scheduler: use one
+ * instance per thread, or Bego where several threads or timed holds are needed.
+ * Relative moves are converted to absolute ones from the cursor position, like Bego
+ * with its default settings; pre-built relative moves passed to send() are subject
+ * to pointer acceleration.
+ *
+ * BasicBego implements StaticMouse and StaticKeyboard, so generic code templated on
+ * them runs on it without virtual calls.
+ *
+ * Every method returns true once its events were delivered. With ThrowOnError it
+ * never returns false; with RecordErrors a failure is recorded and false is returned.
+ *
+ * @tparam BackendType Destination of the events
+ * @tparam TrackingPolicy NoTracking or HeldTracking
+ * @tparam InstrumentationPolicy NoInstrumentation or CountingInstrumentation
+ * @tparam ErrorPolicy ThrowOnError or RecordErrors
+ */
+template <typename BackendType = Win32Backend,
+          typename TrackingPolicy = HeldTracking,
+          typename InstrumentationPolicy = NoInstrumentation,
+          typename ErrorPolicy = ThrowOnError>
+class BasicBego : public StaticMouse<BasicBego<BackendType, TrackingPolicy, InstrumentationPolicy, ErrorPolicy>>,
+                  public StaticKeyboard<BasicBego<BackendType, TrackingPolicy, InstrumentationPolicy, ErrorPolicy>>,
+                  private TrackingPolicy,
+                  private InstrumentationPolicy,
+                  private ErrorPolicy {
+public:
+    /**
+     * @brief Construct the instance and its backend in place
+     * @param args Arguments forwarded to the backend's constructor
+     */
+    template <typename... Args>
+    explicit BasicBego(Args&&... args) : backend_(std::forward<Args>(args)...) {
+        buffer.reserve(64);
+    }
+
+    BasicBego(const BasicBego&) = delete;
+    BasicBego& operator=(const BasicBego&) = delete;
+
+    /**
+     * @brief Release whatever the tracking policy still holds
+     */
+    ~BasicBego() {
+        buffer.clear();
+        TrackingPolicy::release_events(buffer);
+        if (!buffer.empty()) {
+            try {
+                deliver(buffer.data(), buffer.size());
+            } catch (const std::exception&) {
+                // Nothing can be done about it here
+            }
+        }
+    }
+
+    /**
+     * @brief Simulate a key press, release, or click
+     * @param key The key to simulate
+     * @param direction Whether to press, release, or click the key
+     * @return bool True if the events were delivered
+     */
+    bool key(Key key, Direction direction) {
+        return ErrorPolicy::run([&] {
+            buffer.clear();
+            Bego::queue_key(buffer, key, direction);
+            deliver(buffer.data(), buffer.size());
+        });
+    }
+
+    /**
+     * @brief Send a raw keyboard scan code
+     * @param scan The hardware scan code to send
+     * @param direction Whether to press, release, or click the key
+     * @return bool True if the events were delivered
+     */
+    bool raw(uint16_t scan, Direction direction) {
+        return ErrorPolicy::run([&] {
+            buffer.clear();
+            Bego::queue_raw(buffer, scan, direction);
+            deliver(buffer.data(), buffer.size());
+        });
+    }
+
+    /**
+     * @brief Simulate a mouse button press, release, or click
+     * @param button The mouse button to simulate
+     * @param direction Whether to press, release, or click the button
+     * @return bool True if the events were delivered
+     */
+    bool button(Button button, Direction direction) {
+        return ErrorPolicy::run([&] {
+            buffer.clear();
+            Bego::queue_button(buffer, button, direction);
+            deliver(buffer.data(), buffer.size());
+        });
+    }
+
+    /**
+     * @brief Simulate mouse wheel scrolling
+     * @param length The amount to scroll (positive or negative)
+     * @param axis Whether to scroll vertically or horizontally
+     * @return bool True if the events were delivered
+     */
+    bool scroll(int length, Axis axis) {
+        return ErrorPolicy::run([&] {
+            buffer.clear();
+            Bego::queue_scroll(buffer, length, axis);
+            deliver(buffer.data(), buffer.size());
+        });
+    }
+
+    /**
+     * @brief Move the mouse cursor
+     * @param x The x-coordinate or x-distance
+     * @param y The y-coordinate or y-distance
+     * @param coordinate Whether the coordinates are absolute or relative
+     * @return bool True if the events were delivered
+     */
+    bool move_mouse(int x, int y, Coordinate coordinate) {
+        return ErrorPolicy::run([&] {
+            if (coordinate == Coordinate::Rel) {
+                auto [current_x, current_y] = location();
+                x += current_x;
+                y += current_y;
+            }
+            buffer.clear();
+            Bego::queue_absolute_move(buffer, x, y, main_display());
+            deliver(buffer.data(), buffer.size());
+        });
+    }
+
+    /**
+     * @brief Type text
+     * @param text The text to type
+     * @return bool True if the events were delivered
+     */
+    bool text(const std::string& text) {
+        return ErrorPolicy::run([&] {
+            buffer.clear();
+            Bego::queue_text(buffer, text);
+            if (!buffer.empty()) {
+                deliver(buffer.data(), buffer.size());
+            }
+        });
+    }
+
+    /**
+     * @brief No fast text entry is available
+     * @return std::optional<bool> std::nullopt
+     */
+    std::optional<bool> fast_text(const std::string&) {
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Send pre-built events in a single dispatch
+     * @param events Pointer to the first event
+     * @param count Number of events
+     * @return bool True if the events were delivered
+     */
+    bool send(const Event* events, size_t count) {
+        return ErrorPolicy::run([&] { deliver(events, count); });
+    }
+
+    /**
+     * @brief Get the dimensions of the main display, from the backend if it simulates one
+     * @return std::pair<int, int> Width and height in pixels
+     * @throws InputError If the screen dimensions could not be retrieved
+     */
+    std::pair<int, int> main_display() {
+        if constexpr (detail::has_screen_size<BackendType>::value) {
+            if (auto size = backend_.BackendType::screen_size()) {
+                return *size;
+            }
+        }
+
+        int width = GetSystemMetrics(SM_CXSCREEN);
+        int height = GetSystemMetrics(SM_CYSCREEN);
+        if (width == 0 || height == 0) {
+            throw InputError(InputError::Type::Simulate, "Could not get the dimensions of the screen");
+        }
+        return {width, height};
+    }
+
+    /**
+     * @brief Get the cursor position, from the backend if it simulates one
+     * @return std::pair<int, int> The position in pixels
+     * @throws InputError If the cursor position could not be retrieved
+     */
+    std::pair<int, int> location() {
+        if constexpr (detail::has_cursor_position<BackendType>::value) {
+            if (auto position = backend_.BackendType::cursor_position()) {
+                return *position;
+            }
+        }
+
+        POINT point;
+        if (!GetCursorPos(&point)) {
+            throw InputError(InputError::Type::Simulate, "Could not get the current mouse location");
+        }
+        return {point.x, point.y};
+    }
+
+    BackendType& backend() { return backend_; }
+    TrackingPolicy& tracking() { return *this; }
+    InstrumentationPolicy& instrumentation() { return *this; }
+    ErrorPolicy& errors() { return *this; }
+
+private:
+    /**
+     * @brief Hand events to the backend between the instrumentation hooks and track them
+     * @details The qualified call binds the backend's own dispatch statically
+     */
+    void deliver(const Event* events, size_t count) {
+        InstrumentationPolicy::before_dispatch(events, count);
+        backend_.BackendType::dispatch(events, count);
+        InstrumentationPolicy::after_dispatch(events, count);
+        TrackingPolicy::track(events, count);
+    }
+
+    BackendType backend_;
+    std::vector<Event> buffer;
+};
+
+} // namespace bego
@@ -0,0 +1,239 @@
+#pragma once
+
+#include "bego.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+/**
+ * @file bego_event.h
+ * @author Eterninety
+ * @brief Compact internal event representation and the backend interface that consumes it
+ * @version 1.0
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace bego {
+
+/**
+ * @enum EventKind
+ * @brief The kind of a buffered input event
+ */
+enum class EventKind : uint8_t {
+    KeyDown,     ///< Key pressed; code is the virtual key, payload the scan code or UTF-16 unit
+    KeyUp,       ///< Key released; same fields as KeyDown
+    ButtonDown,  ///< Mouse button pressed; code is the Button enum value
+    ButtonUp,    ///< Mouse button released; code is the Button enum value
+    MoveAbs,     ///< Absolute move; payload packs normalized 0-65535 x and y
+    MoveRel,     ///< Relative move; payload packs signed 16-bit dx and dy
+    Wheel,       ///< Vertical wheel; payload is the signed wheel data
+    HWheel       ///< Horizontal wheel; payload is the signed wheel data
+};
+
+/**
+ * @brief Number of distinct event kinds
+ */
+constexpr size_t EVENT_KIND_COUNT = 8;
+
+/**
+ * @brief Flags carried by keyboard events
+ * @details The values match the corresponding KEYEVENTF_* bits so expansion is a plain copy
+ */
+namespace event_flags {
+constexpr uint8_t Extended = 0x01;  ///< Extended key (KEYEVENTF_EXTENDEDKEY)
+constexpr uint8_t Unicode  = 0x04;  ///< payload is a UTF-16 code unit (KEYEVENTF_UNICODE)
+constexpr uint8_t Scancode = 0x08;  ///< Scan code only (KEYEVENTF_SCANCODE)
+} // namespace event_flags
+
+/**
+ * @struct Event
+ * @brief An 8-byte input event, expanded into the backend's native structure only at dispatch
+ *
+ * @details A Win32 INPUT is 40 bytes on x64; buffering Events instead keeps five of them in
+ * the space of one. Fields that are the same for every event of an instance (the dwExtraInfo
+ * marker, the timestamp) are not stored at all and are filled in by the backend.
+ */
+struct Event {
+    EventKind kind;    ///< What happened
+    uint8_t flags;     ///< event_flags for keyboard events, zero otherwise
+    uint16_t code;     ///< Virtual key or Button, depending on kind
+    uint32_t payload;  ///< Scan code, packed coordinates or wheel data, depending on kind
+
+    /**
+     * @brief Create a keyboard event
+     * @param up Whether the key goes up (KeyUp) or down (KeyDown)
+     * @param vk The virtual key code
+     * @param scan The scan code or UTF-16 code unit
+     * @param flags Combination of event_flags
+     * @return Event The keyboard event
+     */
+    static constexpr Event key(bool up, uint16_t vk, uint16_t scan, uint8_t flags) {
+        return Event{up ? EventKind::KeyUp : EventKind::KeyDown, flags, vk, scan};
+    }
+
+    /**
+     * @brief Create a mouse button event
+     * @param up Whether the button goes up (ButtonUp) or down (ButtonDown)
+     * @param button The button, one of Left, Middle, Right, Back or Forward
+     * @return Event The button event
+     */
+    static constexpr Event button(bool up, Button button) {
+        return Event{up ? EventKind::ButtonUp : EventKind::ButtonDown, 0, static_cast<uint16_t>(button), 0};
+    }
+
+    /**
+     * @brief Create a move event
+     * @details Absolute coordinates are clamped to 0-65535, relative ones to the 16-bit
+     * signed range; callers with larger relative moves split them first
+     * @param absolute Whether x and y are normalized absolute coordinates
+     * @param x The x-coordinate or distance
+     * @param y The y-coordinate or distance
+     * @return Event The move event
+     */
+    static constexpr Event move(bool absolute, int x, int y) {
+        int lo = absolute ? 0 : -32768;
+        int hi = absolute ? 65535 : 32767;
+        uint32_t px = static_cast<uint16_t>(x < lo ? lo : (x > hi ? hi : x));
+        uint32_t py = static_cast<uint16_t>(y < lo ? lo : (y > hi ? hi : y));
+        return Event{absolute ? EventKind::MoveAbs : EventKind::MoveRel, 0, 0, px | (py << 16)};
+    }
+
+    /**
+     * @brief Create a wheel event
+     * @param axis The wheel axis
+     * @param data The signed wheel data (multiples of WHEEL_DELTA)
+     * @return Event The wheel event
+     */
+    static constexpr Event wheel(Axis axis, int data) {
+        return Event{axis == Axis::Horizontal ? EventKind::HWheel : EventKind::Wheel, 0, 0,
+                     static_cast<uint32_t>(data)};
+    }
+
+    /**
+     * @brief Get the x-coordinate of a move event
+     * @return int Normalized x for MoveAbs, signed dx for MoveRel
+     */
+    constexpr int x() const {
+        return kind == EventKind::MoveAbs ? static_cast<int>(payload & 0xFFFF)
+                                          : static_cast<int>(static_cast<int16_t>(payload & 0xFFFF));
+    }
+
+    /**
+     * @brief Get the y-coordinate of a move event
+     * @return int Normalized y for MoveAbs, signed dy for MoveRel
+     */
+    constexpr int y() const {
+        return kind == EventKind::MoveAbs ? static_cast<int>(payload >> 16)
+                                          : static_cast<int>(static_cast<int16_t>(payload >> 16));
+    }
+
+    /**
+     * @brief Get the signed data of a wheel event
+     * @return int The wheel data
+     */
+    constexpr int wheel_data() const {
+        return static_cast<int32_t>(payload);
+    }
+
+    constexpr bool operator==(const Event& other) const {
+        return kind == other.kind && flags == other.flags && code == other.code && payload == other.payload;
+    }
+
+    constexpr bool operator!=(const Event& other) const {
+        return !(*this == other);
+    }
+};
+
+static_assert(sizeof(Event) == 8, "Event must stay 8 bytes");
+
+/**
+ * @brief Convert a screen coordinate to the normalized 0-65535 range of absolute moves
+ * @details Rounds to the nearest step, so every pixel maps back onto itself
+ * @param pixel The coordinate in pixels
+ * @param size The screen width or height in pixels
+ * @return int The normalized coordinate
+ */
+constexpr int normalize_coordinate(int pixel, int size) {
+    // Subtract 1 from the size as per Microsoft documentation
+    int range = size - 1;
+    return (pixel * 65535 + range / 2 * (pixel >= 0 ? 1 : -1)) / range;
+}
+
+/**
+ * @struct TimedEvent
+ * @brief An event together with the time it happened or should be replayed
+ */
+struct TimedEvent {
+    int64_t timestamp;  ///< Nanoseconds from the start of the recording
+    Event event;        ///< The event itself
+};
+
+static_assert(sizeof(TimedEvent) == 16, "TimedEvent must stay 16 bytes");
+
+/**
+ * @class Backend
+ * @brief Destination of buffered events
+ *
+ * @details A backend expands Events into whatever its target understands and delivers them.
+ * The Windows backend turns them into INPUT structures for SendInput; other backends can
+ * capture or simulate them. A backend that simulates its own screen also answers the
+ * screen size and cursor queries, which Bego otherwise sends to the operating system.
+ */
+class Backend {
+public:
+    /**
+     * @brief Virtual destructor for interface
+     */
+    virtual ~Backend() = default;
+
+    /**
+     * @brief Deliver a batch of events, in order
+     * @param events Pointer to the first event
+     * @param count Number of events
+     * @throws InputError If the events could not all be delivered
+     */
+    virtual void dispatch(const Event* events, size_t count) = 0;
+
+    /**
+     * @brief Get ready to dispatch from the calling thread without allocating
+     * @details Called once by a thread that is about to dispatch on its own, such as
+     * the dispatch thread of a RealtimeBackend. The default does nothing.
+     * @param max_batch The largest batch that will be dispatched
+     */
+    virtual void prepare(size_t /*max_batch*/) {}
+
+    /**
+     * @brief Get the size of the screen the events go to
+     * @return std::optional<std::pair<int, int>> Width and height in pixels, or nullopt
+     * to ask the operating system (the default)
+     */
+    virtual std::optional<std::pair<int, int>> screen_size() { return std::nullopt; }
+
+    /**
+     * @brief Get the cursor position on the screen the events go to
+     * @return std::optional<std::pair<int, int>> The position in pixels, or nullopt to
+     * ask the operating system (the default)
+     */
+    virtual std::optional<std::pair<int, int>> cursor_position() { return std::nullopt; }
+};
+
+/**
+ * @class NullBackend
+ * @brief Backend that discards everything it receives
+ *
+ * @details For dry runs, benchmarks and tools that only need a Bego to build events.
+ */
+class NullBackend : public Backend {
+public:
+    /**
+     * @brief Discard a batch of events
+     */
+    void dispatch(const Event*, size_t) override {}
+};
+
+} // namespace bego
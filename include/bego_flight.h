@@ -0,0 +1,199 @@
+#pragma once
+
+#include "bego_event.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @file bego_flight.h
+ * @author Eterninety
+ * @brief Always-on flight recorder of the most recently dispatched events
+ * @version 1.0
+ *
+ * @details Once started, every event a Bego hands to its backend is also written into
+ * a fixed-size, lock-free ring together with a timestamp, a process-wide sequence
+ * number and the API call it came from. The ring never allocates or blocks after it
+ * is created; the last capacity events can be written to a flight dump on demand, on
+ * a signal or when the process crashes, and bego-flight lists or replays a dump.
+ *
+ * @code
+ * bego::FlightRecorder::start(1 << 16);
+ * bego::FlightRecorder::install_dump_handlers("bego-flight.bfr");  // SIGUSR1 and crashes
+ * @endcode
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace bego {
+
+/**
+ * @enum EventOrigin
+ * @brief The Bego call an event was dispatched by
+ */
+enum class EventOrigin : uint8_t {
+    Key,     ///< key(), including releases of timed holds and on destruction
+    Raw,     ///< raw()
+    Button,  ///< button()
+    Scroll,  ///< scroll()
+    Move,    ///< move_mouse()
+    Text,    ///< text()
+    Send     ///< send(), used by scripts, replays and streams
+};
+
+/**
+ * @struct FlightRecord
+ * @brief One recorded event, as stored in a flight dump
+ */
+struct FlightRecord {
+    uint64_t sequence;    ///< Process-wide dispatch order, starting at 0
+    int64_t timestamp;    ///< Steady clock nanoseconds when the batch was dispatched
+    Event event;          ///< The event
+    EventOrigin origin;   ///< The call that dispatched it
+    uint8_t reserved[7];  ///< Zero
+};
+
+static_assert(sizeof(FlightRecord) == 32, "FlightRecord must stay 32 bytes");
+
+/**
+ * @struct FlightDumpHeader
+ * @brief The first 48 bytes of a flight dump, followed by record_count FlightRecords
+ * @details Records are in sequence order. Sequence numbers may have gaps where a slot
+ * was being overwritten while the dump was taken.
+ */
+struct FlightDumpHeader {
+    char magic[8];            ///< "BEGOFLT" followed by a zero byte
+    uint32_t version;         ///< Format version, currently 1
+    uint32_t record_size;     ///< sizeof(FlightRecord)
+    uint64_t record_count;    ///< Number of records that follow
+    uint64_t next_sequence;   ///< Sequence number the next event would have had
+    int64_t steady_time;      ///< Steady clock nanoseconds when the dump was taken
+    int64_t system_time;      ///< System clock nanoseconds since the Unix epoch at the same moment
+};
+
+static_assert(sizeof(FlightDumpHeader) == 48, "FlightDumpHeader must stay 48 bytes");
+
+/**
+ * @class FlightRecorder
+ * @brief Lock-free ring of the last dispatched events
+ *
+ * @details Writers claim a range of sequence numbers with one atomic add per batch
+ * and fill the matching slots; each slot carries a stamp that is odd while it is
+ * being written and encodes its sequence number once complete, so readers copy
+ * slots without locking and skip any that were rewritten meanwhile. Reading is
+ * async-signal-safe, which is what allows dumping from a signal or crash handler.
+ */
+class FlightRecorder {
+public:
+    /**
+     * @brief Create a recorder
+     * @param capacity Number of events kept, rounded up to a power of two (at least 2)
+     */
+    explicit FlightRecorder(size_t capacity);
+
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+    /**
+     * @brief Record a dispatched batch
+     * @param events Pointer to the first event
+     * @param count Number of events
+     * @param origin The call that dispatched them
+     */
+    void record(const Event* events, size_t count, EventOrigin origin);
+
+    /**
+     * @brief Copy the recorded events, oldest first
+     * @param out Receives the records; its previous contents are replaced
+     */
+    void snapshot(std::vector<FlightRecord>& out) const;
+
+    /**
+     * @brief Write a flight dump
+     * @param path The file to write
+     * @throws InputError If the file cannot be written
+     */
+    void dump(const std::string& path) const;
+
+    /**
+     * @brief Write a flight dump with async-signal-safe calls only
+     * @param path The file to write
+     * @return bool False if the file could not be written
+     */
+    bool dump_signal_safe(const char* path) const;
+
+    /**
+     * @brief Get the number of events kept
+     * @return size_t The capacity
+     */
+    size_t capacity() const { return mask + 1; }
+
+    /**
+     * @brief Get the number of events recorded so far, including overwritten ones
+     * @return uint64_t The next sequence number
+     */
+    uint64_t recorded() const { return next_sequence.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Start the process-wide recorder that every Bego writes to
+     * @details The recorder lives until the process exits. Calling this again
+     * resumes the existing recorder and ignores the capacity.
+     * @param capacity Number of events kept
+     * @return FlightRecorder& The process-wide recorder
+     */
+    static FlightRecorder& start(size_t capacity = 65536);
+
+    /**
+     * @brief Stop recording; the recorded events stay available to dumps
+     */
+    static void stop();
+
+    /**
+     * @brief Get the process-wide recorder if it is recording
+     * @return FlightRecorder* The recorder, or null
+     */
+    static FlightRecorder* active() { return current.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Dump the process-wide recorder when the process crashes or is signalled
+     * @details On POSIX systems SIGUSR1 writes a dump and the process continues, and
+     * SIGSEGV, SIGBUS, SIGILL, SIGFPE and SIGABRT write one before the default action
+     * runs. On Windows unhandled exceptions write one. Later calls replace the path.
+     * @param path The file to write; at most 4095 bytes
+     * @throws InputError If the path is too long or no recorder was started
+     */
+    static void install_dump_handlers(const std::string& path);
+
+    /**
+     * @brief Read a flight dump
+     * @param path The file to read
+     * @param header Receives the header
+     * @return std::vector<FlightRecord> The records, oldest first
+     * @throws InputError If the file cannot be read or is not a flight dump
+     */
+    static std::vector<FlightRecord> load(const std::string& path, FlightDumpHeader& header);
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> stamp{0};      ///< 0 empty, odd while written, else 2 * (sequence + 1)
+        std::atomic<int64_t> timestamp{0};
+        std::atomic<uint64_t> event{0};      ///< The Event's bytes
+        std::atomic<uint64_t> origin{0};
+    };
+
+    bool read(uint64_t sequence, FlightRecord& out) const;
+    FlightDumpHeader header(uint64_t count) const;
+
+    std::unique_ptr<Slot[]> slots;
+    uint64_t mask;
+    std::atomic<uint64_t> next_sequence{0};
+
+    static std::atomic<FlightRecorder*> current;
+};
+
+} // namespace bego
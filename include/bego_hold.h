@@ -0,0 +1,141 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/**
+ * @file bego_hold.h
+ * @author Eterninety
+ * @brief Deadline scheduler used to release held keys and buttons automatically
+ * @version 1.0
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace bego {
+
+/**
+ * @struct HoldTarget
+ * @brief Identifies something that can be held down (a key, a raw scan code or a mouse button)
+ */
+struct HoldTarget {
+    /**
+     * @enum Kind
+     * @brief What the code field refers to
+     */
+    enum class Kind : uint8_t {
+        Key,     ///< code is a Key enum value
+        Raw,     ///< code is a hardware scan code
+        Button   ///< code is a Button enum value
+    };
+
+    Kind kind;      ///< The kind of input being held
+    uint16_t code;  ///< Key, scan code or button, depending on kind
+
+    /**
+     * @brief Pack the target into a single integer, usable as a map key
+     * @return uint32_t The packed target
+     */
+    uint32_t packed() const {
+        return (static_cast<uint32_t>(kind) << 16) | code;
+    }
+
+    bool operator==(const HoldTarget& other) const {
+        return kind == other.kind && code == other.code;
+    }
+};
+
+/**
+ * @class HoldScheduler
+ * @brief Emits releases for held inputs at their deadlines from a single background thread
+ *
+ * @details Deadlines are kept in a min-heap and the worker thread sleeps on a condition
+ * variable until the earliest one is due, so no thread is tied up per hold and nothing polls.
+ * Every scheduled release carries a ticket; the owner compares it against its own bookkeeping
+ * when the callback fires, which makes stale deadlines (the input was released or re-pressed
+ * in the meantime) harmless without having to remove them from the heap.
+ */
+class HoldScheduler {
+public:
+    /**
+     * @typedef Clock
+     * @brief Monotonic clock used for all deadlines
+     */
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @typedef ReleaseCallback
+     * @brief Invoked on the scheduler thread when a deadline expires
+     */
+    using ReleaseCallback = std::function<void(const HoldTarget& target, uint64_t ticket)>;
+
+    /**
+     * @brief Construct a scheduler; the worker thread is started on the first schedule() call
+     * @param on_release Callback invoked for every expired deadline
+     */
+    explicit HoldScheduler(ReleaseCallback on_release);
+
+    /**
+     * @brief Stop the worker thread, dropping any pending deadlines
+     */
+    ~HoldScheduler();
+
+    HoldScheduler(const HoldScheduler&) = delete;
+    HoldScheduler& operator=(const HoldScheduler&) = delete;
+
+    /**
+     * @brief Schedule a release
+     * @param target The input to release
+     * @param deadline When to release it
+     * @param ticket Opaque value handed back to the callback
+     */
+    void schedule(const HoldTarget& target, Clock::time_point deadline, uint64_t ticket);
+
+    /**
+     * @brief Get the number of deadlines that have not fired yet (including stale ones)
+     * @return size_t The number of pending deadlines
+     */
+    size_t pending() const;
+
+private:
+    /**
+     * @brief Worker loop: sleep until the earliest deadline and fire everything that is due
+     */
+    void run();
+
+    struct Entry {
+        Clock::time_point deadline;
+        uint64_t order;      ///< Insertion order, keeps equal deadlines FIFO
+        HoldTarget target;
+        uint64_t ticket;
+    };
+
+    struct Later {
+        bool operator()(const Entry& a, const Entry& b) const {
+            if (a.deadline != b.deadline) {
+                return a.deadline > b.deadline;
+            }
+            return a.order > b.order;
+        }
+    };
+
+    ReleaseCallback on_release;
+    std::priority_queue<Entry, std::vector<Entry>, Later> deadlines;
+    uint64_t next_order = 0;
+    bool stopping = false;
+
+    mutable std::mutex mutex;
+    std::condition_variable wakeup;
+    std::thread worker;
+};
+
+} // namespace bego
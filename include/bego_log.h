@@ -0,0 +1,344 @@
+#pragma once
+
+#include "bego_per_thread.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @file bego_log.h
+ * @author Eterninety
+ * @brief Deferred-formatting binary logger for the library's diagnostics
+ * @version 1.0
+ *
+ * @details A log call does not format anything. The first time a call site runs it
+ * registers its format string and argument types and gets a small format ID; from then
+ * on every call writes a 64-byte record (a tick count, the format ID and up to six raw
+ * argument words) into a ring owned by the calling thread. A Collector thread, or any
+ * caller of collect(), drains the rings later and hands the records to a sink that
+ * either formats them as text or writes them to a binary file for bego-log to decode.
+ * A full ring drops the record and counts it rather than wait.
+ *
+ * Placeholders in the format are written as {}. Arguments may be integers, enums,
+ * floating point values, bools and pointers; strings are not captured, so constant
+ * text belongs in the format itself.
+ *
+ * @code
+ * BEGO_LOG(Debug, "dispatch: {} event(s) from origin {}", count, origin);
+ *
+ * bego::log::set_level(bego::log::Level::Debug);
+ * bego::log::Collector collector(std::chrono::milliseconds(100),
+ *                                bego::log::Collector::to_binary("bego.blog"));
+ * @endcode
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace bego {
+namespace log {
+
+/**
+ * @enum Level
+ * @brief Severity of a log call; Off as the threshold disables logging
+ */
+enum class Level : uint8_t {
+    Debug,    ///< Per-dispatch detail
+    Info,     ///< Notable but expected
+    Warning,  ///< Something failed and was handled
+    Error,    ///< Something failed and was passed on
+    Off       ///< Threshold only: nothing is logged
+};
+
+/**
+ * @enum ArgType
+ * @brief How a raw argument word is to be formatted
+ */
+enum class ArgType : uint8_t {
+    Signed,    ///< Signed integer or enum
+    Unsigned,  ///< Unsigned integer or enum
+    Double,    ///< Floating point, stored as a double
+    Bool,      ///< true or false
+    Pointer    ///< Address, formatted in hexadecimal
+};
+
+/**
+ * @brief Most arguments a single log call can carry
+ */
+constexpr size_t MAX_ARGS = 6;
+
+/**
+ * @brief Records each thread's ring holds before further records are dropped
+ */
+constexpr size_t RING_RECORDS = 4096;
+
+/**
+ * @struct Record
+ * @brief One log call, as collected and as stored in a binary log file
+ */
+struct Record {
+    int64_t timestamp;                    ///< Steady clock nanoseconds when the call was made
+    uint16_t format;                      ///< Format ID, see format()
+    uint8_t count;                        ///< Number of arguments used
+    uint8_t reserved;                     ///< Zero
+    uint32_t thread;                      ///< Small number identifying the calling thread, starting at 1
+    std::array<uint64_t, MAX_ARGS> args;  ///< Raw argument words; unused ones are zero
+};
+
+static_assert(sizeof(Record) == 64, "Log records must stay 64 bytes");
+
+/**
+ * @struct Format
+ * @brief A registered call site: its level, format string and argument types
+ */
+struct Format {
+    Level level = Level::Info;                ///< Level of the call site
+    uint8_t count = 0;                        ///< Number of arguments
+    std::array<ArgType, MAX_ARGS> types{};    ///< Type of each argument
+    std::string text;                         ///< Format string with {} placeholders
+    std::string file;                         ///< Source file name, without its directory
+    int line = 0;                             ///< Source line
+};
+
+/**
+ * @struct Site
+ * @brief Static state of one log call site; see BEGO_LOG
+ * @details Constant-initialized, so a function-local Site costs no initialization guard
+ */
+struct Site {
+    constexpr Site(Level level, const char* file, int line) : level(level), file(file), line(line) {}
+
+    Level level;
+    const char* file;
+    int line;
+    std::atomic<uint16_t> format{0};  ///< 0 until the site registered its format
+};
+
+/**
+ * @struct LogFile
+ * @brief Contents of a binary log file
+ */
+struct LogFile {
+    int64_t origin = 0;              ///< Steady clock nanoseconds when logging was first enabled
+    int64_t steady_time = 0;         ///< Steady clock nanoseconds when the file was created
+    int64_t system_time = 0;         ///< System clock nanoseconds since the Unix epoch at the same moment
+    std::vector<Format> formats;     ///< Indexed by format ID; unused IDs are empty
+    std::vector<Record> records;     ///< In collection order
+};
+
+namespace detail {
+
+/**
+ * @brief The lowest level logged; read inline by every log call
+ */
+inline std::atomic<uint8_t> minimum{static_cast<uint8_t>(Level::Off)};
+
+} // namespace detail
+
+/**
+ * @brief Set the lowest level that is logged
+ * @details Off by default. While off, a log call costs one relaxed atomic load.
+ * @param threshold The lowest level logged, or Level::Off
+ */
+void set_level(Level threshold);
+
+/**
+ * @brief Get the lowest level that is logged
+ * @return Level The threshold
+ */
+Level level();
+
+/**
+ * @brief Check whether calls of a level are logged
+ * @param call The level of the call
+ * @return bool True if it would be recorded
+ */
+inline bool enabled(Level call) {
+    return static_cast<uint8_t>(call) >= detail::minimum.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Get a registered format
+ * @param id The format ID of a record
+ * @return Format A copy of the format
+ * @throws InputError If no format has this ID
+ */
+Format format(uint16_t id);
+
+/**
+ * @brief Drain every thread's ring and hand the records to a sink
+ * @details Records are converted to steady clock time and sorted by it. Calls are
+ * serialized; the sink runs on the calling thread.
+ * @param sink Receives the records, if there are any
+ * @return size_t Number of records collected
+ */
+size_t collect(const std::function<void(const Record* records, size_t count)>& sink);
+
+/**
+ * @brief Get the number of records dropped because a ring was full
+ * @return uint64_t Dropped records since the process started
+ */
+uint64_t dropped();
+
+/**
+ * @brief Get the time logging was first enabled, which rendered timestamps count from
+ * @return int64_t Steady clock nanoseconds, or 0 if logging was never enabled
+ */
+int64_t origin();
+
+/**
+ * @brief Format a record as one line of text
+ * @param format The record's format
+ * @param record The record
+ * @param origin Steady clock nanoseconds the printed time counts from
+ * @return std::string The line, without a line break
+ */
+std::string render(const Format& format, const Record& record, int64_t origin);
+
+/**
+ * @brief Read a binary log file written by Collector::to_binary
+ * @param path The file to read
+ * @return LogFile Its formats and records
+ * @throws InputError If the file cannot be read, is not a log file or is corrupt
+ */
+LogFile load(const std::string& path);
+
+namespace detail {
+
+template <typename T>
+constexpr ArgType arg_type() {
+    using U = std::decay_t<T>;
+    static_assert(!std::is_same<U, char*>::value && !std::is_same<U, const char*>::value,
+                  "Strings are not captured by the logger; put constant text in the format");
+    static_assert(std::is_arithmetic<U>::value || std::is_enum<U>::value || std::is_pointer<U>::value,
+                  "Log arguments must be integers, enums, floating point values, bools or pointers");
+
+    if constexpr (std::is_same<U, bool>::value) {
+        return ArgType::Bool;
+    } else if constexpr (std::is_floating_point<U>::value) {
+        return ArgType::Double;
+    } else if constexpr (std::is_pointer<U>::value) {
+        return ArgType::Pointer;
+    } else if constexpr (std::is_enum<U>::value) {
+        return std::is_signed<std::underlying_type_t<U>>::value ? ArgType::Signed : ArgType::Unsigned;
+    } else {
+        return std::is_signed<U>::value ? ArgType::Signed : ArgType::Unsigned;
+    }
+}
+
+template <typename T>
+uint64_t arg_word(const T& value) {
+    using U = std::decay_t<T>;
+
+    if constexpr (std::is_floating_point<U>::value) {
+        double widened = static_cast<double>(value);
+        uint64_t word;
+        std::memcpy(&word, &widened, sizeof(word));
+        return word;
+    } else if constexpr (std::is_pointer<U>::value) {
+        return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value));
+    } else if constexpr (std::is_enum<U>::value) {
+        return static_cast<uint64_t>(static_cast<int64_t>(static_cast<std::underlying_type_t<U>>(value)));
+    } else if constexpr (std::is_signed<U>::value) {
+        return static_cast<uint64_t>(static_cast<int64_t>(value));
+    } else {
+        return static_cast<uint64_t>(value);
+    }
+}
+
+/**
+ * @brief Register a call site's format, once; returns 0 if the format table is full
+ */
+uint16_t define(Site& site, const char* text, const ArgType* types, size_t count);
+
+/**
+ * @brief Write a record into the calling thread's ring
+ */
+void append(uint16_t format, const std::array<uint64_t, MAX_ARGS>& args, size_t count);
+
+} // namespace detail
+
+/**
+ * @brief Record a log call; use BEGO_LOG rather than calling this directly
+ * @param site The call site
+ * @param text Format string with {} placeholders; must be the same on every call
+ * @param args Up to MAX_ARGS arguments
+ */
+template <typename... Args>
+void write(Site& site, const char* text, const Args&... args) {
+    static_assert(sizeof...(Args) <= MAX_ARGS, "At most six arguments per log call");
+
+    uint16_t id = site.format.load(std::memory_order_acquire);
+    if (id == 0) {
+        // A trailing element keeps the arrays non-empty for calls without arguments
+        constexpr ArgType types[] = {detail::arg_type<Args>()..., ArgType::Signed};
+        id = detail::define(site, text, types, sizeof...(Args));
+    }
+    const std::array<uint64_t, MAX_ARGS> words = {detail::arg_word(args)...};
+    detail::append(id, words, sizeof...(Args));
+}
+
+/**
+ * @class Collector
+ * @brief Background thread draining the rings into a sink at a fixed interval
+ */
+class Collector {
+public:
+    /**
+     * @brief Receives collected records on the collector thread
+     */
+    using Sink = std::function<void(const Record* records, size_t count)>;
+
+    /**
+     * @brief Start collecting
+     * @param interval Time between two collections
+     * @param sink Receives the records; exceptions it throws are ignored
+     */
+    Collector(std::chrono::milliseconds interval, Sink sink);
+
+    Collector(const Collector&) = delete;
+    Collector& operator=(const Collector&) = delete;
+
+    /**
+     * @brief Create a sink that formats records as text lines
+     * @param out The stream to write; it must outlive the sink
+     * @return Sink The sink
+     */
+    static Sink to_stream(std::ostream& out);
+
+    /**
+     * @brief Create a sink that writes records to a binary log file for bego-log
+     * @param path The file to create
+     * @return Sink The sink
+     * @throws InputError If the file cannot be created
+     */
+    static Sink to_binary(const std::string& path);
+
+private:
+    Sink sink;
+    bego::detail::IntervalWorker worker;  ///< Stops the thread after a last collection when destroyed
+};
+
+} // namespace log
+} // namespace bego
+
+/**
+ * @brief Log a call at a level, e.g. BEGO_LOG(Warning, "release of {} failed", key)
+ * @details The arguments are only evaluated when the level is enabled
+ */
+#define BEGO_LOG(level, ...)                                                                    \
+    do {                                                                                        \
+        if (::bego::log::enabled(::bego::log::Level::level)) {                                  \
+            static ::bego::log::Site bego_log_site(::bego::log::Level::level, __FILE__, __LINE__); \
+            ::bego::log::write(bego_log_site, __VA_ARGS__);                                     \
+        }                                                                                       \
+    } while (0)
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "bego_event.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file bego_macro.h
+ * @author Eterninety
+ * @brief Column-oriented macro buffers with vectorized editing operations
+ * @version 1.0
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace bego {
+
+/**
+ * @brief Build a kind mask for MacroBuffer::filter_kinds()
+ * @param kind The event kind to include
+ * @return uint32_t The mask bit of the kind
+ */
+constexpr uint32_t kind_bit(EventKind kind) {
+    return 1u << static_cast<uint32_t>(kind);
+}
+
+/**
+ * @class MacroBuffer
+ * @brief A recorded or generated macro stored as structure-of-arrays columns
+ *
+ * @details Each event is split over six columns: timestamp, kind, flags, code, x and y.
+ * Editing operations touch only the columns they need and run over them with SIMD
+ * kernels (SSE2 where available, scalar loops otherwise).
+ *
+ * The x and y columns hold the unpacked payload: coordinates for moves, the scan code
+ * (or UTF-16 unit) in x for keyboard events and the wheel data in x for wheel events.
+ * Coordinates are kept at full 32-bit precision while editing and only clamped to the
+ * compact event range when an Event is rebuilt with event().
+ */
+class MacroBuffer {
+public:
+    /**
+     * @brief Get the number of events in the buffer
+     * @return size_t The number of events
+     */
+    size_t size() const { return ts.size(); }
+
+    /**
+     * @brief Check whether the buffer holds no events
+     * @return bool True if the buffer is empty
+     */
+    bool empty() const { return ts.empty(); }
+
+    /**
+     * @brief Reserve room in every column
+     * @param count Number of events to reserve room for
+     */
+    void reserve(size_t count);
+
+    /**
+     * @brief Remove all events
+     */
+    void clear();
+
+    /**
+     * @brief Append an event
+     * @param timestamp Nanoseconds from the start of the macro
+     * @param event The event to append
+     */
+    void push_back(int64_t timestamp, const Event& event);
+
+    /**
+     * @brief Append a timed event
+     * @param event The event to append
+     */
+    void push_back(const TimedEvent& event) { push_back(event.timestamp, event.event); }
+
+    /**
+     * @brief Rebuild the compact event at an index
+     * @param index Position of the event
+     * @return Event The event, with coordinates clamped to the compact range
+     */
+    Event event(size_t index) const;
+
+    /**
+     * @brief Get the timestamp at an index
+     * @param index Position of the event
+     * @return int64_t Nanoseconds from the start of the macro
+     */
+    int64_t timestamp(size_t index) const { return ts[index]; }
+
+    // Column access
+    const int64_t* timestamps() const { return ts.data(); }
+    const EventKind* kinds() const { return kind_column.data(); }
+    const uint8_t* flags() const { return flag_column.data(); }
+    const uint16_t* codes() const { return code_column.data(); }
+    const int32_t* xs() const { return x_column.data(); }
+    const int32_t* ys() const { return y_column.data(); }
+
+    /**
+     * @brief Add an offset to every timestamp
+     * @param offset Nanoseconds to add (may be negative)
+     */
+    void shift_time(int64_t offset);
+
+    /**
+     * @brief Stretch or compress time around an origin
+     * @details Computes origin + (t - origin) * factor, rounded to the nearest nanosecond.
+     * Exact for distances from the origin below 2^51 ns (about 26 days).
+     * @param factor Scale factor; 2.0 makes the macro twice as slow
+     * @param origin Timestamp that stays in place
+     */
+    void scale_time(double factor, int64_t origin = 0);
+
+    /**
+     * @brief Apply an affine transform to mouse coordinates
+     * @details Absolute moves become (x * scale_x + offset_x, y * scale_y + offset_y);
+     * relative moves are only scaled. Other events are left untouched.
+     * Results are rounded to the nearest integer.
+     * @param scale_x Horizontal scale factor
+     * @param scale_y Vertical scale factor
+     * @param offset_x Horizontal offset applied to absolute moves
+     * @param offset_y Vertical offset applied to absolute moves
+     */
+    void transform_coordinates(float scale_x, float scale_y, float offset_x, float offset_y);
+
+    /**
+     * @brief Keep only events whose kind is in a mask, preserving order
+     * @param kind_mask Bitwise OR of kind_bit() values to keep
+     * @return size_t The number of events removed
+     */
+    size_t filter_kinds(uint32_t kind_mask);
+
+private:
+    /**
+     * @brief Resize every column to the same length
+     * @param count The new number of events
+     */
+    void resize(size_t count);
+
+    std::vector<int64_t> ts;
+    std::vector<EventKind> kind_column;
+    std::vector<uint8_t> flag_column;
+    std::vector<uint16_t> code_column;
+    std::vector<int32_t> x_column;
+    std::vector<int32_t> y_column;
+};
+
+} // namespace bego
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @file bego_mapped_file.h
+ * @author Eterninety
+ * @brief Read-only memory-mapped files
+ * @version 1.0
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace bego {
+
+/**
+ * @class MappedFile
+ * @brief A whole file mapped read-only into memory
+ * @details Uses mmap on POSIX systems and file mappings on Windows.
+ * The mapping is released when the object is destroyed.
+ */
+class MappedFile {
+public:
+    /**
+     * @brief Construct an empty mapping
+     */
+    MappedFile() = default;
+
+    /**
+     * @brief Map a file
+     * @param path The file to map
+     * @throws InputError If the file cannot be opened or mapped
+     */
+    explicit MappedFile(const std::string& path);
+
+    /**
+     * @brief Destructor - unmaps the file
+     */
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Get the mapped bytes
+     * @return const uint8_t* The first byte, or null for an empty mapping
+     */
+    const uint8_t* data() const { return base; }
+
+    /**
+     * @brief Get the size of the mapping
+     * @return size_t The file size in bytes
+     */
+    size_t size() const { return length; }
+
+    /**
+     * @brief Unmap the file
+     */
+    void close();
+
+private:
+    const uint8_t* base = nullptr;
+    size_t length = 0;
+};
+
+} // namespace bego
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "bego_event.h"
+#include "bego_per_thread.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+/**
+ * @file bego_metrics.h
+ * @author Eterninety
+ * @brief Process-wide dispatch metrics with Prometheus text export
+ * @version 1.0
+ *
+ * @details Once enabled, every batch Bego hands to its backend is counted: events by
+ * kind, batches, a batch-size histogram, a dispatch latency histogram and failed
+ * dispatches, plus short SendInput calls from the Windows backend. Each thread writes
+ * only its own cache-line aligned counter block, with plain loads and stores, so
+ * recording never waits and never contends; snapshot() adds the blocks up, including
+ * those of threads that have exited.
+ *
+ * @code
+ * bego::metrics::enable(true);
+ * bego::metrics::Exporter exporter(std::chrono::seconds(15),
+ *                                  bego::metrics::Exporter::to_file("/var/lib/node_exporter/bego.prom"));
+ * @endcode
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace bego {
+namespace metrics {
+
+/**
+ * @brief Upper bounds of the batch-size histogram buckets: 1, 2, 4, ... 4096, then +Inf
+ */
+constexpr size_t BATCH_BUCKETS = 14;
+
+/**
+ * @brief Upper bounds of the dispatch latency histogram buckets in nanoseconds, then +Inf
+ */
+constexpr std::array<int64_t, 13> LATENCY_BOUNDS = {
+    1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000, 500000, 1000000, 2500000, 5000000, 10000000
+};
+
+/**
+ * @brief Number of dispatch latency histogram buckets, including +Inf
+ */
+constexpr size_t LATENCY_BUCKETS = LATENCY_BOUNDS.size() + 1;
+
+/**
+ * @struct Snapshot
+ * @brief Totals of every counter at one point in time
+ * @details Histogram buckets hold the count of their own range, not the cumulative count
+ */
+struct Snapshot {
+    std::array<uint64_t, EVENT_KIND_COUNT> events{};   ///< Delivered events by EventKind
+    uint64_t batches = 0;                              ///< Batches handed to a backend
+    uint64_t failures = 0;                             ///< Batches whose dispatch threw
+    uint64_t short_sends = 0;                          ///< SendInput calls that inserted fewer events than given
+    std::array<uint64_t, BATCH_BUCKETS> batch_sizes{}; ///< Batches by size bucket
+    uint64_t batch_events = 0;                         ///< Sum of all batch sizes, failed ones included
+    std::array<uint64_t, LATENCY_BUCKETS> latency{};   ///< Batches by dispatch latency bucket
+    uint64_t latency_ns = 0;                           ///< Sum of all dispatch latencies
+};
+
+/**
+ * @brief Turn recording on or off for the whole process
+ * @details Off by default; while off, a dispatch costs one relaxed atomic load more
+ * @param on Whether to record
+ */
+void enable(bool on);
+
+/**
+ * @brief Check whether recording is on
+ * @return bool True if dispatches are being recorded
+ */
+bool enabled();
+
+/**
+ * @brief Record one batch handed to a backend
+ * @param events Pointer to the first event
+ * @param count Number of events
+ * @param latency_ns How long the backend took
+ * @param delivered False if the backend threw; its events are then not counted by kind
+ */
+void record_dispatch(const Event* events, size_t count, int64_t latency_ns, bool delivered);
+
+/**
+ * @brief Record a SendInput call that inserted fewer events than it was given
+ */
+void record_short_send();
+
+/**
+ * @brief Add up the counters of every thread
+ * @return Snapshot The totals since the process started
+ */
+Snapshot snapshot();
+
+/**
+ * @brief Format totals in the Prometheus text exposition format
+ * @param totals The totals to format
+ * @return std::string The metrics, one family after another
+ */
+std::string to_prometheus(const Snapshot& totals);
+
+/**
+ * @brief Write the current totals to a file in the Prometheus text format
+ * @details The file is written under a temporary name and renamed into place, so a
+ * scraper (such as the node exporter's textfile collector) never reads half a file
+ * @param path The file to write
+ * @throws InputError If the file cannot be written
+ */
+void write_prometheus(const std::string& path);
+
+/**
+ * @class Exporter
+ * @brief Background thread handing the Prometheus text to a sink at a fixed interval
+ */
+class Exporter {
+public:
+    /**
+     * @brief Receives the formatted metrics on the exporter thread
+     */
+    using Sink = std::function<void(const std::string& text)>;
+
+    /**
+     * @brief Start exporting
+     * @param interval Time between two exports; the first one happens after one interval
+     * @param sink Receives the text; exceptions it throws are ignored
+     */
+    Exporter(std::chrono::milliseconds interval, Sink sink);
+
+    Exporter(const Exporter&) = delete;
+    Exporter& operator=(const Exporter&) = delete;
+
+    /**
+     * @brief Create a sink that replaces a file with every export
+     * @param path The file to write
+     * @return Sink The sink
+     */
+    static Sink to_file(std::string path);
+
+private:
+    Sink sink;
+    detail::IntervalWorker worker;  ///< Stops the thread after a last export when destroyed
+};
+
+} // namespace metrics
+} // namespace bego
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file bego_per_thread.h
+ * @author Eterninety
+ * @brief Per-thread state registry and interval worker shared by metrics and logging
+ * @version 1.0
+ *
+ * @details Internal to the library. ThreadRegistry hands every thread its own block
+ * of state on first use and keeps a list of all of them for a reader to walk;
+ * IntervalWorker runs a task on a background thread at a fixed interval.
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace bego {
+namespace detail {
+
+/**
+ * @brief Add to a counter only its owning thread writes
+ * @details A relaxed load and store instead of a read-modify-write is enough for a
+ * single writer and keeps the hot path free of locked instructions. Readers see each
+ * value atomically.
+ * @param counter The counter
+ * @param amount What to add
+ */
+inline void bump(std::atomic<uint64_t>& counter, uint64_t amount = 1) {
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+/**
+ * @class ThreadRegistry
+ * @brief One T per thread, created on first use, plus the list of every live one
+ *
+ * @details At thread exit `bool T::retire(Retired&)` is called with the mutex held. It
+ * folds what must outlive the thread into retired and returns true to have the state
+ * freed at once; a state it keeps stays in live until its owner erases and deletes it,
+ * again with the mutex held.
+ *
+ * @tparam T Per-thread state; default constructible
+ * @tparam Retired What is kept of the states of exited threads
+ */
+template <typename T, typename Retired>
+class ThreadRegistry {
+public:
+    std::mutex mutex;        ///< Guards live and retired
+    std::vector<T*> live;    ///< Every state not freed yet
+    Retired retired{};       ///< Filled by T::retire
+
+    /**
+     * @brief Get the registry
+     * @return ThreadRegistry& The process-wide instance
+     */
+    static ThreadRegistry& get() {
+        // Never destroyed, so threads exiting after main() can still retire their state
+        static ThreadRegistry* instance = new ThreadRegistry();
+        return *instance;
+    }
+
+    /**
+     * @brief Get the calling thread's state, creating it on first use
+     * @return T& The state
+     */
+    static T& local() {
+        if (current) {
+            return *current;
+        }
+        thread_local Slot slot;
+        current = &slot.acquire();
+        return *current;
+    }
+
+private:
+    /**
+     * @brief Registers the thread's state and retires it at thread exit
+     */
+    struct Slot {
+        T* state = nullptr;
+
+        T& acquire() {
+            if (!state) {
+                state = new T();
+                ThreadRegistry& registry = get();
+                std::lock_guard<std::mutex> lock(registry.mutex);
+                registry.live.push_back(state);
+            }
+            return *state;
+        }
+
+        ~Slot() {
+            if (!state) {
+                return;
+            }
+            ThreadRegistry& registry = get();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            if (state->retire(registry.retired)) {
+                registry.live.erase(std::find(registry.live.begin(), registry.live.end(), state));
+                delete state;
+            }
+            current = nullptr;
+        }
+    };
+
+    // Plain pointer for the hot path: unlike the slot it needs no initialization guard
+    static inline thread_local T* current = nullptr;
+};
+
+/**
+ * @class IntervalWorker
+ * @brief Background thread running a task at a fixed interval, and once more when stopped
+ */
+class IntervalWorker {
+public:
+    /**
+     * @brief Start the thread
+     * @param interval Time between two runs; the first one happens after one interval
+     * @param task The task; exceptions it throws are ignored
+     */
+    IntervalWorker(std::chrono::milliseconds interval, std::function<void()> task);
+
+    /**
+     * @brief Stop the thread after a last run
+     */
+    ~IntervalWorker();
+
+    IntervalWorker(const IntervalWorker&) = delete;
+    IntervalWorker& operator=(const IntervalWorker&) = delete;
+
+private:
+    void run();
+
+    std::chrono::milliseconds interval;
+    std::function<void()> task;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+    std::thread worker;
+};
+
+} // namespace detail
+} // namespace bego
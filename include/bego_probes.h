@@ -0,0 +1,53 @@
+#pragma once
+
+/**
+ * @file bego_probes.h
+ * @author Eterninety
+ * @brief Static tracepoints (USDT probes) on the library's hot paths
+ * @version 1.0
+ *
+ * @details With the BEGO_USDT_PROBES CMake option the library is built with SystemTap
+ * style static probes in provider "bego". Each probe is a single nop until a tracer
+ * attaches to it, and perf, bpftrace or SystemTap can attach to the installed library
+ * without rebuilding it:
+ *
+ * @code
+ * bpftrace -e 'usdt:./libbego.so:bego:send_input_return { @sent = hist(arg1); }'
+ * perf buildid-cache --add ./libbego.so && perf list sdt_bego:*
+ * @endcode
+ *
+ * | Probe              | Arguments                                       |
+ * |--------------------|-------------------------------------------------|
+ * | send_input_entry   | input count                                     |
+ * | send_input_return  | input count, inputs sent, error code (0 if none)|
+ * | translate_key      | input code, map type, result                    |
+ * | queue_key          | Key, virtual key, scan code, Direction          |
+ * | queue_char         | character, first UTF-16 unit, second (0 if none)|
+ * | move_mouse         | x, y, Coordinate                                |
+ * | held               | HoldTarget::Kind, code, 1 when pressed else 0   |
+ *
+ * Without the option, or where <sys/sdt.h> is not available, the macros expand to
+ * nothing and their arguments are not evaluated.
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+#if defined(BEGO_USDT_PROBES) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define BEGO_PROBES_ENABLED 1
+#endif
+#endif
+
+#ifdef BEGO_PROBES_ENABLED
+#define BEGO_PROBE1(name, a) DTRACE_PROBE1(bego, name, a)
+#define BEGO_PROBE3(name, a, b, c) DTRACE_PROBE3(bego, name, a, b, c)
+#define BEGO_PROBE4(name, a, b, c, d) DTRACE_PROBE4(bego, name, a, b, c, d)
+#else
+#define BEGO_PROBE1(name, a) ((void)0)
+#define BEGO_PROBE3(name, a, b, c) ((void)0)
+#define BEGO_PROBE4(name, a, b, c, d) ((void)0)
+#endif
@@ -0,0 +1,199 @@
+#pragma once
+
+#include "bego_event.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @file bego_realtime.h
+ * @author Eterninety
+ * @brief Real-time dispatch: a pinned, high-priority thread delivering events for its callers
+ * @version 1.0
+ *
+ * @details RealtimeBackend wraps another backend and hands every batch to a dedicated
+ * dispatch thread through a queue that is allocated, written and locked in memory up
+ * front. The thread is pinned to a CPU, given real-time priority and prepares the
+ * wrapped backend, so that delivering a batch neither allocates, page faults nor waits
+ * behind ordinary threads. Each of these steps needs privileges the process may not
+ * have; a step that fails is skipped and the backend reports which guarantees it got.
+ *
+ * @code
+ * bego::RealtimeOptions options;
+ * options.cpu = 3;
+ * auto realtime = std::make_shared<bego::RealtimeBackend>(std::make_shared<bego::Win32Backend>(), options);
+ * std::cout << realtime->guarantees().describe() << std::endl;
+ * bego::Bego bego(bego::Settings(), realtime);
+ * @endcode
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace bego {
+
+/**
+ * @enum MemoryLock
+ * @brief How much memory a RealtimeBackend locks, or managed to lock
+ */
+enum class MemoryLock : uint8_t {
+    None,    ///< Nothing is locked; pages may be swapped out
+    Queue,   ///< The queue is locked, the rest of the process is not
+    Process  ///< All current and future pages of the process are locked
+};
+
+/**
+ * @struct RealtimeOptions
+ * @brief What the dispatch thread of a RealtimeBackend asks for
+ */
+struct RealtimeOptions {
+    int cpu = -1;               ///< CPU to pin the dispatch thread to, or -1 to leave it unpinned
+    int priority = 80;          ///< SCHED_FIFO priority (1-99), or 0 to keep the normal scheduler; on Windows any value above 0 means time critical
+    MemoryLock lock_memory = MemoryLock::Queue;  ///< What to lock; Process (mlockall, Linux only) also limits every later allocation of the process to RLIMIT_MEMLOCK
+    size_t queue_slots = 64;    ///< Batches the queue holds before callers wait
+    size_t max_batch = 256;     ///< Events per slot; longer batches take several slots
+    bool wait = true;           ///< dispatch() waits until its events were delivered and rethrows the backend's error
+    unsigned spin_us = 0;       ///< Time the dispatch thread polls an empty queue before it sleeps; only worth it on a CPU of its own
+};
+
+/**
+ * @struct RealtimeGuarantees
+ * @brief What the dispatch thread of a RealtimeBackend actually got
+ */
+struct RealtimeGuarantees {
+    bool pinned = false;                     ///< The thread runs on the requested CPU only
+    bool realtime_priority = false;          ///< The thread runs with SCHED_FIFO or time critical priority
+    MemoryLock memory = MemoryLock::None;    ///< What is locked in memory
+    bool prefaulted = false;                 ///< The queue, the thread's stack and the backend's buffers were written up front
+    std::vector<std::string> notes;          ///< Why requested guarantees were not obtained
+
+    /**
+     * @brief Summarize the guarantees in one line per item
+     * @return std::string The summary
+     */
+    std::string describe() const;
+};
+
+/**
+ * @class RealtimeBackend
+ * @brief Backend that delivers events from a dedicated real-time thread
+ *
+ * @details dispatch() copies the batch into free queue slots and wakes the dispatch
+ * thread, which passes each slot to the wrapped backend. With RealtimeOptions::wait
+ * the caller then waits for delivery and gets the wrapped backend's exception, so the
+ * backend behaves like the one it wraps. Without it dispatch() returns once the events
+ * are queued, and failures are only counted. Several threads may dispatch at once;
+ * their batches are delivered whole and in the order they were queued.
+ */
+class RealtimeBackend : public Backend {
+public:
+    /**
+     * @brief Start the dispatch thread
+     * @details Returns once the thread has applied the options, so guarantees() is final
+     * @param backend The backend the events are delivered to
+     * @param options What to ask for
+     * @throws InputError If the options are invalid or the thread cannot be started
+     */
+    explicit RealtimeBackend(std::shared_ptr<Backend> backend, RealtimeOptions options = RealtimeOptions());
+
+    /**
+     * @brief Deliver what is queued, stop the dispatch thread and unlock what it locked
+     * @details With MemoryLock::Process this unlocks the whole process, including memory
+     * another RealtimeBackend locked
+     */
+    ~RealtimeBackend() override;
+
+    RealtimeBackend(const RealtimeBackend&) = delete;
+    RealtimeBackend& operator=(const RealtimeBackend&) = delete;
+
+    /**
+     * @brief Queue a batch for the dispatch thread
+     * @param events Pointer to the first event
+     * @param count Number of events
+     * @throws InputError With RealtimeOptions::wait, if the wrapped backend failed
+     */
+    void dispatch(const Event* events, size_t count) override;
+
+    /**
+     * @brief Ask the wrapped backend
+     * @return std::optional<std::pair<int, int>> Its screen size
+     */
+    std::optional<std::pair<int, int>> screen_size() override { return backend->screen_size(); }
+
+    /**
+     * @brief Ask the wrapped backend
+     * @return std::optional<std::pair<int, int>> Its cursor position
+     */
+    std::optional<std::pair<int, int>> cursor_position() override { return backend->cursor_position(); }
+
+    /**
+     * @brief Wait until everything queued so far has been delivered
+     */
+    void flush();
+
+    /**
+     * @brief Get what the dispatch thread obtained
+     * @return const RealtimeGuarantees& The guarantees
+     */
+    const RealtimeGuarantees& guarantees() const { return obtained; }
+
+    /**
+     * @brief Get the number of slots whose delivery failed
+     * @return uint64_t Failed deliveries since construction
+     */
+    uint64_t failures() const { return failed.load(std::memory_order_relaxed); }
+
+private:
+    /**
+     * @brief Filled by a waiting caller, on its own stack
+     */
+    struct Completion {
+        std::atomic<size_t> pending{0};  ///< Slots of the call not delivered yet
+        std::exception_ptr error;        ///< First failure, written before pending reaches 0
+    };
+
+    /**
+     * @brief One queued batch, or part of one
+     */
+    struct Slot {
+        std::atomic<uint64_t> ready{0};  ///< Sequence number + 1 once the slot is filled
+        size_t count = 0;
+        Completion* completion = nullptr;
+        Event* events = nullptr;         ///< max_batch events in the shared event array
+    };
+
+    void run();
+    void setup();
+    void deliver(Slot& slot);
+
+    std::shared_ptr<Backend> backend;
+    RealtimeOptions options;
+    RealtimeGuarantees obtained;
+
+    std::unique_ptr<Slot[]> slots;
+    std::unique_ptr<Event[]> storage;
+
+    std::mutex producer_mutex;                ///< Serializes claiming slots, in queue order
+    uint64_t next_sequence = 0;               ///< Next slot to claim; guarded by producer_mutex
+    std::atomic<uint64_t> delivered{0};       ///< Slots delivered and free again
+
+    std::mutex sleep_mutex;
+    std::condition_variable wake;
+    std::atomic<bool> sleeping{false};
+    std::atomic<bool> stopping{false};
+    std::atomic<uint64_t> failed{0};
+
+    bool started = false;                     ///< setup() finished; guarded by sleep_mutex
+    std::condition_variable ready;
+    std::thread worker;
+};
+
+} // namespace bego
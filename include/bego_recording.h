@@ -0,0 +1,355 @@
+#pragma once
+
+#include "bego_event.h"
+#include "bego_mapped_file.h"
+#include "bego_replay.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @file bego_recording.h
+ * @author Eterninety
+ * @brief Binary recording files: a fixed header followed by 16-byte TimedEvent records
+ * @version 1.0
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace bego {
+
+/**
+ * @struct RecordingHeader
+ * @brief The first 64 bytes of a recording file
+ *
+ * @details The header is followed by record_count TimedEvent records in timestamp
+ * order, stored exactly as they are in memory (little-endian). Timestamps count
+ * nanoseconds from the start of the recording.
+ *
+ * A finished file may end with a seek index: index_count RecordingIndexEntry values
+ * at index_offset, followed by the snapshot_count events their snapshots refer to.
+ * Files without an index (index_offset 0) are still valid; seeking in them scans
+ * from the start.
+ */
+struct RecordingHeader {
+    char magic[8];            ///< "BEGOREC" and a NUL
+    uint32_t version;         ///< RecordingHeader::current_version
+    uint32_t record_size;     ///< sizeof(TimedEvent)
+    uint64_t record_count;    ///< Number of records; 0 while the file is still being written
+    int64_t start_time;       ///< Steady clock reading (ns) when recording began, informational
+    uint64_t dropped;         ///< Input the source reported as lost while recording
+    uint64_t index_offset;    ///< File offset of the seek index, or 0 if there is none
+    uint64_t index_count;     ///< Number of index entries
+    uint64_t snapshot_count;  ///< Number of snapshot events after the index entries
+
+    /// Format version written by this library
+    static constexpr uint32_t current_version = 1;
+};
+
+static_assert(sizeof(RecordingHeader) == 64, "RecordingHeader must stay 64 bytes");
+static_assert(sizeof(TimedEvent) == 16, "Recording records must stay 16 bytes");
+
+/**
+ * @struct RecordingIndexEntry
+ * @brief One point of a recording's seek index
+ *
+ * @details The snapshot is the held state just before the record: the events that
+ * recreate it from a state where nothing is held, as produced by HeldState::restore().
+ */
+struct RecordingIndexEntry {
+    int64_t timestamp;         ///< Timestamp of the record
+    uint64_t record;           ///< Index of the record
+    uint32_t snapshot_offset;  ///< First snapshot event, counted from the start of the snapshot events
+    uint32_t snapshot_count;   ///< Number of snapshot events
+};
+
+static_assert(sizeof(RecordingIndexEntry) == 24, "RecordingIndexEntry must stay 24 bytes");
+
+/**
+ * @class HeldState
+ * @brief The keys, buttons and cursor position an event sequence leaves behind
+ *
+ * @details Keys are kept as the press events that are still down, so they can be
+ * pressed again exactly as recorded. The cursor is the last absolute position, if
+ * any, plus the relative motion since then.
+ */
+class HeldState {
+public:
+    /**
+     * @brief Update the state with an event
+     * @param event The event
+     */
+    void apply(const Event& event);
+
+    /**
+     * @brief Append the events that change one held state into this one
+     * @details Releases come first, then the cursor, then presses. The cursor is
+     * moved relative to from when both share the same absolute position, and is
+     * placed from scratch otherwise.
+     * @param out Receives the events
+     * @param from The state to start from, or null for nothing held at the origin
+     */
+    void restore(std::vector<Event>& out, const HeldState* from = nullptr) const;
+
+    /**
+     * @brief Get the held key presses
+     * @return const std::vector<Event>& The press events, oldest first
+     */
+    const std::vector<Event>& keys() const { return held_keys; }
+
+    /**
+     * @brief Get the held mouse buttons
+     * @return uint8_t Bit n set for Button value n
+     */
+    uint8_t buttons() const { return held_buttons; }
+
+private:
+    /**
+     * @brief Find the held press matching a key event
+     */
+    std::vector<Event>::const_iterator find(const Event& event) const;
+
+    std::vector<Event> held_keys;
+    uint8_t held_buttons = 0;
+    bool absolute = false;  ///< Whether an absolute move has been seen
+    int absolute_x = 0;
+    int absolute_y = 0;
+    int64_t relative_x = 0;  ///< Relative motion since the absolute position (or the start)
+    int64_t relative_y = 0;
+};
+
+/**
+ * @class RecordingWriter
+ * @brief Appends records to a recording file through double-buffered memory mappings
+ *
+ * @details The file is written one segment at a time. While the capture thread fills
+ * the mapped segment, a helper thread has the next segment mapped and ready and unmaps
+ * the previous one, so append() is a plain memory copy and never waits for the disk.
+ * If the helper ever falls behind, the capture thread maps the segment itself and
+ * the stall is counted.
+ *
+ * append() must be called from one thread at a time.
+ */
+class RecordingWriter {
+public:
+    /// Default segment size: 4 MiB, about 260000 records
+    static constexpr size_t default_segment_size = 4u << 20;
+
+    /// Default distance between seek index entries, in records
+    static constexpr uint64_t default_index_interval = 16384;
+
+    /**
+     * @brief Create (or truncate) a recording file
+     * @param path The file to write
+     * @param segment_size Bytes mapped at a time; rounded up to a multiple of 64 KiB
+     * @param index_interval Records between seek index entries (0 writes no index)
+     * @throws InputError If the file cannot be created or mapped
+     */
+    explicit RecordingWriter(const std::string& path, size_t segment_size = default_segment_size,
+                             uint64_t index_interval = default_index_interval);
+
+    /**
+     * @brief Destructor - finishes the file
+     */
+    ~RecordingWriter();
+
+    RecordingWriter(const RecordingWriter&) = delete;
+    RecordingWriter& operator=(const RecordingWriter&) = delete;
+
+    /**
+     * @brief Append a record
+     * @param record The record; timestamps must not decrease
+     * @throws InputError If the file cannot be extended
+     */
+    void append(const TimedEvent& record) {
+        if (offset == segment_size) {
+            rotate();
+        }
+        if (until_index == 1) {
+            add_index_entry(record.timestamp);
+        } else if (until_index != 0) {
+            until_index--;
+        }
+        *reinterpret_cast<TimedEvent*>(current + offset) = record;
+        offset += sizeof(TimedEvent);
+        count++;
+        if (index_interval != 0) {
+            state.apply(record.event);
+        }
+    }
+
+    /**
+     * @brief Record that the source lost input
+     * @param amount Number of gaps (or events) lost
+     */
+    void note_dropped(uint64_t amount) { dropped += amount; }
+
+    /**
+     * @brief Set the start time stored in the header
+     * @param time Steady clock reading in nanoseconds
+     */
+    void set_start_time(int64_t time) { start_time = time; }
+
+    /**
+     * @brief Get the number of records appended
+     * @return uint64_t The record count
+     */
+    uint64_t size() const { return count; }
+
+    /**
+     * @brief Get the number of times append() had to map a segment itself
+     * @return uint64_t The stall count
+     */
+    uint64_t stalls() const { return stall_count; }
+
+    /**
+     * @brief Unmap everything, cut the file to its exact size and write the header
+     * @throws InputError If the file cannot be finished
+     */
+    void close();
+
+private:
+    /**
+     * @brief Switch to the next segment
+     */
+    void rotate();
+
+    /**
+     * @brief Helper thread body: map the spare segment and unmap retired ones
+     */
+    void run();
+
+    /**
+     * @brief Add a seek index entry for the record about to be appended
+     */
+    void add_index_entry(int64_t timestamp);
+
+    intptr_t file = -1;             ///< File descriptor, or HANDLE on Windows
+    std::string path;
+    size_t segment_size;
+
+    uint8_t* current = nullptr;     ///< Mapped segment being filled
+    size_t offset = 0;              ///< Bytes used in the current segment
+    uint64_t segment_index = 0;     ///< Index of the current segment
+    uint64_t count = 0;
+    uint64_t dropped = 0;
+    uint64_t stall_count = 0;
+    int64_t start_time = 0;
+
+    uint64_t index_interval;
+    uint64_t until_index;                 ///< Appends until the next index entry; 1 means this one
+    HeldState state;                      ///< Held state after the last record
+    std::vector<RecordingIndexEntry> index;
+    std::vector<Event> snapshot_events;
+
+    std::mutex mutex;
+    std::condition_variable wake;   ///< Wakes the helper
+    std::condition_variable ready;  ///< Signals a mapped spare to a stalled append
+    uint8_t* spare = nullptr;       ///< Segment segment_index + 1, once mapped
+    bool spare_wanted = false;
+    std::vector<uint8_t*> retired;  ///< Segments waiting to be unmapped
+    std::string helper_error;       ///< Set if the helper could not map the spare
+    bool stopping = false;
+    std::thread helper;
+};
+
+/**
+ * @class RecordingTrack
+ * @brief Reads a recording file in place through a memory mapping
+ */
+class RecordingTrack : public TrackSource {
+public:
+    /**
+     * @brief Open a recording
+     * @details A file whose header count is 0 was not finished; its records are
+     * recovered up to the last non-empty one
+     * @param path The file to read
+     * @throws InputError If the file is not a recording or holds an unknown event kind
+     */
+    explicit RecordingTrack(const std::string& path);
+
+    bool next(TimedEvent& out) override;
+
+    /**
+     * @brief Get the header
+     * @return const RecordingHeader& The header as stored in the file
+     */
+    const RecordingHeader& header() const { return head; }
+
+    /**
+     * @brief Get the records
+     * @return const TimedEvent* The first record
+     */
+    const TimedEvent* records() const { return data; }
+
+    /**
+     * @brief Get the number of records
+     * @return size_t The record count
+     */
+    size_t size() const { return count; }
+
+    /**
+     * @brief Restart reading from a record
+     * @param index The next record to read
+     */
+    void seek(size_t index) { position = index < count ? index : count; }
+
+    /**
+     * @brief Whether the file has a seek index
+     * @return bool True if the index was found and is consistent
+     */
+    bool indexed() const { return index_count != 0; }
+
+    /**
+     * @brief Find the first record at or after a time
+     * @details O(log n): a binary search of the index, then of the records it points to
+     * @param time Timestamp in nanoseconds
+     * @return size_t The record index, or size() if every record is earlier
+     */
+    size_t find_time(int64_t time) const;
+
+    /**
+     * @brief Get the held state just before a record
+     * @details Starts from the nearest snapshot at or before the record and applies
+     * the records in between, at most one index interval of them
+     * @param record The record index
+     * @return HeldState The state
+     */
+    HeldState state_at(size_t record) const;
+
+    /**
+     * @brief Continue reading at a time, with the events that recreate the held state there
+     * @details After this call next() returns the first record at or after the time.
+     * Sending restore first puts keys, buttons and cursor where the recording had them.
+     * @param time Timestamp in nanoseconds
+     * @param restore Receives the events reaching the held state at that point
+     * @param from The state the receiver is in, or null for nothing held
+     * @return size_t The record reading continues at
+     */
+    size_t seek_time(int64_t time, std::vector<Event>& restore, const HeldState* from = nullptr);
+
+private:
+    /**
+     * @brief Find the last index entry at or before a record
+     */
+    const RecordingIndexEntry* entry_for(size_t record) const;
+
+    MappedFile file;
+    RecordingHeader head;
+    const TimedEvent* data = nullptr;
+    size_t count = 0;
+    size_t position = 0;
+
+    const RecordingIndexEntry* index = nullptr;
+    size_t index_count = 0;
+    const Event* snapshots = nullptr;
+};
+
+} // namespace bego
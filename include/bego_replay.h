@@ -0,0 +1,144 @@
+#pragma once
+
+#include "bego_event.h"
+#include "bego_macro.h"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file bego_replay.h
+ * @author Eterninety
+ * @brief Replay of several timestamped event tracks merged on the fly
+ * @version 1.0
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace bego {
+
+class Bego;
+
+/**
+ * @class TrackSource
+ * @brief A sequence of timed events, read front to back
+ * @details Timestamps must not decrease within a source
+ */
+class TrackSource {
+public:
+    /**
+     * @brief Virtual destructor for interface
+     */
+    virtual ~TrackSource() = default;
+
+    /**
+     * @brief Read the next event
+     * @param out Receives the event
+     * @return bool False once the source is exhausted
+     */
+    virtual bool next(TimedEvent& out) = 0;
+};
+
+/**
+ * @class MacroTrack
+ * @brief Track reading a MacroBuffer in place
+ */
+class MacroTrack : public TrackSource {
+public:
+    /**
+     * @brief Construct a track over a macro; the macro must outlive the track
+     * @param macro The macro to read
+     */
+    explicit MacroTrack(const MacroBuffer& macro) : macro(macro) {}
+
+    bool next(TimedEvent& out) override;
+
+private:
+    const MacroBuffer& macro;
+    size_t position = 0;
+};
+
+/**
+ * @class SpanTrack
+ * @brief Track reading an array of timed events in place
+ */
+class SpanTrack : public TrackSource {
+public:
+    /**
+     * @brief Construct a track over an array; the array must outlive the track
+     * @param events Pointer to the first event
+     * @param count Number of events
+     */
+    SpanTrack(const TimedEvent* events, size_t count) : events(events), count(count) {}
+
+    bool next(TimedEvent& out) override;
+
+private:
+    const TimedEvent* events;
+    size_t count;
+    size_t position = 0;
+};
+
+/**
+ * @class Replay
+ * @brief Streaming k-way merge of event tracks by timestamp
+ *
+ * @details Only the head event of every track is kept, in a binary heap of N entries,
+ * so merging never materializes a combined copy. Events with the same scheduled time
+ * come out in the order the tracks were added; within a track the order is preserved.
+ * Each track has its own speed factor: a factor of 2 plays it twice as fast.
+ */
+class Replay {
+public:
+    /**
+     * @brief Add a track; the source must outlive the replay
+     * @param source The track to merge
+     * @param speed Playback speed factor for this track (must be positive)
+     * @throws InputError If the speed is not positive
+     */
+    void add_track(TrackSource& source, double speed = 1.0);
+
+    /**
+     * @brief Get the next event in merged order
+     * @param out Receives the event, with its timestamp scaled by the track speed
+     * @return bool False once every track is exhausted
+     */
+    bool next(TimedEvent& out);
+
+    /**
+     * @brief Replay the merged tracks into a Bego instance in real time
+     * @details Events that are due at the same time are sent as one batch
+     * @param bego The instance receiving the events
+     * @param cancel Optional flag; setting it stops the replay after the current batch, or while it waits for the next one
+     * @param from Merged (speed-scaled) time that plays at once, for tracks that were
+     * seeked into; earlier events are sent without waiting
+     * @return size_t The number of events sent
+     */
+    size_t play(Bego& bego, const std::atomic<bool>* cancel = nullptr, int64_t from = 0);
+
+private:
+    struct Track {
+        TrackSource* source;
+        double speed;
+    };
+
+    struct Head {
+        int64_t time;    ///< Scaled timestamp
+        uint32_t track;  ///< Index of the track, used for stable tie-breaking
+        Event event;
+    };
+
+    /**
+     * @brief Pull the next event of a track and push it onto the heap
+     * @param track Index of the track
+     */
+    void refill(uint32_t track);
+
+    std::vector<Track> tracks;
+    std::vector<Head> heap;
+};
+
+} // namespace bego
@@ -0,0 +1,245 @@
+#pragma once
+
+#include "bego.h"
+#include "bego_event.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @file bego_script.h
+ * @author Eterninety
+ * @brief Automation scripts compiled to a compact bytecode and run by a small VM
+ * @version 1.0
+ *
+ * @details Scripts are line based; '#' starts a comment. Commands:
+ *
+ *     key <name> [click|press|release]     raw <scan code> [direction]
+ *     button <name> [direction]            text <rest of line, \n \t \\ escapes>
+ *     scroll <amount> [vertical|horizontal]
+ *     move <x> <y> [abs|rel]
+ *     sleep <duration>                     wait_until <duration since start>
+ *     set|add|sub|mul|div|mod <variable> <operand>
+ *     loop <count> ... end
+ *     if <operand> ==|!=|<|<=|>|>= <operand> ... [else ...] end
+ *
+ * Durations take a us, ms or s suffix (plain numbers are milliseconds). Operands are
+ * integers or variable names; a variable used as a duration counts milliseconds.
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace bego {
+
+class Bego;
+
+/**
+ * @enum Opcode
+ * @brief Bytecode operations
+ */
+enum class Opcode : uint8_t {
+    Emit,        ///< Append a events from the event pool, starting at b, to the batch
+    Move,        ///< Queue a mouse move to x = operand; y is the operand of the following Arg
+    Scroll,      ///< Queue a wheel event of operand notches
+    Arg,         ///< Extra operand of the preceding instruction, never executed on its own
+    Sleep,       ///< Flush the batch and sleep for b microseconds (register: milliseconds)
+    WaitUntil,   ///< Flush the batch and sleep until b microseconds after the start of the run
+    Set,         ///< register[a] = operand
+    Add,         ///< register[a] += operand
+    Sub,         ///< register[a] -= operand
+    Mul,         ///< register[a] *= operand
+    Div,         ///< register[a] /= operand
+    Mod,         ///< register[a] %= operand
+    Loop,        ///< Decrement register[b] and jump to a while it stays positive
+    JumpUnless,  ///< Compare operand with the following Arg and jump to a if the test fails
+    Jump,        ///< Jump to a
+    Halt         ///< Flush the batch and stop
+};
+
+/**
+ * @brief Bits of Instruction::flags
+ */
+namespace instruction_flags {
+    constexpr uint8_t Register = 0x01;   ///< b is a register index rather than an immediate
+    constexpr uint8_t Alternate = 0x02;  ///< Absolute for Move, horizontal for Scroll
+    // The high nibble holds the Comparison of a JumpUnless
+}
+
+/**
+ * @enum Comparison
+ * @brief Tests available to JumpUnless
+ */
+enum class Comparison : uint8_t {
+    Equal, NotEqual, Less, LessEqual, Greater, GreaterEqual
+};
+
+/**
+ * @struct Instruction
+ * @brief One 8-byte bytecode instruction
+ */
+struct Instruction {
+    Opcode op;
+    uint8_t flags;  ///< instruction_flags bits
+    uint16_t a;     ///< Count, destination register or jump target, depending on op
+    int32_t b;      ///< Operand: immediate value or register index
+};
+
+static_assert(sizeof(Instruction) == 8, "Instruction must stay 8 bytes");
+
+/**
+ * @struct Program
+ * @brief A compiled script
+ * @details Key, button and text commands are resolved to events at compile time,
+ * using the keyboard layout active then, and stored in one pool that Emit
+ * instructions slice.
+ */
+struct Program {
+    std::vector<Instruction> code;        ///< Bytecode, always ending in Halt
+    std::vector<Event> events;            ///< Event pool
+    std::vector<std::string> variables;   ///< Register names; hidden loop counters start with '#'
+};
+
+/**
+ * @brief Compile a script
+ * @param source The script text
+ * @param bego Instance used to build key events for the current layout
+ * @return Program The compiled program
+ * @throws InputError If the script is invalid; the message names the line
+ */
+Program compile_script(std::string_view source, Bego& bego);
+
+/**
+ * @brief Check that a program only refers to its own code, registers and events
+ * @details Needed before running a program that was not just compiled, e.g. one read from a file
+ * @param program The program to check
+ * @return bool True if ScriptVM::run can run it safely
+ */
+bool validate(const Program& program);
+
+/**
+ * @brief Hash script source text (64-bit FNV-1a)
+ * @param source The text to hash
+ * @param seed Starting value, to chain several inputs into one hash
+ * @return uint64_t The hash
+ */
+uint64_t script_hash(std::string_view source, uint64_t seed = 0xcbf29ce484222325ull);
+
+/**
+ * @struct ScriptStats
+ * @brief Counters reported by a script run
+ */
+struct ScriptStats {
+    uint64_t instructions = 0;  ///< Instructions executed
+    uint64_t events = 0;        ///< Events sent
+    uint64_t batches = 0;       ///< Calls to Bego::send()
+    bool cancelled = false;     ///< True if the run was stopped through the cancel flag
+};
+
+/**
+ * @class ScriptVM
+ * @brief Interpreter for compiled scripts
+ *
+ * @details A single switch over 8-byte instructions. Events are collected into a batch
+ * and handed to Bego::send() when the script sleeps, waits or ends, so everything the
+ * script does between two waits reaches the system in one dispatch.
+ */
+class ScriptVM {
+public:
+    /// Flush the batch early once it holds this many events
+    static constexpr size_t max_batch = 256;
+
+    /**
+     * @brief Construct a VM sending to a Bego instance
+     * @param bego The instance receiving the events; must outlive the VM
+     */
+    explicit ScriptVM(Bego& bego) : bego(bego) {}
+
+    /**
+     * @brief Run a program to completion
+     * @details Variables start at zero on every run
+     * @param program The program to run
+     * @param cancel Optional flag, checked at waits and loop back-edges
+     * @return ScriptStats Counters for the run
+     * @throws InputError On division by zero or when sending fails
+     */
+    ScriptStats run(const Program& program, const std::atomic<bool>* cancel = nullptr);
+
+    /**
+     * @brief Get the value of a variable after a run
+     * @param program The program that was run
+     * @param name The variable name
+     * @return std::optional<int32_t> The value, or std::nullopt for unknown names
+     */
+    std::optional<int32_t> variable(const Program& program, std::string_view name) const;
+
+private:
+    /**
+     * @brief Send the pending batch, if any
+     * @param stats Counters to update
+     */
+    void flush(ScriptStats& stats);
+
+    Bego& bego;
+    std::vector<int32_t> registers;
+    std::vector<Event> batch;
+    std::optional<std::pair<int, int>> cursor;  ///< Where the batch leaves the cursor, empty once sent
+};
+
+/**
+ * @class Tokenizer
+ * @brief Splits a command line into whitespace-separated words without copying
+ */
+class Tokenizer {
+public:
+    /**
+     * @brief Construct a tokenizer over a line; the line must outlive the tokenizer
+     * @param line The text to split
+     */
+    explicit Tokenizer(std::string_view line) : line(line) {}
+
+    /**
+     * @brief Get the next word
+     * @return std::string_view The word, empty at the end of the line or at a comment
+     */
+    std::string_view next();
+
+    /**
+     * @brief Get the rest of the line after the next run of whitespace
+     * @return std::string_view The remaining text, unparsed
+     */
+    std::string_view rest();
+
+private:
+    std::string_view line;
+    size_t position = 0;
+};
+
+/**
+ * @brief Parse a duration such as "250us", "15ms", "2s" or "40" (milliseconds)
+ * @param word The text to parse
+ * @return std::optional<std::chrono::microseconds> The duration, or std::nullopt if invalid
+ */
+std::optional<std::chrono::microseconds> parse_duration(std::string_view word);
+
+/**
+ * @brief Parse a decimal integer, with optional sign, or a 0x-prefixed hexadecimal one
+ * @param word The text to parse
+ * @return std::optional<int32_t> The value, or std::nullopt if invalid or out of range
+ */
+std::optional<int32_t> parse_integer(std::string_view word);
+
+/**
+ * @brief Parse a direction name: click, press/down or release/up
+ * @param word The text to parse
+ * @return std::optional<Direction> The direction, or std::nullopt if invalid
+ */
+std::optional<Direction> parse_direction(std::string_view word);
+
+} // namespace bego
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "bego_script.h"
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @file bego_script_cache.h
+ * @author Eterninety
+ * @brief On-disk cache of compiled scripts and text buffers
+ * @version 1.0
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace bego {
+
+class Bego;
+
+/**
+ * @class ScriptCache
+ * @brief Stores compiled Programs in a directory, one file per entry
+ *
+ * @details Entries are keyed by a hash of the source text, the active keyboard layout,
+ * the library version and the cache format, so an edit, a layout switch or an upgrade
+ * simply misses and recompiles: nothing has to be invalidated by hand. Entries are read
+ * through a memory mapping and written to a temporary file that is renamed into place,
+ * so concurrent agents sharing a cache never see a partial entry.
+ *
+ * The cache is an optimization only: unreadable or corrupt entries count as misses and
+ * failures to write are ignored.
+ */
+class ScriptCache {
+public:
+    /// Bumped whenever the entry layout or the bytecode changes
+    static constexpr uint32_t format_version = 1;
+
+    /**
+     * @brief Use a cache directory, creating it if needed
+     * @param directory Where entries are stored
+     */
+    explicit ScriptCache(std::string directory);
+
+    /**
+     * @brief Compile a script, or load it from the cache
+     * @param source The script text
+     * @param bego Instance used to compile on a miss
+     * @return Program The compiled program
+     * @throws InputError If the script does not compile
+     */
+    Program compile(std::string_view source, Bego& bego);
+
+    /**
+     * @brief Build the events that type a string, or load them from the cache
+     * @param text The text to type
+     * @param bego Instance used to build the events on a miss
+     * @return std::vector<Event> The events, as Bego::queue_text() builds them
+     * @throws InputError If the text contains a null byte
+     */
+    std::vector<Event> text(const std::string& text, Bego& bego);
+
+    /**
+     * @brief Compute the key of a script for the current layout
+     * @param source The script text
+     * @return uint64_t The cache key
+     */
+    static uint64_t script_key(std::string_view source);
+
+    /**
+     * @brief Compute the key of a text buffer for the current layout
+     * @param text The text to type
+     * @return uint64_t The cache key
+     */
+    static uint64_t text_key(std::string_view text);
+
+    /**
+     * @brief Load an entry
+     * @param key The cache key
+     * @return std::optional<Program> The entry, or std::nullopt on a miss
+     */
+    std::optional<Program> find(uint64_t key) const;
+
+    /**
+     * @brief Store an entry, replacing any previous one
+     * @param key The cache key
+     * @param program The entry
+     * @return bool False if the entry could not be written
+     */
+    bool store(uint64_t key, const Program& program) const;
+
+    /**
+     * @brief Get the number of lookups served from disk
+     * @return uint64_t The hit count
+     */
+    uint64_t hits() const { return hit_count.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Get the number of lookups that had to compile
+     * @return uint64_t The miss count
+     */
+    uint64_t misses() const { return miss_count.load(std::memory_order_relaxed); }
+
+private:
+    /**
+     * @brief Get the file of an entry
+     * @param key The cache key
+     * @return std::string The path
+     */
+    std::string path(uint64_t key) const;
+
+    std::string directory;
+    mutable std::atomic<uint64_t> hit_count{0};
+    mutable std::atomic<uint64_t> miss_count{0};
+};
+
+} // namespace bego
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "bego_mapped_file.h"
+#include "bego_script.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file bego_script_library.h
+ * @author Eterninety
+ * @brief Single-file libraries of named, compiled macros with a hash index
+ * @version 1.0
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace bego {
+
+class Bego;
+class ScriptLibraryBuilder;
+
+/**
+ * @class ScriptLibrary
+ * @brief Read-only library of compiled scripts (macros), looked up by name
+ *
+ * @details The file is memory-mapped and nothing is read up front beyond its header:
+ * a name is hashed into an open-addressing table stored in the file, so a lookup
+ * touches one or two buckets and one entry, and a macro's code is copied out of the
+ * mapping the first time it is requested. Opening a library and the memory it keeps
+ * resident therefore do not grow with the number of macros it holds, only with the
+ * number actually used.
+ *
+ * A library is tied to the keyboard layout and library version it was built with,
+ * because compiled scripts contain resolved scan codes.
+ */
+class ScriptLibrary {
+public:
+    /// Bumped whenever the file layout or the bytecode changes
+    static constexpr uint32_t format_version = 1;
+
+    /**
+     * @brief Open a library
+     * @param path The library file
+     * @throws InputError If the file is not a library, is damaged, or was built for a
+     * different keyboard layout or library version
+     */
+    explicit ScriptLibrary(const std::string& path);
+
+    /**
+     * @brief Get a macro, loading it on first use
+     * @param name The macro name (exact match)
+     * @return std::shared_ptr<const Program> The macro, or null if there is none by that name
+     * @throws InputError If the macro's data is damaged
+     */
+    std::shared_ptr<const Program> find(std::string_view name) const;
+
+    /**
+     * @brief Check whether a macro exists, without loading it
+     * @param name The macro name
+     * @return bool True if the library has the macro
+     */
+    bool contains(std::string_view name) const;
+
+    /**
+     * @brief Get the number of macros
+     * @return size_t The macro count
+     */
+    size_t size() const { return entry_count; }
+
+    /**
+     * @brief Get the name of a macro by position, for listing
+     * @param index Position in the library, below size()
+     * @return std::string_view The name, pointing into the mapping
+     */
+    std::string_view name(size_t index) const;
+
+    /**
+     * @brief Get the number of macros loaded so far
+     * @return size_t The loaded count
+     */
+    size_t loaded() const;
+
+private:
+    friend class ScriptLibraryBuilder;
+
+    struct Entry;
+
+    /**
+     * @brief Find the entry of a name in the hash table
+     * @return const Entry* The entry, or null if there is none
+     */
+    const Entry* lookup(std::string_view name) const;
+
+    MappedFile file;
+    size_t entry_count = 0;
+    uint32_t bucket_mask = 0;
+    const uint32_t* buckets = nullptr;
+    const Entry* entries = nullptr;
+    const char* names = nullptr;
+    size_t names_size = 0;
+
+    mutable std::mutex mutex;
+    mutable std::unordered_map<const Entry*, std::shared_ptr<const Program>> cache;
+};
+
+/**
+ * @class ScriptLibraryBuilder
+ * @brief Collects compiled scripts and writes them as a ScriptLibrary file
+ */
+class ScriptLibraryBuilder {
+public:
+    /**
+     * @brief Add a macro
+     * @param name The macro name
+     * @param program The compiled macro
+     * @throws InputError If the name is empty or already used
+     */
+    void add(const std::string& name, Program program);
+
+    /**
+     * @brief Compile a script and add it
+     * @param name The macro name
+     * @param source The script text
+     * @param bego Instance used to compile the script
+     * @throws InputError If the script does not compile or the name is taken
+     */
+    void add_script(const std::string& name, std::string_view source, Bego& bego);
+
+    /**
+     * @brief Get the number of macros added
+     * @return size_t The macro count
+     */
+    size_t size() const { return macros.size(); }
+
+    /**
+     * @brief Write the library
+     * @details The file is written next to its final name and renamed into place,
+     * so agents never open a partial library
+     * @param path The library file
+     * @throws InputError If the file cannot be written
+     */
+    void write(const std::string& path) const;
+
+private:
+    struct Macro {
+        std::string name;
+        Program program;
+    };
+
+    std::vector<Macro> macros;
+    std::unordered_map<std::string, size_t> positions;
+};
+
+} // namespace bego
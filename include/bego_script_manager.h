@@ -0,0 +1,185 @@
+#pragma once
+
+#include "bego_script.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file bego_script_manager.h
+ * @author Eterninety
+ * @brief Script directory loading with live reload
+ * @version 1.0
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace bego {
+
+class Bego;
+class ScriptCache;
+
+/**
+ * @class ScriptManager
+ * @brief Keeps the compiled scripts of a directory up to date while they are in use
+ *
+ * @details Scripts are published as immutable Programs behind shared pointers, in a name
+ * table that is itself replaced as a whole (read-copy-update). get() is a single atomic
+ * load, so lookups never wait for a recompile, and a run that holds a Program keeps
+ * using that version until it ends, even if the file changes meanwhile.
+ *
+ * A watcher thread picks up changes (inotify on Linux, change notifications on Windows,
+ * periodic rescans elsewhere) and recompiles only the files whose contents changed.
+ * A script that fails to compile keeps its previous version.
+ */
+class ScriptManager {
+public:
+    /**
+     * @brief Receives compile errors from the watcher thread
+     * @param path The file that failed
+     * @param error The compile error
+     */
+    using ErrorHandler = std::function<void(const std::string& path, const InputError& error)>;
+
+    /**
+     * @brief Construct a manager compiling for a Bego instance
+     * @param bego Instance used to compile scripts; must outlive the manager
+     * @param extension File extension of scripts, including the dot
+     */
+    explicit ScriptManager(Bego& bego, std::string extension = ".bego");
+
+    /**
+     * @brief Destructor - stops the watcher thread
+     */
+    ~ScriptManager();
+
+    ScriptManager(const ScriptManager&) = delete;
+    ScriptManager& operator=(const ScriptManager&) = delete;
+
+    /**
+     * @brief Load every script of a directory and keep watching it for changes
+     * @details Scripts that fail to compile now are reported to the error handler
+     * @param directory The directory to watch; only one directory per manager
+     * @throws InputError If the directory cannot be read or a directory is already watched
+     */
+    void watch(const std::string& directory);
+
+    /**
+     * @brief Stop watching; the loaded scripts stay available
+     */
+    void stop();
+
+    /**
+     * @brief Compile one file and publish it under its stem ("attack.bego" -> "attack")
+     * @param path The script file
+     * @return bool False if the file is unchanged since it was last compiled
+     * @throws InputError If the file cannot be read or does not compile
+     */
+    bool load(const std::string& path);
+
+    /**
+     * @brief Look up the current version of a script
+     * @param name The script name (file stem)
+     * @return std::shared_ptr<const Program> The program, or null if there is none
+     */
+    std::shared_ptr<const Program> get(std::string_view name) const;
+
+    /**
+     * @brief Get the names of all loaded scripts
+     * @return std::vector<std::string> The names, sorted
+     */
+    std::vector<std::string> names() const;
+
+    /**
+     * @brief Get the number of times the script table has been republished
+     * @return uint64_t The generation, starting at 0
+     */
+    uint64_t generation() const { return published.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Compile through an on-disk cache
+     * @details Set before watch() so the initial load benefits from it
+     * @param cache The cache, or null to always compile
+     */
+    void use_cache(std::shared_ptr<ScriptCache> cache);
+
+    /**
+     * @brief Set the handler for compile errors found while watching
+     * @param handler The handler; called on the watcher thread
+     */
+    void on_error(ErrorHandler handler);
+
+private:
+    using Table = std::unordered_map<std::string, std::shared_ptr<const Program>>;
+
+    /**
+     * @brief What was last compiled from a file
+     */
+    struct Source {
+        std::string name;
+        uint64_t hash;
+        int64_t modified;  ///< File time, to skip rereading untouched files on rescans
+        bool compiled;     ///< False if this content failed to compile
+    };
+
+    /**
+     * @brief Reload a changed file, reporting compile errors instead of throwing
+     * @param path The script file
+     */
+    void reload(const std::string& path);
+
+    /**
+     * @brief Drop a deleted file's script
+     * @param path The script file
+     */
+    void remove(const std::string& path);
+
+    /**
+     * @brief Compare the directory with what was loaded and apply the differences
+     */
+    void rescan();
+
+    /**
+     * @brief Replace one table entry and publish the new table
+     * @param name The script name
+     * @param program The new program, or null to remove the entry
+     */
+    void publish(const std::string& name, std::shared_ptr<const Program> program);
+
+    /**
+     * @brief Check whether a path has the script extension
+     */
+    bool is_script(const std::string& path) const;
+
+    /**
+     * @brief Watcher thread body
+     */
+    void run();
+
+    Bego& bego;
+    std::string extension;
+    std::string directory;
+
+    std::shared_ptr<const Table> table;    ///< Accessed with std::atomic_load/atomic_store
+    std::atomic<uint64_t> published{0};
+
+    std::mutex writer_mutex;               ///< Serializes load, reload and publish
+    std::unordered_map<std::string, Source> sources;
+    ErrorHandler error_handler;
+    std::shared_ptr<ScriptCache> cache;
+
+    std::thread watcher;
+    std::atomic<bool> stopping{false};
+};
+
+} // namespace bego
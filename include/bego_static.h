@@ -0,0 +1,238 @@
+#pragma once
+
+#include "bego_win.h"
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @file bego_static.h
+ * @author Eterninety
+ * @brief Static-dispatch (CRTP) counterparts of the Mouse and Keyboard interfaces
+ * @version 1.0
+ *
+ * @details Code written against Mouse& or Keyboard& makes a virtual call per action, which
+ * the compiler cannot inline. Code templated on StaticMouse<T> and StaticKeyboard<T>
+ * calls T directly, so the event-building bodies are inlined into the caller's loop:
+ *
+ * @code
+ * template <typename T>
+ * void draw_square(bego::StaticMouse<T>& mouse, int x, int y, int side) {
+ *     mouse.move_mouse(x, y, bego::Coordinate::Abs);
+ *     mouse.button(bego::Button::Left, bego::Direction::Press);
+ *     mouse.move_mouse(side, 0, bego::Coordinate::Rel);
+ *     mouse.move_mouse(0, side, bego::Coordinate::Rel);
+ *     mouse.move_mouse(-side, 0, bego::Coordinate::Rel);
+ *     mouse.move_mouse(0, -side, bego::Coordinate::Rel);
+ *     mouse.button(bego::Button::Left, bego::Direction::Release);
+ * }
+ *
+ * std::vector<bego::Event> events;
+ * bego::EventWriter writer(events, {1920, 1080});
+ * draw_square(writer, 100, 100, 50);  // Seven direct buffer writes
+ *
+ * bego::StaticAdapter<bego::Bego> adapter(bego);
+ * draw_square(adapter, 100, 100, 50);  // Bego without the virtual calls
+ * @endcode
+ *
+ * A class implements the interface by deriving from StaticMouse<Self> and/or
+ * StaticKeyboard<Self> and defining the methods with the same names; only the
+ * methods a caller actually uses have to exist.
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace bego {
+
+/**
+ * @class StaticMouse
+ * @brief Mouse interface resolved at compile time
+ * @tparam Derived The implementing class, which defines the methods below
+ */
+template <typename Derived>
+class StaticMouse {
+public:
+    decltype(auto) button(Button button, Direction direction) {
+        return self().button(button, direction);
+    }
+
+    decltype(auto) scroll(int length, Axis axis) {
+        return self().scroll(length, axis);
+    }
+
+    decltype(auto) move_mouse(int x, int y, Coordinate coordinate) {
+        return self().move_mouse(x, y, coordinate);
+    }
+
+    std::pair<int, int> main_display() {
+        return self().main_display();
+    }
+
+    std::pair<int, int> location() {
+        return self().location();
+    }
+
+protected:
+    StaticMouse() = default;
+    ~StaticMouse() = default;
+
+private:
+    Derived& self() { return static_cast<Derived&>(*this); }
+};
+
+/**
+ * @class StaticKeyboard
+ * @brief Keyboard interface resolved at compile time
+ * @tparam Derived The implementing class, which defines the methods below
+ */
+template <typename Derived>
+class StaticKeyboard {
+public:
+    std::optional<bool> fast_text(const std::string& text) {
+        return self().fast_text(text);
+    }
+
+    decltype(auto) text(const std::string& text) {
+        return self().text(text);
+    }
+
+    decltype(auto) key(Key key, Direction direction) {
+        return self().key(key, direction);
+    }
+
+    decltype(auto) raw(uint16_t scan, Direction direction) {
+        return self().raw(scan, direction);
+    }
+
+protected:
+    StaticKeyboard() = default;
+    ~StaticKeyboard() = default;
+
+private:
+    Derived& self() { return static_cast<Derived&>(*this); }
+};
+
+/**
+ * @class StaticAdapter
+ * @brief Presents an implementation of the virtual interfaces, such as Bego, as the static ones
+ *
+ * @details Calls are qualified with T, so they bind to T's own methods without going
+ * through the vtable even though those methods are virtual.
+ *
+ * @tparam T A class implementing Mouse and Keyboard; it must outlive the adapter
+ */
+template <typename T>
+class StaticAdapter : public StaticMouse<StaticAdapter<T>>, public StaticKeyboard<StaticAdapter<T>> {
+public:
+    explicit StaticAdapter(T& target) : target(target) {}
+
+    void button(Button button, Direction direction) { target.T::button(button, direction); }
+    void scroll(int length, Axis axis) { target.T::scroll(length, axis); }
+    void move_mouse(int x, int y, Coordinate coordinate) { target.T::move_mouse(x, y, coordinate); }
+    std::pair<int, int> main_display() { return target.T::main_display(); }
+    std::pair<int, int> location() { return target.T::location(); }
+
+    std::optional<bool> fast_text(const std::string& text) { return target.T::fast_text(text); }
+    void text(const std::string& text) { target.T::text(text); }
+    void key(Key key, Direction direction) { target.T::key(key, direction); }
+    void raw(uint16_t scan, Direction direction) { target.T::raw(scan, direction); }
+
+private:
+    T& target;
+};
+
+/**
+ * @class EventWriter
+ * @brief Implements the static interfaces by appending events to a buffer
+ *
+ * @details Nothing is sent; the buffer can be handed to Bego::send() or a backend
+ * later. The writer keeps its own cursor, starting at the given position and clamped
+ * to the screen, so relative moves and location() take earlier moves in the same
+ * buffer into account. Mouse actions are inlined into plain appends; key actions go
+ * through the keyboard layout like Bego's.
+ */
+class EventWriter : public StaticMouse<EventWriter>, public StaticKeyboard<EventWriter> {
+public:
+    /**
+     * @brief Construct a writer appending to a buffer
+     * @param events The buffer to append to; it must outlive the writer
+     * @param screen Width and height of the screen the events are meant for
+     * @param cursor Cursor position when the events start
+     * @throws InputError If either screen dimension is below 2
+     */
+    EventWriter(std::vector<Event>& events, std::pair<int, int> screen, std::pair<int, int> cursor = {0, 0})
+        : events(events), screen(screen) {
+        if (screen.first < 2 || screen.second < 2) {
+            throw InputError(InputError::Type::InvalidInput, "The screen must be at least 2x2 pixels");
+        }
+        warp(cursor.first, cursor.second);
+    }
+
+    void button(Button button, Direction direction) {
+        if (static_cast<unsigned>(button) > static_cast<unsigned>(Button::Forward)) {
+            // Scroll buttons and invalid values
+            return Bego::queue_button(events, button, direction);
+        }
+        if (direction != Direction::Release) {
+            events.push_back(Event::button(false, button));
+        }
+        if (direction != Direction::Press) {
+            events.push_back(Event::button(true, button));
+        }
+    }
+
+    void scroll(int length, Axis axis) {
+        events.push_back(Event::wheel(axis, (axis == Axis::Horizontal ? length : -length) * WHEEL_DELTA));
+    }
+
+    /**
+     * @brief Append a move; relative moves become absolute ones from the writer's cursor
+     * @param x The x-coordinate or x-distance
+     * @param y The y-coordinate or y-distance
+     * @param coordinate Whether the coordinates are absolute or relative
+     */
+    void move_mouse(int x, int y, Coordinate coordinate) {
+        if (coordinate == Coordinate::Rel) {
+            x += cursor_x;
+            y += cursor_y;
+        }
+        warp(x, y);
+        events.push_back(Event::move(true, normalize_coordinate(cursor_x, screen.first),
+                                     normalize_coordinate(cursor_y, screen.second)));
+    }
+
+    std::pair<int, int> main_display() { return screen; }
+    std::pair<int, int> location() { return {cursor_x, cursor_y}; }
+
+    std::optional<bool> fast_text(const std::string&) { return std::nullopt; }
+
+    void text(const std::string& text) {
+        Bego::queue_text(events, text);
+    }
+
+    void key(Key key, Direction direction) {
+        Bego::queue_key(events, key, direction);
+    }
+
+    void raw(uint16_t scan, Direction direction) {
+        Bego::queue_raw(events, scan, direction);
+    }
+
+private:
+    void warp(int x, int y) {
+        cursor_x = std::clamp(x, 0, screen.first - 1);
+        cursor_y = std::clamp(y, 0, screen.second - 1);
+    }
+
+    std::vector<Event>& events;
+    std::pair<int, int> screen;
+    int cursor_x = 0;
+    int cursor_y = 0;
+};
+
+} // namespace bego
@@ -0,0 +1,169 @@
+#pragma once
+
+#include "bego_event.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+/**
+ * @file bego_stream.h
+ * @author Eterninety
+ * @brief Pull-based event streams dispatched in fixed-size chunks
+ * @version 1.0
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace bego {
+
+class Bego;
+
+/**
+ * @class EventStream
+ * @brief A possibly unbounded sequence of events, pulled a chunk at a time
+ */
+class EventStream {
+public:
+    /**
+     * @brief Virtual destructor for interface
+     */
+    virtual ~EventStream() = default;
+
+    /**
+     * @brief Produce the next events
+     * @param out Buffer receiving the events
+     * @param capacity Room in the buffer (at least 1)
+     * @return size_t Number of events written; 0 once the stream is exhausted
+     */
+    virtual size_t read(Event* out, size_t capacity) = 0;
+};
+
+/**
+ * @class GeneratorStream
+ * @brief Stream calling a generator function once per event
+ */
+class GeneratorStream : public EventStream {
+public:
+    /**
+     * @typedef Generator
+     * @brief Writes the next event and returns true, or returns false when done
+     */
+    using Generator = std::function<bool(Event& out)>;
+
+    /**
+     * @brief Construct a stream over a generator
+     * @param generator The generator; called from the thread reading the stream
+     */
+    explicit GeneratorStream(Generator generator) : generator(std::move(generator)) {}
+
+    size_t read(Event* out, size_t capacity) override;
+
+private:
+    Generator generator;
+    bool done = false;
+};
+
+/**
+ * @class RangeStream
+ * @brief Stream reading an iterator range, which may be lazy or unbounded
+ * @tparam Iterator An input iterator whose value type converts to Event
+ * @tparam Sentinel Type of the end of the range, compared against the iterator
+ */
+template <typename Iterator, typename Sentinel = Iterator>
+class RangeStream : public EventStream {
+public:
+    /**
+     * @brief Construct a stream over [begin, end); the range must outlive the stream
+     * @param begin The first element
+     * @param end The end of the range
+     */
+    RangeStream(Iterator begin, Sentinel end) : current(std::move(begin)), end(std::move(end)) {}
+
+    size_t read(Event* out, size_t capacity) override {
+        size_t count = 0;
+        while (count < capacity && !(current == end)) {
+            out[count++] = *current;
+            ++current;
+        }
+        return count;
+    }
+
+private:
+    Iterator current;
+    Sentinel end;
+};
+
+/**
+ * @brief Make a stream over a range
+ * @param range Any range of events; it must outlive the stream
+ * @return RangeStream A stream reading the range front to back
+ */
+template <typename Range>
+auto make_range_stream(Range& range) {
+    using std::begin;
+    using std::end;
+    return RangeStream<decltype(begin(range)), decltype(end(range))>(begin(range), end(range));
+}
+
+/**
+ * @struct StreamStats
+ * @brief What a StreamPump run did
+ */
+struct StreamStats {
+    uint64_t events = 0;          ///< Events dispatched
+    uint64_t chunks = 0;          ///< Batches dispatched
+    uint64_t producer_waits = 0;  ///< Times generation waited for a free chunk (dispatch was slower)
+    uint64_t consumer_waits = 0;  ///< Times dispatch waited for a filled chunk (generation was slower)
+    bool cancelled = false;       ///< Whether the run was stopped by its cancel flag
+};
+
+/**
+ * @class StreamPump
+ * @brief Dispatches an event stream while the next chunks are being generated
+ *
+ * @details A producer thread reads the stream into a fixed ring of chunks while the
+ * calling thread sends each filled chunk with Bego::send() as one batch. Memory use is
+ * chunk_size * chunk_count events no matter how long the stream runs, and a slow
+ * generator only delays dispatch when the ring has run empty.
+ */
+class StreamPump {
+public:
+    /// Default events per chunk, one dispatch each
+    static constexpr size_t default_chunk_size = 256;
+
+    /// Default number of chunks in the ring
+    static constexpr size_t default_chunk_count = 4;
+
+    /**
+     * @brief Construct a pump
+     * @param bego The instance receiving the events
+     * @param chunk_size Events per chunk
+     * @param chunk_count Chunks in the ring (at least 2 for any overlap)
+     * @throws InputError If either size is zero
+     */
+    explicit StreamPump(Bego& bego, size_t chunk_size = default_chunk_size,
+                        size_t chunk_count = default_chunk_count);
+
+    /**
+     * @brief Dispatch a stream until it is exhausted or cancelled
+     * @details The stream is read on a separate thread for the duration of the call.
+     * An exception thrown by the stream or by dispatch stops both sides and is
+     * rethrown here.
+     * @param source The stream to dispatch
+     * @param cancel Optional flag; setting it stops the run after the current chunk
+     * @return StreamStats What the run did
+     */
+    StreamStats run(EventStream& source, const std::atomic<bool>* cancel = nullptr);
+
+private:
+    Bego& bego;
+    size_t chunk_size;
+    size_t chunk_count;
+};
+
+} // namespace bego
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "bego_event.h"
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <utility>
+
+/**
+ * @file bego_virtual_desktop.h
+ * @author Eterninety
+ * @brief Headless, in-process model of a screen, cursor and keyboard for functional tests
+ * @version 1.0
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace bego {
+
+/**
+ * @struct KeyboardLayout
+ * @brief How a simulated keyboard turns scan codes into virtual keys and keys into characters
+ */
+struct KeyboardLayout {
+    /// Virtual key by scan code, indexed by the low byte plus 0x100 for extended (0xE0) codes
+    std::array<uint8_t, 0x200> vk_by_scan{};
+
+    /// Character typed by each virtual key without Shift, 0 for none
+    std::array<char, 256> normal{};
+
+    /// Character typed by each virtual key with Shift, 0 for none
+    std::array<char, 256> shifted{};
+
+    /**
+     * @brief Get the US QWERTY layout
+     * @return const KeyboardLayout& The layout
+     */
+    static const KeyboardLayout& us();
+};
+
+/**
+ * @class VirtualDesktop
+ * @brief Backend that applies events to a simulated desktop instead of sending them
+ *
+ * @details The model has a screen of a given size, a cursor clamped to it, the state of
+ * every virtual key and mouse button, the wheel totals and the text typed so far.
+ * Bego asks it for the screen size and cursor position instead of the operating system,
+ * so absolute moves, relative moves and location() behave as they would on a real
+ * desktop of that size, and scripts can be checked against the model at memory speed.
+ *
+ * Absolute moves undo Bego's normalization exactly, so a move to (x, y) lands on (x, y).
+ * Relative moves are applied pixel for pixel; pointer acceleration is not modelled.
+ * Scan code events are read through the keyboard layout, as Windows ignores the
+ * virtual key of such events.
+ */
+class VirtualDesktop : public Backend {
+public:
+    /**
+     * @brief Construct a desktop with the cursor in the top-left corner
+     * @param width Screen width in pixels
+     * @param height Screen height in pixels
+     * @param layout Keyboard layout; it must outlive the desktop
+     * @throws InputError If either dimension is below 2
+     */
+    explicit VirtualDesktop(int width = 1920, int height = 1080, const KeyboardLayout& layout = KeyboardLayout::us());
+
+    /**
+     * @brief Apply a batch of events to the model
+     * @param events Pointer to the first event
+     * @param count Number of events
+     * @throws InputError If an event refers to an unknown mouse button
+     */
+    void dispatch(const Event* events, size_t count) override;
+
+    std::optional<std::pair<int, int>> screen_size() override;
+    std::optional<std::pair<int, int>> cursor_position() override;
+
+    /**
+     * @brief Change the screen size; the cursor is clamped to the new screen
+     * @param width Screen width in pixels
+     * @param height Screen height in pixels
+     * @throws InputError If either dimension is below 2
+     */
+    void resize(int width, int height);
+
+    /**
+     * @brief Move the cursor directly, as the user would
+     * @param x Horizontal position, clamped to the screen
+     * @param y Vertical position, clamped to the screen
+     */
+    void warp(int x, int y);
+
+    /**
+     * @brief Check whether a virtual key is down
+     * @param vk The virtual key code
+     * @return bool True if it is held
+     */
+    bool is_down(uint16_t vk) const;
+
+    /**
+     * @brief Check whether a mouse button is down
+     * @param button The button
+     * @return bool True if it is held
+     */
+    bool is_down(Button button) const;
+
+    /**
+     * @brief Get the wheel totals
+     * @return std::pair<int, int> Vertical and horizontal wheel data summed so far
+     */
+    std::pair<int, int> wheel() const;
+
+    /**
+     * @brief Get the text typed so far, as UTF-8
+     * @details Unicode events type their character; key presses type what the layout
+     * gives for the key with the current Shift state, and Backspace removes a character.
+     * @return std::string The text
+     */
+    std::string typed() const;
+
+    /**
+     * @brief Get the number of events applied
+     * @return uint64_t The event count
+     */
+    uint64_t events() const;
+
+    /**
+     * @brief Release everything, clear the text and counters and home the cursor
+     */
+    void reset();
+
+private:
+    void apply(const Event& event);
+    void type(uint32_t code_point);
+    static void check_size(int width, int height);
+
+    const KeyboardLayout& layout;
+
+    mutable std::mutex mutex;
+    int width;
+    int height;
+    int x = 0;
+    int y = 0;
+    std::array<bool, 256> keys{};
+    std::array<bool, 5> buttons{};
+    int vertical = 0;
+    int horizontal = 0;
+    std::string text;
+    uint16_t high_surrogate = 0;
+    uint64_t count = 0;
+};
+
+} // namespace bego
@@ -1,7 +1,16 @@
 #pragma once
 
 #include "bego.h"
+#include "bego_event.h"
+#include "bego_flight.h"
+#include "bego_hold.h"
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <tuple>
+#include <unordered_map>
 #include <Windows.h>
 
 /**
@@ -50,6 +59,58 @@ WORD key_to_vk(Key key);
  */
 Key vk_to_key(WORD vk);
 
+/**
+ * @class Win32Backend
+ * @brief Backend that expands events into INPUT structures and delivers them with SendInput
+ */
+class Win32Backend : public Backend {
+public:
+    /**
+     * @brief Construct a Windows backend
+     * @param dw_extra_info Marker value written to the dwExtraInfo field of every event
+     */
+    explicit Win32Backend(size_t dw_extra_info = EVENT_MARKER);
+    
+    /**
+     * @brief Expand the events and send them in a single SendInput call
+     * @param events Pointer to the first event
+     * @param count Number of events
+     * @throws InputError If not all events were sent
+     */
+    void dispatch(const Event* events, size_t count) override;
+    
+    /**
+     * @brief Size the calling thread's INPUT scratch buffer for batches of max_batch events
+     * @param max_batch The largest batch that will be dispatched
+     */
+    void prepare(size_t max_batch) override;
+    
+private:
+    /**
+     * @brief Marker value written to the dwExtraInfo field of every event
+     */
+    size_t dw_extra_info;
+};
+
+/**
+ * @struct HeldChange
+ * @brief A key, scan code or button going down or up, as reported to held-state listeners
+ */
+struct HeldChange {
+    HoldTarget target;  ///< The input that changed
+    bool pressed;       ///< True if it went down, false if it went up
+    uint64_t version;   ///< Held-state version right after the change
+};
+
+/**
+ * @struct HeldView
+ * @brief Snapshot of the held inputs, refreshed in place by Bego::held(HeldView&)
+ */
+struct HeldView {
+    uint64_t version = 0;              ///< Held-state version the snapshot was taken at
+    std::vector<HoldTarget> targets;   ///< Held keys, scan codes and buttons, in press order
+};
+
 /**
  * @class Bego
  * @brief The main class for hardware-level input simulation on Windows
@@ -66,6 +127,13 @@ public:
      */
     explicit Bego(const Settings& settings);
     
+    /**
+     * @brief Construct a new Bego object that delivers its events to a custom backend
+     * @param settings Configuration settings for the input simulation
+     * @param backend The backend receiving every dispatched event
+     */
+    Bego(const Settings& settings, std::shared_ptr<Backend> backend);
+    
     /**
      * @brief Destroy the Bego object and release any held keys if configured
      */
@@ -135,12 +203,171 @@ public:
     void raw(uint16_t scan, Direction direction) override;
     
     // Additional methods
+    /**
+     * @brief Send pre-built events in a single dispatch
+     * @details Held keys, scan codes and timed holds are updated from the events,
+     * exactly as if they had been generated by key(), raw() and button()
+     * @param events Pointer to the first event
+     * @param count Number of events
+     */
+    void send(const Event* events, size_t count);
+    
+    // Batch building
+    // Only queue_move depends on the instance (screen size, cursor and acceleration setting);
+    // the other builders are static so that BasicBego can share them
+    /**
+     * @brief Queue key events for later sending
+     * @details Adds the appropriate key events to the input queue based on direction.
+     * Queued events are sent with send(); nothing reaches the system before that.
+     * @param input_queue The queue to add events to
+     * @param key The key to simulate
+     * @param direction Whether to press, release, or click the key
+     */
+    static void queue_key(std::vector<Event>& input_queue, Key key, Direction direction);
+    
+    /**
+     * @brief Queue raw scan code events for later sending
+     * @param input_queue The queue to add events to
+     * @param scan The hardware scan code to simulate
+     * @param direction Whether to press, release, or click the key
+     */
+    static void queue_raw(std::vector<Event>& input_queue, uint16_t scan, Direction direction);
+    
+    /**
+     * @brief Queue mouse button events for later sending
+     * @details Scroll buttons are queued as wheel events
+     * @param input_queue The queue to add events to
+     * @param button The mouse button to simulate
+     * @param direction Whether to press, release, or click the button
+     * @throws InputError If an invalid button type is specified
+     */
+    static void queue_button(std::vector<Event>& input_queue, Button button, Direction direction);
+    
+    /**
+     * @brief Queue a mouse wheel event for later sending
+     * @param input_queue The queue to add events to
+     * @param length The amount to scroll (positive or negative)
+     * @param axis Whether to scroll horizontally or vertically
+     */
+    static void queue_scroll(std::vector<Event>& input_queue, int length, Axis axis);
+    
+    /**
+     * @brief Queue mouse movement events for later sending
+     * @param input_queue The queue to add events to
+     * @param x The x-coordinate or x-distance to move
+     * @param y The y-coordinate or y-distance to move
+     * @param coordinate Whether the coordinates are absolute or relative
+     */
+    void queue_move(std::vector<Event>& input_queue, int x, int y, Coordinate coordinate);
+
+    /**
+     * @brief Queue mouse movement events, starting from where earlier queued moves left the cursor
+     * @details Without acceleration, queue_move() resolves a relative move against the
+     * current cursor position, which does not include moves that are queued but not sent.
+     * This overload resolves it against cursor instead, so relative moves in one batch add up.
+     * @param input_queue The queue to add events to
+     * @param x The x-coordinate or x-distance to move
+     * @param y The y-coordinate or y-distance to move
+     * @param coordinate Whether the coordinates are absolute or relative
+     * @param cursor Where the queued events leave the cursor, or empty to use location();
+     * updated to the end of this move, or emptied when that cannot be known (relative
+     * moves with acceleration). Empty it whenever the queue is sent.
+     */
+    void queue_move(std::vector<Event>& input_queue, int x, int y, Coordinate coordinate,
+                    std::optional<std::pair<int, int>>& cursor);
+    
+    /**
+     * @brief Queue an absolute move on a screen of known size
+     * @details Converts screen coordinates to the normalized 0-65535 range
+     * @param input_queue The queue to add the event to
+     * @param x The x-coordinate in pixels
+     * @param y The y-coordinate in pixels
+     * @param screen Width and height of the screen in pixels
+     */
+    static void queue_absolute_move(std::vector<Event>& input_queue, int x, int y, std::pair<int, int> screen);
+    
+    /**
+     * @brief Queue the keyboard events that type a string
+     * @param input_queue The queue to add events to
+     * @param text The text to type
+     * @throws InputError If the text contains a null byte
+     */
+    static void queue_text(std::vector<Event>& input_queue, const std::string& text);
+    
     /**
      * @brief Get lists of currently held keys and scan codes
      * @return A tuple containing vectors of held keys and scan codes
      */
     std::tuple<std::vector<Key>, std::vector<ScanCode>> held();
     
+    /**
+     * @brief Receives held-state changes, in batches of one dispatch each
+     * @details Called on the thread that sent the input (or on the hold scheduler thread for
+     * timed releases) with the instance locked; it may use the instance but should not block
+     */
+    using HeldListener = std::function<void(const HeldChange* changes, size_t count)>;
+    
+    /**
+     * @brief Get the held-state version
+     * @details Increases by one with every press or release that changes the held set;
+     * a single atomic load, safe to poll from any thread
+     * @return uint64_t The version, 0 before anything was held
+     */
+    uint64_t held_version() const;
+    
+    /**
+     * @brief Bring a snapshot of the held inputs up to date
+     * @details Returns at once, without locking, if the view already has the current
+     * version. Otherwise the targets are copied into the view's storage, which does not
+     * allocate once it has grown to the size of the held set.
+     * @param view The snapshot to refresh
+     * @return bool True if the view changed
+     */
+    bool held(HeldView& view);
+    
+    /**
+     * @brief Register a listener for held-state changes
+     * @param listener The listener
+     * @return uint64_t Identifier to unsubscribe with
+     */
+    uint64_t subscribe_held(HeldListener listener);
+    
+    /**
+     * @brief Remove a listener; it is not called again once this returns
+     * @param id The identifier returned by subscribe_held()
+     */
+    void unsubscribe_held(uint64_t id);
+    
+    /**
+     * @brief Press a key and release it automatically after a duration
+     * @details Returns immediately; the release is emitted by the hold scheduler thread
+     * @param key The key to hold
+     * @param duration How long to keep the key down
+     */
+    void hold(Key key, HoldScheduler::Clock::duration duration);
+    
+    /**
+     * @brief Press a mouse button and release it automatically after a duration
+     * @details Returns immediately; the release is emitted by the hold scheduler thread
+     * @param button The button to hold
+     * @param duration How long to keep the button down
+     */
+    void hold(Button button, HoldScheduler::Clock::duration duration);
+    
+    /**
+     * @brief Press a key and release it automatically at a deadline
+     * @param key The key to hold
+     * @param deadline When to release the key
+     */
+    void press_until(Key key, HoldScheduler::Clock::time_point deadline);
+    
+    /**
+     * @brief Press a mouse button and release it automatically at a deadline
+     * @param button The button to hold
+     * @param deadline When to release the button
+     */
+    void press_until(Button button, HoldScheduler::Clock::time_point deadline);
+    
     /**
      * @brief Get the event marker value used to identify inputs from this library
      * @return The marker value (typically 0x12345678)
@@ -171,13 +398,9 @@ public:
 
 private:
     /**
-     * @brief Queue key events for later sending
-     * @details Adds the appropriate key events to the input queue based on direction
-     * @param input_queue The queue to add events to
-     * @param key The key to simulate
-     * @param direction Whether to press, release, or click the key
+     * @brief Held-state listeners with their identifiers
      */
-    void queue_key(std::vector<INPUT>& input_queue, Key key, Direction direction);
+    using HeldListenerTable = std::vector<std::pair<uint64_t, HeldListener>>;
     
     /**
      * @brief Queue character events for later sending
@@ -186,12 +409,125 @@ private:
      * @param character The character to simulate
      * @param buffer Buffer for UTF-16 encoding
      */
-    void queue_char(std::vector<INPUT>& input_queue, wchar_t character, std::array<uint16_t, 2>& buffer);
+    static void queue_char(std::vector<Event>& input_queue, wchar_t character, std::array<uint16_t, 2>& buffer);
+    
+    /**
+     * @brief Hand queued events to the backend
+     * @param events The events to deliver
+     * @param origin The call that built them, for the flight recorder
+     */
+    void dispatch(const std::vector<Event>& events, EventOrigin origin);
+    
+    /**
+     * @brief Hand events to the backend, recording them if the flight recorder or metrics are on
+     * @param events Pointer to the first event
+     * @param count Number of events
+     * @param origin The call that built them, for the flight recorder
+     */
+    void dispatch(const Event* events, size_t count, EventOrigin origin);
+    
+    /**
+     * @brief Update held state after pre-built events were dispatched
+     * @param events Pointer to the first event
+     * @param count Number of events
+     */
+    void track_events(const Event* events, size_t count);
+    
+    /**
+     * @brief Record that an input went down and schedule its release if needed
+     * @details A release is scheduled at the deadline (if any) or at the maximum hold
+     * duration from now (if configured), whichever comes first
+     * @param target The input that was pressed
+     * @param deadline Optional requested release time
+     */
+    void track_press(const HoldTarget& target, std::optional<HoldScheduler::Clock::time_point> deadline);
+    
+    /**
+     * @brief Forget any pending scheduled release for an input that went up
+     * @param target The input that was released
+     */
+    void track_release(const HoldTarget& target);
+    
+    /**
+     * @brief Record a change of the held set, if the input was not already in that state
+     * @param target The input that went down or up
+     * @param pressed Whether it went down
+     */
+    void note_held(const HoldTarget& target, bool pressed);
+    
+    /**
+     * @brief Hand the changes recorded since the last call to the listeners
+     */
+    void publish_held();
+    
+    /**
+     * @brief Release an input whose deadline expired, unless it changed in the meantime
+     * @details Called on the hold scheduler thread
+     * @param target The input to release
+     * @param ticket The ticket the deadline was scheduled with
+     */
+    void expire_hold(const HoldTarget& target, uint64_t ticket);
+    
+    /**
+     * @brief Release an input regardless of how it was pressed
+     * @param target The input to release
+     */
+    void release_target(const HoldTarget& target);
     
     // Currently held keys
     std::vector<Key> held_keys;
     std::vector<ScanCode> held_scancodes;
     
+    /**
+     * @brief Every held key, scan code and button, in press order
+     */
+    std::vector<HoldTarget> held_targets;
+    
+    /**
+     * @brief Changes not yet handed to the listeners
+     */
+    std::vector<HeldChange> held_changes;
+    
+    /**
+     * @brief Held-state version, bumped on every change of held_targets
+     */
+    std::atomic<uint64_t> held_state_version{0};
+    
+    /**
+     * @brief Held-state listeners with their identifiers, replaced as a whole on every change
+     */
+    std::shared_ptr<const HeldListenerTable> held_listeners;
+    
+    /**
+     * @brief Last identifier handed out by subscribe_held()
+     */
+    uint64_t last_listener_id = 0;
+    
+    /**
+     * @brief Serializes input dispatch between callers and the hold scheduler thread
+     */
+    std::recursive_mutex input_mutex;
+    
+    /**
+     * @brief Tickets of inputs with a scheduled release, keyed by HoldTarget::packed()
+     */
+    std::unordered_map<uint32_t, uint64_t> hold_tickets;
+    
+    /**
+     * @brief Last ticket handed out for a scheduled release
+     */
+    uint64_t last_hold_ticket = 0;
+    
+    /**
+     * @brief Scheduler emitting timed releases, created on first use
+     */
+    std::unique_ptr<HoldScheduler> hold_scheduler;
+    
+    /**
+     * @brief Destination of every dispatched event
+     */
+    std::shared_ptr<Backend> backend;
+    
     // Configuration
     /**
      * @brief Whether to automatically release held keys when object is destroyed
@@ -208,6 +544,11 @@ private:
      * @brief Whether mouse movements are subject to Windows acceleration
      */
     bool windows_subject_to_mouse_speed_and_acceleration_level;
+    
+    /**
+     * @brief Safety limit after which held inputs are released (zero disables it)
+     */
+    std::chrono::milliseconds max_hold_duration;
 };
 
 /**
@@ -217,6 +558,26 @@ private:
  */
 void send_input(const std::vector<INPUT>& input);
 
+/**
+ * @brief Expand compact events into INPUT structures
+ * @details The tight loop run at dispatch time; out must have room for count structures
+ * @param events Pointer to the first event
+ * @param count Number of events
+ * @param dw_extra_info Marker value to identify the event source
+ * @param out Destination array of INPUT structures
+ * @throws InputError If an event has an unknown kind or refers to an unknown mouse button
+ */
+void expand_events(const Event* events, size_t count, size_t dw_extra_info, INPUT* out);
+
+/**
+ * @brief Expand compact events and send them in a single SendInput call
+ * @param events Pointer to the first event
+ * @param count Number of events
+ * @param dw_extra_info Marker value to identify the event source
+ * @throws InputError If not all events were sent
+ */
+void send_events(const Event* events, size_t count, size_t dw_extra_info);
+
 /**
  * @brief Create a mouse input event structure
  * @details Configures all fields needed for hardware-level mouse simulation
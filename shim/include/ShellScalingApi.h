@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Windows.h"
+
+/**
+ * @file ShellScalingApi.h
+ * @author Eterninety
+ * @brief Minimal stand-in for the Windows DPI awareness header, for building off Windows
+ * @version 1.0
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+typedef enum PROCESS_DPI_AWARENESS {
+    PROCESS_DPI_UNAWARE = 0,
+    PROCESS_SYSTEM_DPI_AWARE = 1,
+    PROCESS_PER_MONITOR_DPI_AWARE = 2
+} PROCESS_DPI_AWARENESS;
+
+HRESULT SetProcessDpiAwareness(PROCESS_DPI_AWARENESS value);
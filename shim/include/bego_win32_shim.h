@@ -0,0 +1,110 @@
+#pragma once
+
+#include "Windows.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file bego_win32_shim.h
+ * @author Eterninety
+ * @brief Control and inspection of the in-memory Win32 shim used for off-Windows builds
+ * @version 1.0
+ *
+ * @details With BEGO_WIN32_SHIM enabled the library is compiled against shim/include
+ * instead of the Windows SDK, and the handful of Win32 functions it calls are
+ * implemented in memory:
+ *
+ * - SendInput applies every INPUT to a model of the desktop (cursor position, clamped
+ *   to the screen, and the up/down state of every virtual key and mouse button) and
+ *   returns the number of inputs, or 0 while sending is blocked.
+ * - MapVirtualKeyEx translates through a fixed US layout table, extended keys
+ *   carrying the 0xE0 prefix for the _EX translations.
+ * - GetSystemMetrics reports the model's screen size (1920x1080 unless changed),
+ *   GetCursorPos its cursor and GetAsyncKeyState its key state.
+ * - The foreground window, its thread and its keyboard layout are fixed values.
+ *
+ * Nothing depends on the machine or on timing, so a run is reproducible, and every
+ * call is counted, which shows how many system calls each library call makes.
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace bego::shim {
+
+/**
+ * @struct CallCounts
+ * @brief Number of calls made to each shimmed function since the last reset
+ */
+struct CallCounts {
+    uint64_t send_input = 0;            ///< SendInput calls
+    uint64_t inputs_sent = 0;           ///< INPUT structures accepted by SendInput
+    uint64_t map_virtual_key = 0;       ///< MapVirtualKeyEx calls
+    uint64_t get_system_metrics = 0;    ///< GetSystemMetrics calls
+    uint64_t get_cursor_pos = 0;        ///< GetCursorPos calls
+    uint64_t get_async_key_state = 0;   ///< GetAsyncKeyState calls
+    uint64_t get_foreground_window = 0; ///< GetForegroundWindow calls
+    uint64_t get_keyboard_layout = 0;   ///< GetKeyboardLayout calls
+    uint64_t set_dpi_awareness = 0;     ///< SetProcessDpiAwareness calls
+
+    /**
+     * @brief Get the difference between two snapshots
+     * @param earlier A snapshot taken before this one
+     * @return CallCounts The calls made in between
+     */
+    CallCounts operator-(const CallCounts& earlier) const;
+};
+
+/**
+ * @brief Get the call counters
+ * @return CallCounts A snapshot of every counter
+ */
+CallCounts counts();
+
+/**
+ * @brief Reset the counters, the desktop model and the input log to their initial state
+ */
+void reset();
+
+/**
+ * @brief Set the size of the simulated screen
+ * @param width Width in pixels (positive)
+ * @param height Height in pixels (positive)
+ */
+void set_screen(int width, int height);
+
+/**
+ * @brief Move the simulated cursor, as the user would
+ * @param x Horizontal position in pixels, clamped to the screen
+ * @param y Vertical position in pixels, clamped to the screen
+ */
+void set_cursor(int x, int y);
+
+/**
+ * @brief Make SendInput reject input, as UIPI does for elevated windows
+ * @param blocked While true, SendInput returns 0 and GetLastError reports ERROR_ACCESS_DENIED
+ */
+void set_blocked(bool blocked);
+
+/**
+ * @brief Keep a copy of every INPUT accepted by SendInput
+ * @param enabled Whether to log; off by default so long runs do not grow without bound
+ */
+void set_logging(bool enabled);
+
+/**
+ * @brief Get the logged inputs
+ * @return std::vector<INPUT> Every input accepted while logging was on, in order
+ */
+std::vector<INPUT> sent();
+
+/**
+ * @brief Check whether a virtual key or mouse button is down in the model
+ * @param vk The virtual key code (VK_LBUTTON etc. for buttons)
+ * @return bool True if it is held
+ */
+bool is_down(int vk);
+
+} // namespace bego::shim
@@ -0,0 +1,446 @@
+#include "include/bego_win32_shim.h"
+#include "include/ShellScalingApi.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+/**
+ * @file win32_shim.cpp
+ * @author Eterninety
+ * @brief In-memory implementation of the Win32 functions used by the library
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace {
+
+/**
+ * @brief Counters for every shimmed function, updated without locking
+ */
+struct Counters {
+    std::atomic<uint64_t> send_input{0};
+    std::atomic<uint64_t> inputs_sent{0};
+    std::atomic<uint64_t> map_virtual_key{0};
+    std::atomic<uint64_t> get_system_metrics{0};
+    std::atomic<uint64_t> get_cursor_pos{0};
+    std::atomic<uint64_t> get_async_key_state{0};
+    std::atomic<uint64_t> get_foreground_window{0};
+    std::atomic<uint64_t> get_keyboard_layout{0};
+    std::atomic<uint64_t> set_dpi_awareness{0};
+};
+
+/**
+ * @brief The simulated desktop
+ */
+struct Desktop {
+    int width = 1920;
+    int height = 1080;
+    int x = 0;
+    int y = 0;
+    std::array<bool, 256> down{};
+    bool blocked = false;
+    bool logging = false;
+    std::vector<INPUT> log;
+};
+
+Counters counters;
+std::mutex mutex;
+Desktop desktop;
+thread_local DWORD last_error = 0;
+
+void count(std::atomic<uint64_t>& counter, uint64_t amount = 1) {
+    counter.fetch_add(amount, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Scan codes of the US layout by virtual key; 0xE0 in the high byte marks extended keys
+ */
+struct Layout {
+    std::array<uint16_t, 256> scan{};
+    std::array<uint8_t, 0x200> vk{};    // Indexed by scan, +0x100 when extended; generic modifiers
+    std::array<uint8_t, 0x200> vk_ex{}; // Same, with left/right modifiers
+
+    Layout() {
+        static const char letters[] = "QWERTYUIOP";
+        for (int i = 0; letters[i]; i++) {
+            scan[static_cast<uint8_t>(letters[i])] = static_cast<uint16_t>(0x10 + i);
+        }
+        static const char middle[] = "ASDFGHJKL";
+        for (int i = 0; middle[i]; i++) {
+            scan[static_cast<uint8_t>(middle[i])] = static_cast<uint16_t>(0x1E + i);
+        }
+        static const char bottom[] = "ZXCVBNM";
+        for (int i = 0; bottom[i]; i++) {
+            scan[static_cast<uint8_t>(bottom[i])] = static_cast<uint16_t>(0x2C + i);
+        }
+        for (int i = 1; i <= 9; i++) {
+            scan['0' + i] = static_cast<uint16_t>(0x01 + i);
+        }
+        scan['0'] = 0x0B;
+        for (int i = 0; i < 10; i++) {
+            scan[VK_F1 + i] = static_cast<uint16_t>(0x3B + i);
+        }
+        scan[VK_F11] = 0x57;
+        scan[VK_F12] = 0x58;
+        for (int i = 0; i < 11; i++) {
+            scan[VK_F13 + i] = static_cast<uint16_t>(0x64 + i);
+        }
+        scan[VK_F24] = 0x76;
+
+        static const uint8_t numpad[] = {0x52, 0x4F, 0x50, 0x51, 0x4B, 0x4C, 0x4D, 0x47, 0x48, 0x49};
+        for (int i = 0; i < 10; i++) {
+            scan[VK_NUMPAD0 + i] = numpad[i];
+        }
+
+        static const std::pair<int, uint16_t> others[] = {
+            {VK_ESCAPE, 0x01}, {VK_BACK, 0x0E}, {VK_TAB, 0x0F}, {VK_RETURN, 0x1C}, {VK_SPACE, 0x39},
+            {VK_SHIFT, 0x2A}, {VK_LSHIFT, 0x2A}, {VK_RSHIFT, 0x36},
+            {VK_CONTROL, 0x1D}, {VK_LCONTROL, 0x1D}, {VK_RCONTROL, 0xE01D},
+            {VK_MENU, 0x38}, {VK_LMENU, 0x38}, {VK_RMENU, 0xE038},
+            {VK_PAUSE, 0x45}, {VK_CAPITAL, 0x3A}, {VK_NUMLOCK, 0xE045}, {VK_SCROLL, 0x46},
+            {VK_PRIOR, 0xE049}, {VK_NEXT, 0xE051}, {VK_END, 0xE04F}, {VK_HOME, 0xE047},
+            {VK_LEFT, 0xE04B}, {VK_UP, 0xE048}, {VK_RIGHT, 0xE04D}, {VK_DOWN, 0xE050},
+            {VK_SNAPSHOT, 0xE037}, {VK_INSERT, 0xE052}, {VK_DELETE, 0xE053},
+            {VK_LWIN, 0xE05B}, {VK_RWIN, 0xE05C}, {VK_APPS, 0xE05D},
+            {VK_MULTIPLY, 0x37}, {VK_ADD, 0x4E}, {VK_SUBTRACT, 0x4A}, {VK_DECIMAL, 0x53}, {VK_DIVIDE, 0xE035},
+            {VK_OEM_1, 0x27}, {VK_OEM_PLUS, 0x0D}, {VK_OEM_COMMA, 0x33}, {VK_OEM_MINUS, 0x0C},
+            {VK_OEM_PERIOD, 0x34}, {VK_OEM_2, 0x35}, {VK_OEM_3, 0x29}, {VK_OEM_4, 0x1A},
+            {VK_OEM_5, 0x2B}, {VK_OEM_6, 0x1B}, {VK_OEM_7, 0x28},
+        };
+        for (const auto& [key, code] : others) {
+            scan[key] = code;
+        }
+
+        // The lowest virtual key wins, so the generic modifiers come before left/right
+        for (int key = 255; key > 0; key--) {
+            if (scan[key] != 0) {
+                vk[index(scan[key])] = static_cast<uint8_t>(key);
+            }
+        }
+        vk_ex = vk;
+        vk_ex[index(0x2A)] = VK_LSHIFT;
+        vk_ex[index(0x36)] = VK_RSHIFT;
+        vk_ex[index(0x1D)] = VK_LCONTROL;
+        vk_ex[index(0x38)] = VK_LMENU;
+    }
+
+    static size_t index(uint16_t code) {
+        return (code & 0xFF) | ((code >> 8) == 0xE0 ? 0x100 : 0);
+    }
+};
+
+const Layout& layout() {
+    static const Layout instance;
+    return instance;
+}
+
+/**
+ * @brief Update a key in the model, keeping the generic modifiers in step with left/right
+ */
+void set_key(uint8_t vk, bool down) {
+    desktop.down[vk] = down;
+    auto pair = [&](uint8_t generic, uint8_t left, uint8_t right) {
+        if (vk == generic) {
+            desktop.down[left] = down;
+        } else if (vk == left || vk == right) {
+            desktop.down[generic] = desktop.down[left] || desktop.down[right];
+        }
+    };
+    pair(VK_SHIFT, VK_LSHIFT, VK_RSHIFT);
+    pair(VK_CONTROL, VK_LCONTROL, VK_RCONTROL);
+    pair(VK_MENU, VK_LMENU, VK_RMENU);
+}
+
+/**
+ * @brief Apply one input to the model; the lock is held
+ */
+void apply(const INPUT& input) {
+    if (input.type == INPUT_KEYBOARD) {
+        const KEYBDINPUT& ki = input.ki;
+        if (ki.dwFlags & KEYEVENTF_UNICODE) {
+            return;  // Characters do not change key state
+        }
+        uint8_t vk = static_cast<uint8_t>(ki.wVk);
+        if ((ki.dwFlags & KEYEVENTF_SCANCODE) || vk == 0) {
+            uint16_t code = static_cast<uint16_t>((ki.wScan & 0xFF) | ((ki.dwFlags & KEYEVENTF_EXTENDEDKEY) ? 0xE000 : 0));
+            vk = layout().vk_ex[Layout::index(code)];
+        }
+        if (vk != 0) {
+            set_key(vk, !(ki.dwFlags & KEYEVENTF_KEYUP));
+        }
+        return;
+    }
+    if (input.type != INPUT_MOUSE) {
+        return;
+    }
+
+    const MOUSEINPUT& mi = input.mi;
+    if (mi.dwFlags & MOUSEEVENTF_MOVE) {
+        if (mi.dwFlags & MOUSEEVENTF_ABSOLUTE) {
+            // Inverse of the library's rounding to 0-65535, so positions round-trip
+            desktop.x = static_cast<int>((static_cast<int64_t>(mi.dx) * (desktop.width - 1) + 32767) / 65535);
+            desktop.y = static_cast<int>((static_cast<int64_t>(mi.dy) * (desktop.height - 1) + 32767) / 65535);
+        } else {
+            // Pixel for pixel: pointer acceleration is not modelled
+            desktop.x += mi.dx;
+            desktop.y += mi.dy;
+        }
+        desktop.x = std::clamp(desktop.x, 0, desktop.width - 1);
+        desktop.y = std::clamp(desktop.y, 0, desktop.height - 1);
+    }
+
+    static const std::pair<DWORD, uint8_t> buttons[] = {
+        {MOUSEEVENTF_LEFTDOWN, VK_LBUTTON}, {MOUSEEVENTF_RIGHTDOWN, VK_RBUTTON}, {MOUSEEVENTF_MIDDLEDOWN, VK_MBUTTON}
+    };
+    for (const auto& [flag, vk] : buttons) {
+        if (mi.dwFlags & flag) {
+            desktop.down[vk] = true;
+        }
+        if (mi.dwFlags & (flag << 1)) {
+            desktop.down[vk] = false;
+        }
+    }
+    if (mi.dwFlags & (MOUSEEVENTF_XDOWN | MOUSEEVENTF_XUP)) {
+        const bool down = (mi.dwFlags & MOUSEEVENTF_XDOWN) != 0;
+        if (mi.mouseData & XBUTTON1) {
+            desktop.down[VK_XBUTTON1] = down;
+        }
+        if (mi.mouseData & XBUTTON2) {
+            desktop.down[VK_XBUTTON2] = down;
+        }
+    }
+}
+
+} // namespace
+
+namespace bego::shim {
+
+/**
+ * @brief Gets the difference between two snapshots
+ *
+ * @param earlier A snapshot taken before this one
+ * @return CallCounts The calls made in between
+ */
+CallCounts CallCounts::operator-(const CallCounts& earlier) const {
+    CallCounts result;
+    result.send_input = send_input - earlier.send_input;
+    result.inputs_sent = inputs_sent - earlier.inputs_sent;
+    result.map_virtual_key = map_virtual_key - earlier.map_virtual_key;
+    result.get_system_metrics = get_system_metrics - earlier.get_system_metrics;
+    result.get_cursor_pos = get_cursor_pos - earlier.get_cursor_pos;
+    result.get_async_key_state = get_async_key_state - earlier.get_async_key_state;
+    result.get_foreground_window = get_foreground_window - earlier.get_foreground_window;
+    result.get_keyboard_layout = get_keyboard_layout - earlier.get_keyboard_layout;
+    result.set_dpi_awareness = set_dpi_awareness - earlier.set_dpi_awareness;
+    return result;
+}
+
+/**
+ * @brief Gets the call counters
+ *
+ * @return CallCounts A snapshot of every counter
+ */
+CallCounts counts() {
+    CallCounts result;
+    result.send_input = counters.send_input.load(std::memory_order_relaxed);
+    result.inputs_sent = counters.inputs_sent.load(std::memory_order_relaxed);
+    result.map_virtual_key = counters.map_virtual_key.load(std::memory_order_relaxed);
+    result.get_system_metrics = counters.get_system_metrics.load(std::memory_order_relaxed);
+    result.get_cursor_pos = counters.get_cursor_pos.load(std::memory_order_relaxed);
+    result.get_async_key_state = counters.get_async_key_state.load(std::memory_order_relaxed);
+    result.get_foreground_window = counters.get_foreground_window.load(std::memory_order_relaxed);
+    result.get_keyboard_layout = counters.get_keyboard_layout.load(std::memory_order_relaxed);
+    result.set_dpi_awareness = counters.set_dpi_awareness.load(std::memory_order_relaxed);
+    return result;
+}
+
+/**
+ * @brief Resets the counters, the desktop model and the input log
+ */
+void reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    desktop = Desktop();
+    for (auto* counter : {&counters.send_input, &counters.inputs_sent, &counters.map_virtual_key,
+                          &counters.get_system_metrics, &counters.get_cursor_pos, &counters.get_async_key_state,
+                          &counters.get_foreground_window, &counters.get_keyboard_layout,
+                          &counters.set_dpi_awareness}) {
+        counter->store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Sets the size of the simulated screen
+ *
+ * @param width Width in pixels
+ * @param height Height in pixels
+ */
+void set_screen(int width, int height) {
+    std::lock_guard<std::mutex> lock(mutex);
+    desktop.width = std::max(width, 1);
+    desktop.height = std::max(height, 1);
+    desktop.x = std::min(desktop.x, desktop.width - 1);
+    desktop.y = std::min(desktop.y, desktop.height - 1);
+}
+
+/**
+ * @brief Moves the simulated cursor
+ *
+ * @param x Horizontal position in pixels
+ * @param y Vertical position in pixels
+ */
+void set_cursor(int x, int y) {
+    std::lock_guard<std::mutex> lock(mutex);
+    desktop.x = std::clamp(x, 0, desktop.width - 1);
+    desktop.y = std::clamp(y, 0, desktop.height - 1);
+}
+
+/**
+ * @brief Makes SendInput reject input or accept it again
+ *
+ * @param blocked Whether input is rejected
+ */
+void set_blocked(bool blocked) {
+    std::lock_guard<std::mutex> lock(mutex);
+    desktop.blocked = blocked;
+}
+
+/**
+ * @brief Turns the input log on or off
+ *
+ * @param enabled Whether to log
+ */
+void set_logging(bool enabled) {
+    std::lock_guard<std::mutex> lock(mutex);
+    desktop.logging = enabled;
+}
+
+/**
+ * @brief Gets the logged inputs
+ *
+ * @return std::vector<INPUT> Every input accepted while logging was on
+ */
+std::vector<INPUT> sent() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return desktop.log;
+}
+
+/**
+ * @brief Checks whether a virtual key or mouse button is down in the model
+ *
+ * @param vk The virtual key code
+ * @return bool True if it is held
+ */
+bool is_down(int vk) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return vk >= 0 && vk < 256 && desktop.down[vk];
+}
+
+} // namespace bego::shim
+
+UINT SendInput(UINT cInputs, LPINPUT pInputs, int cbSize) {
+    count(counters.send_input);
+    std::lock_guard<std::mutex> lock(mutex);
+    if (desktop.blocked || cbSize != static_cast<int>(sizeof(INPUT))) {
+        last_error = ERROR_ACCESS_DENIED;
+        return 0;
+    }
+    for (UINT i = 0; i < cInputs; i++) {
+        apply(pInputs[i]);
+    }
+    if (desktop.logging) {
+        desktop.log.insert(desktop.log.end(), pInputs, pInputs + cInputs);
+    }
+    count(counters.inputs_sent, cInputs);
+    return cInputs;
+}
+
+UINT MapVirtualKeyEx(UINT uCode, UINT uMapType, HKL /*dwhkl*/) {
+    count(counters.map_virtual_key);
+    const Layout& table = layout();
+    switch (uMapType) {
+        case MAPVK_VK_TO_VSC:
+            return uCode < 256 ? table.scan[uCode] & 0xFF : 0;
+        case MAPVK_VK_TO_VSC_EX:
+            return uCode < 256 ? table.scan[uCode] : 0;
+        case MAPVK_VSC_TO_VK:
+            return uCode < 256 ? table.vk[uCode] : 0;
+        case MAPVK_VSC_TO_VK_EX:
+            return (uCode >> 8) == 0 || (uCode >> 8) == 0xE0 ? table.vk_ex[Layout::index(static_cast<uint16_t>(uCode))]
+                                                              : 0;
+        case MAPVK_VK_TO_CHAR:
+            if ((uCode >= 'A' && uCode <= 'Z') || (uCode >= '0' && uCode <= '9') || uCode == VK_SPACE) {
+                return uCode;
+            }
+            return 0;
+        default:
+            return 0;
+    }
+}
+
+int GetSystemMetrics(int nIndex) {
+    count(counters.get_system_metrics);
+    std::lock_guard<std::mutex> lock(mutex);
+    switch (nIndex) {
+        case SM_CXSCREEN:
+            return desktop.width;
+        case SM_CYSCREEN:
+            return desktop.height;
+        default:
+            return 0;
+    }
+}
+
+BOOL GetCursorPos(POINT* lpPoint) {
+    count(counters.get_cursor_pos);
+    if (!lpPoint) {
+        return FALSE;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    lpPoint->x = desktop.x;
+    lpPoint->y = desktop.y;
+    return TRUE;
+}
+
+short GetAsyncKeyState(int vKey) {
+    count(counters.get_async_key_state);
+    std::lock_guard<std::mutex> lock(mutex);
+    return vKey >= 0 && vKey < 256 && desktop.down[vKey] ? static_cast<short>(0x8000) : 0;
+}
+
+HWND GetForegroundWindow() {
+    count(counters.get_foreground_window);
+    static int window;
+    return &window;
+}
+
+DWORD GetWindowThreadProcessId(HWND hWnd, DWORD* lpdwProcessId) {
+    if (lpdwProcessId) {
+        *lpdwProcessId = 1;
+    }
+    return hWnd ? 1 : 0;
+}
+
+HKL GetKeyboardLayout(DWORD /*idThread*/) {
+    count(counters.get_keyboard_layout);
+    return reinterpret_cast<HKL>(static_cast<uintptr_t>(0x04090409));  // en-US
+}
+
+DWORD GetLastError() {
+    return last_error;
+}
+
+DWORD GetTickCount() {
+    return static_cast<DWORD>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                  std::chrono::steady_clock::now().time_since_epoch())
+                                  .count());
+}
+
+HRESULT SetProcessDpiAwareness(PROCESS_DPI_AWARENESS /*value*/) {
+    count(counters.set_dpi_awareness);
+    return 0;
+}
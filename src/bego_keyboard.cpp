@@ -1,4 +1,5 @@
 #include "../include/bego_win.h"
+#include <algorithm>
 #include <array>
 #include <vector>
 #include <string>
@@ -51,8 +52,27 @@ void Bego::text(const std::string& text) {
         return; // Nothing to simulate
     }
     
-    std::vector<INPUT> input;
-    input.reserve(2 * text.size()); // Each char needs at least press and release
+    std::lock_guard<std::recursive_mutex> lock(input_mutex);
+    
+    std::vector<Event> input;
+    queue_text(input, text);
+    
+    // Send all the queued input events
+    dispatch(input, EventOrigin::Text);
+}
+
+/**
+ * @brief Queues the keyboard events that type a string
+ * 
+ * @details Newlines and carriage returns become Return clicks and tabs become
+ * Tab clicks; every other character goes through queue_char.
+ * 
+ * @param input_queue Vector to add the events to
+ * @param text The string of text to type
+ * @throws InputError If the text contains a null byte
+ */
+void Bego::queue_text(std::vector<Event>& input_queue, const std::string& text) {
+    input_queue.reserve(input_queue.size() + 2 * text.size()); // Each char needs at least press and release
     
     std::array<uint16_t, 2> buffer;
     
@@ -63,25 +83,22 @@ void Bego::text(const std::string& text) {
         // Handle special characters
         switch (c) {
             case '\n':
-                queue_key(input, Key::Return, Direction::Click);
+                queue_key(input_queue, Key::Return, Direction::Click);
                 break;
             case '\r':
                 // Carriage return is mapped to the Enter key in Windows
-                queue_key(input, Key::Return, Direction::Click);
+                queue_key(input_queue, Key::Return, Direction::Click);
                 break;
             case '\t':
-                queue_key(input, Key::Tab, Direction::Click);
+                queue_key(input_queue, Key::Tab, Direction::Click);
                 break;
             case '\0':
                 throw InputError(InputError::Type::InvalidInput, "The text contained a null byte");
             default:
-                queue_char(input, wc, buffer);
+                queue_char(input_queue, wc, buffer);
                 break;
         }
     }
-    
-    // Send all the queued input events
-    send_input(input);
 }
 
 /**
@@ -91,26 +108,29 @@ void Bego::text(const std::string& text) {
  * and direction. For presses and releases, it also maintains a list of held keys
  * so they can be properly released if needed.
  * 
- * The method uses the queue_key helper to generate the appropriate INPUT structures
- * and then sends them using the send_input function. This approach ensures that
+ * The method uses the queue_key helper to generate the appropriate events
+ * and then hands them to the backend. This approach ensures that
  * the key events are indistinguishable from real hardware key events.
  * 
  * @param key The key to simulate
  * @param direction Whether to press, release, or click (press+release) the key
  */
 void Bego::key(Key key, Direction direction) {
-    std::vector<INPUT> input;
+    std::lock_guard<std::recursive_mutex> lock(input_mutex);
+    
+    std::vector<Event> input;
     
     // Queue the key event(s)
     queue_key(input, key, direction);
     
     // Send the input events
-    send_input(input);
+    dispatch(input, EventOrigin::Key);
     
     // Update held keys
     switch (direction) {
         case Direction::Press:
             held_keys.push_back(key);
+            track_press({HoldTarget::Kind::Key, static_cast<uint16_t>(key)}, std::nullopt);
             break;
         case Direction::Release:
             // Remove the key from held keys
@@ -118,11 +138,14 @@ void Bego::key(Key key, Direction direction) {
                 std::remove(held_keys.begin(), held_keys.end(), key),
                 held_keys.end()
             );
+            track_release({HoldTarget::Kind::Key, static_cast<uint16_t>(key)});
             break;
         case Direction::Click:
             // No need to update held keys for click
             break;
     }
+    
+    publish_held();
 }
 
 /**
@@ -142,36 +165,19 @@ void Bego::key(Key key, Direction direction) {
  * @param direction Whether to press, release, or click (press+release) the key
  */
 void Bego::raw(uint16_t scan, Direction direction) {
-    std::vector<INPUT> input;
-    
-    // Translate scan code to virtual key
-    WORD vk = translate_key(scan, MAPVK_VSC_TO_VK_EX);
-    
-    // Set key flags
-    DWORD keyflags = KEYEVENTF_SCANCODE;
-    
-    // Check if it's an extended key
-    if (is_extended_key(static_cast<VIRTUAL_KEY>(vk))) {
-        keyflags |= KEYEVENTF_EXTENDEDKEY;
-    }
-    
-    // Add key down event if needed
-    if (direction == Direction::Click || direction == Direction::Press) {
-        input.push_back(create_keybd_event(keyflags, vk, scan, dw_extra_info));
-    }
+    std::lock_guard<std::recursive_mutex> lock(input_mutex);
     
-    // Add key up event if needed
-    if (direction == Direction::Click || direction == Direction::Release) {
-        input.push_back(create_keybd_event(keyflags | KEYEVENTF_KEYUP, vk, scan, dw_extra_info));
-    }
+    std::vector<Event> input;
+    queue_raw(input, scan, direction);
     
     // Send the input events
-    send_input(input);
+    dispatch(input, EventOrigin::Raw);
     
     // Update held scan codes
     switch (direction) {
         case Direction::Press:
             held_scancodes.push_back(scan);
+            track_press({HoldTarget::Kind::Raw, scan}, std::nullopt);
             break;
         case Direction::Release:
             // Remove the scan code from held scan codes
@@ -179,11 +185,47 @@ void Bego::raw(uint16_t scan, Direction direction) {
                 std::remove(held_scancodes.begin(), held_scancodes.end(), scan),
                 held_scancodes.end()
             );
+            track_release({HoldTarget::Kind::Raw, scan});
             break;
         case Direction::Click:
             // No need to update held scan codes for click
             break;
     }
+    
+    publish_held();
+}
+
+/**
+ * @brief Queues raw scan code events for later sending
+ * 
+ * @details The virtual key matching the scan code is looked up so that the
+ * events carry both, and the extended flag is set for keys that need it.
+ * 
+ * @param input_queue Vector to add the events to
+ * @param scan The hardware scan code to send
+ * @param direction Whether to press, release, or click (press+release) the key
+ */
+void Bego::queue_raw(std::vector<Event>& input_queue, uint16_t scan, Direction direction) {
+    // Translate scan code to virtual key
+    WORD vk = translate_key(scan, MAPVK_VSC_TO_VK_EX);
+    
+    // Set key flags
+    uint8_t keyflags = event_flags::Scancode;
+    
+    // Check if it's an extended key
+    if (is_extended_key(static_cast<VIRTUAL_KEY>(vk))) {
+        keyflags |= event_flags::Extended;
+    }
+    
+    // Add key down event if needed
+    if (direction == Direction::Click || direction == Direction::Press) {
+        input_queue.push_back(Event::key(false, vk, scan, keyflags));
+    }
+    
+    // Add key up event if needed
+    if (direction == Direction::Click || direction == Direction::Release) {
+        input_queue.push_back(Event::key(true, vk, scan, keyflags));
+    }
 }
 
 } // namespace bego 
\ No newline at end of file
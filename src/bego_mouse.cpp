@@ -1,4 +1,7 @@
 #include "../include/bego_win.h"
+#include "../include/bego_probes.h"
+#include <algorithm>
+#include <cstdint>
 #include <vector>
 
 /**
@@ -22,123 +25,129 @@ namespace bego {
  * mouse buttons (left, middle, right) as well as additional buttons (back, forward)
  * and scroll wheel actions.
  * 
- * For X buttons (Back/Forward), it properly sets the button_no parameter used
- * by the Windows API to distinguish between different extended buttons.
+ * The events are built by queue_button and sent in a single dispatch.
+ * 
+ * @param button The mouse button to simulate
+ * @param direction Whether to press, release, or click (press+release) the button
+ * @throws InputError If an invalid button type is specified
+ */
+void Bego::button(Button button, Direction direction) {
+    std::lock_guard<std::recursive_mutex> lock(input_mutex);
+    
+    std::vector<Event> input;
+    queue_button(input, button, direction);
+    dispatch(input, EventOrigin::Button);
+    
+    // Keep timed holds and the maximum hold limit in sync with the button state
+    if (input.empty() || input.front().kind == EventKind::Wheel || input.front().kind == EventKind::HWheel) {
+        return;
+    }
+    
+    HoldTarget target{HoldTarget::Kind::Button, static_cast<uint16_t>(button)};
+    switch (direction) {
+        case Direction::Press:
+            track_press(target, std::nullopt);
+            break;
+        case Direction::Release:
+            track_release(target);
+            break;
+        case Direction::Click:
+            break;
+    }
+    
+    publish_held();
+}
+
+/**
+ * @brief Queues mouse button events for later sending
+ * 
+ * @details Button events are queued in their compact form; the X button number
+ * used by the Windows API to tell Back and Forward apart is filled in when the
+ * backend expands them.
  * 
  * Scroll wheel buttons are translated into appropriate scroll events rather than
  * button events, matching how real hardware would behave.
  * 
+ * @param input_queue Vector to add the events to
  * @param button The mouse button to simulate
  * @param direction Whether to press, release, or click (press+release) the button
  * @throws InputError If an invalid button type is specified
  */
-void Bego::button(Button button, Direction direction) {
-    std::vector<INPUT> input;
-    
-    // Set button data for XBUTTON events
-    DWORD button_no = 0;
-    if (button == Button::Back) {
-        button_no = 1;
-    } else if (button == Button::Forward) {
-        button_no = 2;
+void Bego::queue_button(std::vector<Event>& input_queue, Button button, Direction direction) {
+    switch (button) {
+        case Button::Left:
+        case Button::Middle:
+        case Button::Right:
+        case Button::Back:
+        case Button::Forward:
+            break;
+        case Button::ScrollUp:
+        case Button::ScrollDown:
+        case Button::ScrollLeft:
+        case Button::ScrollRight:
+            // Scroll buttons only act on press and have no effect on release
+            if (direction == Direction::Release) {
+                return;
+            }
+            if (button == Button::ScrollUp || button == Button::ScrollDown) {
+                return queue_scroll(input_queue, button == Button::ScrollUp ? -1 : 1, Axis::Vertical);
+            }
+            return queue_scroll(input_queue, button == Button::ScrollLeft ? -1 : 1, Axis::Horizontal);
+        default:
+            throw InputError(InputError::Type::InvalidInput, "Invalid button type");
     }
     
-    // Handle button press
+    // Add button down event if needed
     if (direction == Direction::Click || direction == Direction::Press) {
-        DWORD mouse_event_flag;
-        
-        switch (button) {
-            case Button::Left:
-                mouse_event_flag = MOUSEEVENTF_LEFTDOWN;
-                break;
-            case Button::Middle:
-                mouse_event_flag = MOUSEEVENTF_MIDDLEDOWN;
-                break;
-            case Button::Right:
-                mouse_event_flag = MOUSEEVENTF_RIGHTDOWN;
-                break;
-            case Button::Back:
-            case Button::Forward:
-                mouse_event_flag = MOUSEEVENTF_XDOWN;
-                break;
-            case Button::ScrollUp:
-                return scroll(-1, Axis::Vertical);
-            case Button::ScrollDown:
-                return scroll(1, Axis::Vertical);
-            case Button::ScrollLeft:
-                return scroll(-1, Axis::Horizontal);
-            case Button::ScrollRight:
-                return scroll(1, Axis::Horizontal);
-            default:
-                throw InputError(InputError::Type::InvalidInput, "Invalid button type");
-        }
-        
-        input.push_back(create_mouse_event(mouse_event_flag, button_no, 0, 0, dw_extra_info));
+        input_queue.push_back(Event::button(false, button));
     }
     
-    // Handle button release
+    // Add button up event if needed
     if (direction == Direction::Click || direction == Direction::Release) {
-        DWORD mouse_event_flag;
-        
-        switch (button) {
-            case Button::Left:
-                mouse_event_flag = MOUSEEVENTF_LEFTUP;
-                break;
-            case Button::Middle:
-                mouse_event_flag = MOUSEEVENTF_MIDDLEUP;
-                break;
-            case Button::Right:
-                mouse_event_flag = MOUSEEVENTF_RIGHTUP;
-                break;
-            case Button::Back:
-            case Button::Forward:
-                mouse_event_flag = MOUSEEVENTF_XUP;
-                break;
-            case Button::ScrollUp:
-            case Button::ScrollDown:
-            case Button::ScrollLeft:
-            case Button::ScrollRight:
-                // Scroll buttons have no effect on release
-                return;
-            default:
-                throw InputError(InputError::Type::InvalidInput, "Invalid button type");
-        }
-        
-        input.push_back(create_mouse_event(mouse_event_flag, button_no, 0, 0, dw_extra_info));
+        input_queue.push_back(Event::button(true, button));
     }
-    
-    send_input(input);
 }
 
 /**
  * @brief Simulates mouse wheel scrolling
  * 
  * @details This method generates hardware-level mouse wheel events that match
- * the behavior of physical scroll wheels. It supports both vertical (standard)
- * and horizontal scrolling, properly setting the appropriate Windows API flags.
+ * the behavior of physical scroll wheels. The event is built by queue_scroll.
+ * 
+ * @param length The amount to scroll (positive or negative)
+ * @param axis Whether to scroll horizontally or vertically
+ */
+void Bego::scroll(int length, Axis axis) {
+    std::lock_guard<std::recursive_mutex> lock(input_mutex);
+    
+    std::vector<Event> input;
+    queue_scroll(input, length, axis);
+    dispatch(input, EventOrigin::Scroll);
+}
+
+/**
+ * @brief Queues a mouse wheel event for later sending
  * 
+ * @details Supports both vertical (standard) and horizontal scrolling.
  * The method uses the standard WHEEL_DELTA constant defined by Windows to ensure
  * that the scroll amount matches what physical hardware would produce. For vertical
  * scrolling, the value is inverted to match the expected direction in Windows.
  * 
+ * @param input_queue Vector to add the event to
  * @param length The amount to scroll (positive or negative)
  * @param axis Whether to scroll horizontally or vertically
  */
-void Bego::scroll(int length, Axis axis) {
+void Bego::queue_scroll(std::vector<Event>& input_queue, int length, Axis axis) {
     // Using the Windows-defined WHEEL_DELTA constant
-    DWORD flags;
     int data;
     
     if (axis == Axis::Horizontal) {
-        flags = MOUSEEVENTF_HWHEEL;
         data = length * WHEEL_DELTA;
     } else {
-        flags = MOUSEEVENTF_WHEEL;
         data = -length * WHEEL_DELTA; // Invert for vertical
     }
     
-    INPUT input = create_mouse_event(flags, data, 0, 0, dw_extra_info);
-    send_input({input});
+    input_queue.push_back(Event::wheel(axis, data));
 }
 
 /**
@@ -147,62 +156,125 @@ void Bego::scroll(int length, Axis axis) {
  * @details This method generates hardware-level mouse movement events that
  * are indistinguishable from real mouse hardware. It supports both absolute
  * positioning (moving to specific screen coordinates) and relative movement.
+ * The events are built by queue_move.
  * 
- * For absolute positioning, the method converts screen coordinates to the
+ * @param x The x-coordinate or x-distance to move
+ * @param y The y-coordinate or y-distance to move
+ * @param coordinate Whether the coordinates are absolute or relative
+ */
+void Bego::move_mouse(int x, int y, Coordinate coordinate) {
+    std::lock_guard<std::recursive_mutex> lock(input_mutex);
+    BEGO_PROBE3(move_mouse, x, y, static_cast<int>(coordinate));
+    
+    std::vector<Event> input;
+    queue_move(input, x, y, coordinate);
+    dispatch(input, EventOrigin::Move);
+}
+
+/**
+ * @brief Queues mouse movement events for later sending
+ * 
+ * @details For absolute positioning, the method converts screen coordinates to the
  * normalized 0-65535 range required by the Windows API. This ensures proper
  * positioning across different screen resolutions and DPI settings.
  * 
  * For relative movement, the method can either respect the system's mouse
  * acceleration settings or bypass them for more predictable movement, based
- * on the configuration.
+ * on the configuration. When bypassing them, the move is turned into an absolute
+ * one from the cursor position at the time of queueing, so earlier moves in the
+ * same batch are not taken into account; the overload tracking a cursor does that.
  * 
+ * @param input_queue Vector to add the events to
  * @param x The x-coordinate or x-distance to move
  * @param y The y-coordinate or y-distance to move
  * @param coordinate Whether the coordinates are absolute or relative
  */
-void Bego::move_mouse(int x, int y, Coordinate coordinate) {
-    DWORD flags;
-    int dx, dy;
-    
+void Bego::queue_move(std::vector<Event>& input_queue, int x, int y, Coordinate coordinate) {
     if (coordinate == Coordinate::Abs) {
-        // For absolute coordinates, we need to convert to the range 0-65535
-        auto [screen_width, screen_height] = main_display();
-        
-        // Subtract 1 from dimensions as per Microsoft documentation
-        int w = screen_width - 1;
-        int h = screen_height - 1;
-        
-        // Scale coordinates to 0-65535 range
-        dx = (x * 65535 + w / 2 * (x >= 0 ? 1 : -1)) / w;
-        dy = (y * 65535 + h / 2 * (y >= 0 ? 1 : -1)) / h;
-        
-        flags = MOUSEEVENTF_MOVE | MOUSEEVENTF_ABSOLUTE;
+        queue_absolute_move(input_queue, x, y, main_display());
     } else if (windows_subject_to_mouse_speed_and_acceleration_level) {
-        // For relative movement with acceleration
-        dx = x;
-        dy = y;
-        flags = MOUSEEVENTF_MOVE;
+        // For relative movement with acceleration, split distances that do not
+        // fit the compact event into several moves
+        do {
+            int dx = std::clamp(x, -32768, 32767);
+            int dy = std::clamp(y, -32768, 32767);
+            input_queue.push_back(Event::move(false, dx, dy));
+            x -= dx;
+            y -= dy;
+        } while (x != 0 || y != 0);
     } else {
         // For relative movement without acceleration, calculate absolute position
         auto [current_x, current_y] = location();
-        return move_mouse(current_x + x, current_y + y, Coordinate::Abs);
+        queue_move(input_queue, current_x + x, current_y + y, Coordinate::Abs);
     }
-    
-    INPUT input = create_mouse_event(flags, 0, dx, dy, dw_extra_info);
-    send_input({input});
+}
+
+/**
+ * @brief Queues mouse movement events from a cursor position tracked by the caller
+ *
+ * @details The target is clamped to the main display, as the system clamps the
+ * cursor, so a later relative move starts where the cursor really is.
+ *
+ * @param input_queue Vector to add the events to
+ * @param x The x-coordinate or x-distance to move
+ * @param y The y-coordinate or y-distance to move
+ * @param coordinate Whether the coordinates are absolute or relative
+ * @param cursor Cursor position after the queued events, or empty to ask location()
+ */
+void Bego::queue_move(std::vector<Event>& input_queue, int x, int y, Coordinate coordinate,
+                      std::optional<std::pair<int, int>>& cursor) {
+    if (coordinate == Coordinate::Rel && windows_subject_to_mouse_speed_and_acceleration_level) {
+        // Accelerated moves end wherever the system puts them
+        queue_move(input_queue, x, y, coordinate);
+        cursor.reset();
+        return;
+    }
+
+    if (coordinate == Coordinate::Rel) {
+        auto [current_x, current_y] = cursor ? *cursor : location();
+        x = static_cast<int>(std::clamp<int64_t>(int64_t(current_x) + x, INT32_MIN, INT32_MAX));
+        y = static_cast<int>(std::clamp<int64_t>(int64_t(current_y) + y, INT32_MIN, INT32_MAX));
+    }
+    auto screen = main_display();
+    x = std::clamp(x, 0, std::max(screen.first - 1, 0));
+    y = std::clamp(y, 0, std::max(screen.second - 1, 0));
+
+    queue_absolute_move(input_queue, x, y, screen);
+    cursor = std::make_pair(x, y);
+}
+
+/**
+ * @brief Queues an absolute move on a screen of known size
+ * 
+ * @details Screen coordinates are converted to the normalized 0-65535 range
+ * required by the Windows API, rounding to the nearest step so that every pixel
+ * maps back onto itself.
+ * 
+ * @param input_queue Vector to add the event to
+ * @param x The x-coordinate in pixels
+ * @param y The y-coordinate in pixels
+ * @param screen Width and height of the screen in pixels
+ */
+void Bego::queue_absolute_move(std::vector<Event>& input_queue, int x, int y, std::pair<int, int> screen) {
+    input_queue.push_back(
+        Event::move(true, normalize_coordinate(x, screen.first), normalize_coordinate(y, screen.second)));
 }
 
 /**
  * @brief Gets the dimensions of the main display
  * 
  * @details This method retrieves the width and height of the primary display
- * using the Windows API. This information is used for various calculations,
- * particularly for absolute mouse positioning.
+ * using the Windows API, unless the backend simulates its own screen. This
+ * information is used for various calculations, particularly for absolute mouse positioning.
  * 
  * @return A pair containing the width and height of the main display
  * @throws InputError If the screen dimensions could not be retrieved
  */
 std::pair<int, int> Bego::main_display() {
+    if (auto size = backend->screen_size()) {
+        return *size;
+    }
+
     int width = GetSystemMetrics(SM_CXSCREEN);
     int height = GetSystemMetrics(SM_CYSCREEN);
     
@@ -217,12 +289,17 @@ std::pair<int, int> Bego::main_display() {
  * @brief Gets the current mouse cursor position
  * 
  * @details This method retrieves the current position of the mouse cursor
- * in screen coordinates using the Windows API.
+ * in screen coordinates using the Windows API, unless the backend simulates
+ * its own cursor.
  * 
  * @return A pair containing the current x and y coordinates of the cursor
  * @throws InputError If the cursor position could not be retrieved
  */
 std::pair<int, int> Bego::location() {
+    if (auto position = backend->cursor_position()) {
+        return *position;
+    }
+
     POINT point;
     
     if (!GetCursorPos(&point)) {
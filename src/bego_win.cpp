@@ -1,4 +1,8 @@
 #include "../include/bego_win.h"
+#include "../include/bego_log.h"
+#include "../include/bego_metrics.h"
+#include "../include/bego_probes.h"
+#include <algorithm>
 #include <array>
 #include <stdexcept>
 
@@ -26,12 +30,33 @@ namespace bego {
  * @param settings Configuration settings for input simulation
  */
 Bego::Bego(const Settings& settings)
+    : Bego(settings, std::make_shared<Win32Backend>(
+          settings.windows_dw_extra_info ? settings.windows_dw_extra_info : EVENT_MARKER)) {
+}
+
+/**
+ * @brief Constructor for the Bego class with a custom backend
+ * 
+ * @details Every event generated by this instance is handed to the given
+ * backend instead of being sent with SendInput directly. The marker value from
+ * the settings is still reported by get_marker_value(), but writing it into the
+ * delivered events is up to the backend.
+ * 
+ * @param settings Configuration settings for input simulation
+ * @param backend The backend receiving every dispatched event
+ */
+Bego::Bego(const Settings& settings, std::shared_ptr<Backend> backend)
     : held_keys(),
       held_scancodes(),
+      backend(std::move(backend)),
       release_keys_when_dropped(settings.release_keys_when_dropped),
       dw_extra_info(settings.windows_dw_extra_info ? settings.windows_dw_extra_info : EVENT_MARKER),
       windows_subject_to_mouse_speed_and_acceleration_level(
-          settings.windows_subject_to_mouse_speed_and_acceleration_level) {
+          settings.windows_subject_to_mouse_speed_and_acceleration_level),
+      max_hold_duration(settings.max_hold_duration) {
+    if (!this->backend) {
+        throw NewConError("A backend is required");
+    }
 }
 
 /**
@@ -41,27 +66,49 @@ Bego::Bego(const Settings& settings)
  * automatically releases any keys or scan codes that are still being held.
  * This helps prevent keys from being "stuck" if the program exits
  * unexpectedly while keys are being held down.
+ * 
+ * The hold scheduler is stopped first so that no timed release races with
+ * the cleanup; buttons that were still waiting for a timed release are
+ * released here as well.
  */
 Bego::~Bego() {
+    hold_scheduler.reset();
+    
     if (!release_keys_when_dropped) {
         return;
     }
     
+    // Work on copies, releasing a key removes it from the held lists
+    auto [keys, scancodes] = held();
+    
     // Release all held keys
-    for (const auto& key : held_keys) {
+    for (const auto& key : keys) {
         try {
             this->key(key, Direction::Release);
         } catch (const std::exception&) {
-            // Just log or ignore the error
+            BEGO_LOG(Warning, "Releasing key {} on destruction failed", key);
         }
     }
     
     // Release all held scan codes
-    for (const auto& scan : held_scancodes) {
+    for (const auto& scan : scancodes) {
         try {
             this->raw(scan, Direction::Release);
         } catch (const std::exception&) {
-            // Just log or ignore the error
+            BEGO_LOG(Warning, "Releasing scan code {} on destruction failed", scan);
+        }
+    }
+    
+    // Release buttons that were waiting for a timed release
+    for (const auto& [packed, ticket] : std::unordered_map<uint32_t, uint64_t>(hold_tickets)) {
+        HoldTarget target{static_cast<HoldTarget::Kind>(packed >> 16), static_cast<uint16_t>(packed & 0xFFFF)};
+        if (target.kind != HoldTarget::Kind::Button) {
+            continue;
+        }
+        try {
+            release_target(target);
+        } catch (const std::exception&) {
+            BEGO_LOG(Warning, "Releasing button {} on destruction failed", target.code);
         }
     }
 }
@@ -96,6 +143,7 @@ uint16_t Bego::translate_key(uint16_t input, UINT map_type) {
     
     // Call MapVirtualKeyEx using the provided map_type and input
     UINT result = MapVirtualKeyEx(input, map_type, layout);
+    BEGO_PROBE3(translate_key, input, map_type, result);
     if (result == 0) {
         // Warning: This usually means there was no mapping
     }
@@ -144,19 +192,19 @@ bool Bego::is_extended_key(VIRTUAL_KEY vk) {
 /**
  * @brief Queues key events for later sending
  * 
- * @details Prepares INPUT structures for a key event based on the provided
+ * @details Prepares compact events for a key event based on the provided
  * key and direction. This helper method handles the conversion from Key enum
  * to virtual key code and scan code, as well as setting appropriate flags
  * for extended keys.
  * 
- * The method adds the INPUT structures to the provided input_queue vector
- * rather than sending them immediately, allowing for batching multiple inputs.
+ * The method adds the events to the provided input_queue vector rather than
+ * sending them immediately, allowing for batching multiple inputs.
  * 
- * @param input_queue Vector to add the INPUT structures to
+ * @param input_queue Vector to add the events to
  * @param key The key to simulate
  * @param direction Whether to press, release, or click the key
  */
-void Bego::queue_key(std::vector<INPUT>& input_queue, Key key, Direction direction) {
+void Bego::queue_key(std::vector<Event>& input_queue, Key key, Direction direction) {
     // Convert Key enum to virtual key code
     WORD vk;
     
@@ -172,39 +220,41 @@ void Bego::queue_key(std::vector<INPUT>& input_queue, Key key, Direction directi
     WORD scan = translate_key(vk, MAPVK_VK_TO_VSC_EX);
     
     // Set key flags
-    DWORD keyflags = 0;
+    uint8_t keyflags = 0;
     
     if (is_extended_key(static_cast<VIRTUAL_KEY>(vk))) {
-        keyflags |= KEYEVENTF_EXTENDEDKEY;
+        keyflags |= event_flags::Extended;
     }
     
     // Add key down event if needed
     if (direction == Direction::Click || direction == Direction::Press) {
-        input_queue.push_back(create_keybd_event(keyflags, vk, scan, dw_extra_info));
+        input_queue.push_back(Event::key(false, vk, scan, keyflags));
     }
     
     // Add key up event if needed
     if (direction == Direction::Click || direction == Direction::Release) {
-        input_queue.push_back(create_keybd_event(keyflags | KEYEVENTF_KEYUP, vk, scan, dw_extra_info));
+        input_queue.push_back(Event::key(true, vk, scan, keyflags));
     }
+    
+    BEGO_PROBE4(queue_key, static_cast<int>(key), vk, scan, static_cast<int>(direction));
 }
 
 /**
  * @brief Queues character events for later sending
  * 
- * @details Prepares INPUT structures for typing a Unicode character.
+ * @details Prepares compact events for typing a Unicode character.
  * This method handles the conversion of characters to UTF-16 code units,
  * including proper handling of surrogate pairs for characters outside the
  * Basic Multilingual Plane (BMP).
  * 
- * The method uses the KEYEVENTF_UNICODE flag to indicate that the input
- * is a Unicode character rather than a virtual key code.
+ * The events carry the Unicode flag (KEYEVENTF_UNICODE once expanded) to
+ * indicate that the input is a Unicode character rather than a virtual key code.
  * 
- * @param input_queue Vector to add the INPUT structures to
+ * @param input_queue Vector to add the events to
  * @param character The Unicode character to type
  * @param buffer Buffer for UTF-16 encoding
  */
-void Bego::queue_char(std::vector<INPUT>& input_queue, wchar_t character, std::array<uint16_t, 2>& buffer) {
+void Bego::queue_char(std::vector<Event>& input_queue, wchar_t character, std::array<uint16_t, 2>& buffer) {
     // Encode the character in UTF-16
     wchar_t utf16[2] = { character, 0 };
     uint16_t utf16_high = static_cast<uint16_t>(utf16[0]);
@@ -218,15 +268,151 @@ void Bego::queue_char(std::vector<INPUT>& input_queue, wchar_t character, std::a
     }
     
     // Add key down event
-    input_queue.push_back(create_keybd_event(KEYEVENTF_UNICODE, 0, utf16_high, dw_extra_info));
+    input_queue.push_back(Event::key(false, 0, utf16_high, event_flags::Unicode));
     
     // Add key up event
-    input_queue.push_back(create_keybd_event(KEYEVENTF_UNICODE | KEYEVENTF_KEYUP, 0, utf16_high, dw_extra_info));
+    input_queue.push_back(Event::key(true, 0, utf16_high, event_flags::Unicode));
     
     // If we have a surrogate pair, send the low surrogate too
     if (utf16_low != 0) {
-        input_queue.push_back(create_keybd_event(KEYEVENTF_UNICODE, 0, utf16_low, dw_extra_info));
-        input_queue.push_back(create_keybd_event(KEYEVENTF_UNICODE | KEYEVENTF_KEYUP, 0, utf16_low, dw_extra_info));
+        input_queue.push_back(Event::key(false, 0, utf16_low, event_flags::Unicode));
+        input_queue.push_back(Event::key(true, 0, utf16_low, event_flags::Unicode));
+    }
+    
+    BEGO_PROBE3(queue_char, static_cast<uint32_t>(character), utf16_high, utf16_low);
+}
+
+/**
+ * @brief Hands queued events to the backend
+ * 
+ * @details Events stay in their compact form up to this point; the backend
+ * expands them into its native structures as it delivers them.
+ * 
+ * @param events The events to deliver
+ * @param origin The call that built them
+ */
+void Bego::dispatch(const std::vector<Event>& events, EventOrigin origin) {
+    if (events.empty()) {
+        return;
+    }
+    
+    dispatch(events.data(), events.size(), origin);
+}
+
+/**
+ * @brief Hands events to the backend, recording metrics if they are enabled
+ * 
+ * @details The events go into the flight recorder first, if it is running, so
+ * that a dump taken after a crash in the backend still shows them. With metrics
+ * off this is one relaxed load more than the backend call. With metrics on, the
+ * backend call is timed and the batch is recorded whether or not it succeeded.
+ * 
+ * @param events Pointer to the first event
+ * @param count Number of events
+ * @param origin The call that built them
+ */
+void Bego::dispatch(const Event* events, size_t count, EventOrigin origin) {
+    if (FlightRecorder* recorder = FlightRecorder::active()) {
+        recorder->record(events, count, origin);
+    }
+    
+    BEGO_LOG(Debug, "dispatch: {} event(s) from origin {}, first kind {}", count, origin, events[0].kind);
+    
+    if (!metrics::enabled()) {
+        backend->dispatch(events, count);
+        return;
+    }
+    
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    auto elapsed = [&start] {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+    };
+    
+    try {
+        backend->dispatch(events, count);
+    } catch (...) {
+        metrics::record_dispatch(events, count, elapsed(), false);
+        throw;
+    }
+    metrics::record_dispatch(events, count, elapsed(), true);
+}
+
+/**
+ * @brief Sends pre-built events in a single dispatch
+ * 
+ * @details Used by replays and other producers that already hold compact
+ * events. The whole batch goes to the backend in one call, then the held state
+ * is brought up to date from the keyboard and button events it contained.
+ * 
+ * @param events Pointer to the first event
+ * @param count Number of events
+ */
+void Bego::send(const Event* events, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    
+    std::lock_guard<std::recursive_mutex> lock(input_mutex);
+    
+    dispatch(events, count, EventOrigin::Send);
+    track_events(events, count);
+    publish_held();
+}
+
+/**
+ * @brief Updates held state after pre-built events were dispatched
+ * 
+ * @details Scan code events update the held scan codes, virtual key events the
+ * held keys (keys the Key enum cannot name are not tracked) and button events
+ * the timed hold bookkeeping. Unicode events never count as held.
+ * 
+ * @param events Pointer to the first event
+ * @param count Number of events
+ */
+void Bego::track_events(const Event* events, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const Event& event = events[i];
+        bool down = event.kind == EventKind::KeyDown || event.kind == EventKind::ButtonDown;
+        HoldTarget target;
+        
+        if (event.kind == EventKind::KeyDown || event.kind == EventKind::KeyUp) {
+            if (event.flags & event_flags::Unicode) {
+                continue;
+            }
+            
+            if (event.flags & event_flags::Scancode) {
+                ScanCode scan = static_cast<ScanCode>(event.payload);
+                held_scancodes.erase(std::remove(held_scancodes.begin(), held_scancodes.end(), scan),
+                                     held_scancodes.end());
+                if (down) {
+                    held_scancodes.push_back(scan);
+                }
+                target = {HoldTarget::Kind::Raw, scan};
+            } else {
+                Key key;
+                try {
+                    key = vk_to_key(event.code);
+                } catch (const InputError&) {
+                    continue;
+                }
+                held_keys.erase(std::remove(held_keys.begin(), held_keys.end(), key), held_keys.end());
+                if (down) {
+                    held_keys.push_back(key);
+                }
+                target = {HoldTarget::Kind::Key, static_cast<uint16_t>(key)};
+            }
+        } else if (event.kind == EventKind::ButtonDown || event.kind == EventKind::ButtonUp) {
+            target = {HoldTarget::Kind::Button, event.code};
+        } else {
+            continue;
+        }
+        
+        if (down) {
+            track_press(target, std::nullopt);
+        } else {
+            track_release(target);
+        }
     }
 }
 
@@ -240,9 +426,301 @@ void Bego::queue_char(std::vector<INPUT>& input_queue, wchar_t character, std::a
  * @return A tuple containing vectors of held keys and scan codes
  */
 std::tuple<std::vector<Key>, std::vector<ScanCode>> Bego::held() {
+    std::lock_guard<std::recursive_mutex> lock(input_mutex);
     return std::make_tuple(held_keys, held_scancodes);
 }
 
+/**
+ * @brief Gets the held-state version
+ * 
+ * @return uint64_t The version, 0 before anything was held
+ */
+uint64_t Bego::held_version() const {
+    return held_state_version.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Brings a snapshot of the held inputs up to date
+ * 
+ * @details Watchers keep one view and call this as often as they like: while
+ * nothing changes, the call is a single atomic load and takes no lock. When the
+ * version moved, the targets are copied into the view's existing storage under
+ * the input lock, so the copy and its version always match.
+ * 
+ * @param view The snapshot to refresh
+ * @return bool True if the view changed
+ */
+bool Bego::held(HeldView& view) {
+    if (held_state_version.load(std::memory_order_acquire) == view.version) {
+        return false;
+    }
+    
+    std::lock_guard<std::recursive_mutex> lock(input_mutex);
+    view.targets.assign(held_targets.begin(), held_targets.end());
+    view.version = held_state_version.load(std::memory_order_relaxed);
+    return true;
+}
+
+/**
+ * @brief Registers a listener for held-state changes
+ * 
+ * @details The listener table is copied and replaced as a whole, so listeners
+ * that are being called keep a consistent table even if one of them
+ * subscribes or unsubscribes.
+ * 
+ * @param listener The listener
+ * @return uint64_t Identifier to unsubscribe with
+ */
+uint64_t Bego::subscribe_held(HeldListener listener) {
+    std::lock_guard<std::recursive_mutex> lock(input_mutex);
+    
+    auto listeners = held_listeners ? std::make_shared<HeldListenerTable>(*held_listeners)
+                                    : std::make_shared<HeldListenerTable>();
+    uint64_t id = ++last_listener_id;
+    listeners->emplace_back(id, std::move(listener));
+    held_listeners = std::move(listeners);
+    return id;
+}
+
+/**
+ * @brief Removes a held-state listener
+ * 
+ * @param id The identifier returned by subscribe_held()
+ */
+void Bego::unsubscribe_held(uint64_t id) {
+    std::lock_guard<std::recursive_mutex> lock(input_mutex);
+    
+    if (!held_listeners) {
+        return;
+    }
+    
+    auto listeners = std::make_shared<HeldListenerTable>();
+    for (const auto& entry : *held_listeners) {
+        if (entry.first != id) {
+            listeners->push_back(entry);
+        }
+    }
+    held_listeners = listeners->empty() ? nullptr : std::move(listeners);
+}
+
+/**
+ * @brief Records a change of the held set
+ * 
+ * @details Pressing something already held or releasing something that is not
+ * held is not a change; this filters the repeated presses of key repeat and the
+ * second bookkeeping pass of press_until.
+ * 
+ * @param target The input that went down or up
+ * @param pressed Whether it went down
+ */
+void Bego::note_held(const HoldTarget& target, bool pressed) {
+    auto it = std::find(held_targets.begin(), held_targets.end(), target);
+    if (pressed == (it != held_targets.end())) {
+        return;
+    }
+    
+    if (pressed) {
+        held_targets.push_back(target);
+    } else {
+        held_targets.erase(it);
+    }
+    
+    uint64_t version = held_state_version.load(std::memory_order_relaxed) + 1;
+    held_state_version.store(version, std::memory_order_release);
+    
+    if (held_listeners) {
+        held_changes.push_back({target, pressed, version});
+    }
+}
+
+/**
+ * @brief Hands the recorded changes to the listeners
+ * 
+ * @details Called once at the end of every dispatching call, so a listener sees
+ * the changes of one batch together. The pending buffer is swapped out first:
+ * a listener that sends input itself starts a batch of its own instead of
+ * growing the one being delivered.
+ */
+void Bego::publish_held() {
+    if (held_changes.empty()) {
+        return;
+    }
+    
+    std::vector<HeldChange> batch;
+    batch.swap(held_changes);
+    
+    // Keep the table alive even if a listener replaces it
+    auto listeners = held_listeners;
+    if (listeners) {
+        for (const auto& entry : *listeners) {
+            entry.second(batch.data(), batch.size());
+        }
+    }
+    
+    // Give the buffer back so that the next batch does not allocate
+    batch.clear();
+    if (held_changes.empty()) {
+        held_changes.swap(batch);
+    }
+}
+
+/**
+ * @brief Presses a key and releases it automatically after a duration
+ * 
+ * @details The key is pressed immediately and the release deadline is handed to
+ * the hold scheduler, so the calling thread does not sleep and no thread is
+ * dedicated to the hold.
+ * 
+ * @param key The key to hold
+ * @param duration How long to keep the key down
+ */
+void Bego::hold(Key key, HoldScheduler::Clock::duration duration) {
+    press_until(key, HoldScheduler::Clock::now() + duration);
+}
+
+/**
+ * @brief Presses a mouse button and releases it automatically after a duration
+ * 
+ * @param button The button to hold
+ * @param duration How long to keep the button down
+ */
+void Bego::hold(Button button, HoldScheduler::Clock::duration duration) {
+    press_until(button, HoldScheduler::Clock::now() + duration);
+}
+
+/**
+ * @brief Presses a key and releases it automatically at a deadline
+ * 
+ * @details Pressing or releasing the key manually before the deadline cancels
+ * the scheduled release.
+ * 
+ * @param key The key to hold
+ * @param deadline When to release the key
+ */
+void Bego::press_until(Key key, HoldScheduler::Clock::time_point deadline) {
+    std::lock_guard<std::recursive_mutex> lock(input_mutex);
+    
+    this->key(key, Direction::Press);
+    track_press({HoldTarget::Kind::Key, static_cast<uint16_t>(key)}, deadline);
+}
+
+/**
+ * @brief Presses a mouse button and releases it automatically at a deadline
+ * 
+ * @param button The button to hold
+ * @param deadline When to release the button
+ * @throws InputError If the button cannot be held (scroll buttons)
+ */
+void Bego::press_until(Button button, HoldScheduler::Clock::time_point deadline) {
+    std::lock_guard<std::recursive_mutex> lock(input_mutex);
+    
+    switch (button) {
+        case Button::ScrollUp:
+        case Button::ScrollDown:
+        case Button::ScrollLeft:
+        case Button::ScrollRight:
+            throw InputError(InputError::Type::InvalidInput, "Scroll buttons cannot be held");
+        default:
+            break;
+    }
+    
+    this->button(button, Direction::Press);
+    track_press({HoldTarget::Kind::Button, static_cast<uint16_t>(button)}, deadline);
+}
+
+/**
+ * @brief Records that an input went down and schedules its release if needed
+ * 
+ * @details The release is scheduled at the requested deadline or when the
+ * configured maximum hold duration runs out, whichever comes first. Without
+ * either, any earlier scheduled release of the same input is cancelled so a
+ * manual press always wins over an older timed hold.
+ * 
+ * @param target The input that was pressed
+ * @param deadline Optional requested release time
+ */
+void Bego::track_press(const HoldTarget& target, std::optional<HoldScheduler::Clock::time_point> deadline) {
+    BEGO_PROBE3(held, static_cast<int>(target.kind), target.code, 1);
+    
+    note_held(target, true);
+    
+    if (max_hold_duration.count() > 0) {
+        auto limit = HoldScheduler::Clock::now() + max_hold_duration;
+        if (!deadline || limit < *deadline) {
+            deadline = limit;
+        }
+    }
+    
+    if (!deadline) {
+        hold_tickets.erase(target.packed());
+        return;
+    }
+    
+    if (!hold_scheduler) {
+        hold_scheduler = std::make_unique<HoldScheduler>(
+            [this](const HoldTarget& expired, uint64_t ticket) { expire_hold(expired, ticket); });
+    }
+    
+    uint64_t ticket = ++last_hold_ticket;
+    hold_tickets[target.packed()] = ticket;
+    hold_scheduler->schedule(target, *deadline, ticket);
+}
+
+/**
+ * @brief Forgets any pending scheduled release for an input that went up
+ * 
+ * @param target The input that was released
+ */
+void Bego::track_release(const HoldTarget& target) {
+    BEGO_PROBE3(held, static_cast<int>(target.kind), target.code, 0);
+    
+    note_held(target, false);
+    
+    if (!hold_tickets.empty()) {
+        hold_tickets.erase(target.packed());
+    }
+}
+
+/**
+ * @brief Releases an input whose deadline expired
+ * 
+ * @details Runs on the hold scheduler thread. The deadline is ignored if the
+ * input was released or pressed again since it was scheduled, which shows up
+ * as a different (or missing) ticket.
+ * 
+ * @param target The input to release
+ * @param ticket The ticket the deadline was scheduled with
+ */
+void Bego::expire_hold(const HoldTarget& target, uint64_t ticket) {
+    std::lock_guard<std::recursive_mutex> lock(input_mutex);
+    
+    auto it = hold_tickets.find(target.packed());
+    if (it == hold_tickets.end() || it->second != ticket) {
+        return;
+    }
+    
+    release_target(target);
+}
+
+/**
+ * @brief Releases an input regardless of how it was pressed
+ * 
+ * @param target The input to release
+ */
+void Bego::release_target(const HoldTarget& target) {
+    switch (target.kind) {
+        case HoldTarget::Kind::Key:
+            key(static_cast<Key>(target.code), Direction::Release);
+            break;
+        case HoldTarget::Kind::Raw:
+            raw(target.code, Direction::Release);
+            break;
+        case HoldTarget::Kind::Button:
+            button(static_cast<Button>(target.code), Direction::Release);
+            break;
+    }
+}
+
 /**
  * @brief Gets the event marker value used by this instance
  * 
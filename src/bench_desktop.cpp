@@ -0,0 +1,74 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include "../include/bego_win.h"
+#include "../include/bego_script.h"
+#include "../include/bego_virtual_desktop.h"
+
+// Benchmark for the virtual desktop: raw event throughput of the model, and how many
+// scripts per second can be run and checked against it end to end.
+// Usage: bego-bench-desktop [scripts, default 100000]
+
+using Clock = std::chrono::steady_clock;
+
+double seconds(Clock::duration elapsed) {
+    return std::chrono::duration<double>(elapsed).count();
+}
+
+int main(int argc, char** argv) {
+    size_t scripts = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+
+    auto desktop = std::make_shared<bego::VirtualDesktop>(2560, 1440);
+    bego::Bego bego(bego::Settings(), desktop);
+
+    // Model throughput on a prepared buffer
+    std::vector<bego::Event> events;
+    for (int i = 0; events.size() < 1000000; i++) {
+        bego.queue_move(events, i % 2560, i % 1440, bego::Coordinate::Abs);
+        bego.queue_move(events, 3, -2, bego::Coordinate::Rel);
+        bego.queue_key(events, bego::Key::A, bego::Direction::Click);
+        bego.queue_button(events, bego::Button::Left, bego::Direction::Click);
+        bego.queue_scroll(events, 1, bego::Axis::Vertical);
+    }
+    auto start = Clock::now();
+    for (size_t offset = 0; offset < events.size(); offset += 256) {
+        desktop->dispatch(events.data() + offset, std::min<size_t>(256, events.size() - offset));
+    }
+    double elapsed = seconds(Clock::now() - start);
+    std::cout << std::fixed << std::setprecision(1) << "Model:   " << events.size() / elapsed / 1e6
+              << " M events/s" << std::endl;
+
+    // Scripts run through the VM, each checked against the model
+    bego::Program program = bego::compile_script(
+        "move 10 20 rel\n"
+        "button left\n"
+        "key shift down\n"
+        "key h\n"
+        "key shift up\n"
+        "text ello, world\n"
+        "scroll -2\n"
+        "move 640 360\n", bego);
+    bego::ScriptVM vm(bego);
+
+    // Scrolling by -2 turns the wheel two notches forward
+    size_t failures = 0;
+    start = Clock::now();
+    for (size_t i = 0; i < scripts; i++) {
+        desktop->reset();
+        vm.run(program);
+        auto [x, y] = bego.location();
+        if (x != 640 || y != 360 || desktop->typed() != "Hello, world" || desktop->is_down(bego::Button::Left) ||
+            desktop->wheel().first != 2 * WHEEL_DELTA) {
+            failures++;
+        }
+    }
+    elapsed = seconds(Clock::now() - start);
+    std::cout << "Scripts: " << scripts / elapsed << " scripts/s, " << scripts * desktop->events() / elapsed / 1e6
+              << " M events/s, " << failures << " failed checks" << std::endl;
+
+    return failures == 0 ? 0 : 1;
+}
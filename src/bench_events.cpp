@@ -0,0 +1,75 @@
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include "../include/bego_win.h"
+
+// Benchmark for the compact event representation: memory per buffered event
+// and throughput of the Event -> INPUT expansion kernel run at dispatch time.
+
+// Build a mixed buffer resembling typical payloads: mostly typed text,
+// some key presses, moves, clicks and scrolls
+std::vector<bego::Event> makeEvents(size_t count) {
+    std::vector<bego::Event> events;
+    events.reserve(count);
+
+    for (size_t i = 0; events.size() < count; i++) {
+        switch (i % 8) {
+            case 0:
+                events.push_back(bego::Event::move(true, static_cast<int>(i % 65536), static_cast<int>((i * 7) % 65536)));
+                break;
+            case 1:
+                events.push_back(bego::Event::button((i / 8) % 2 != 0, bego::Button::Left));
+                break;
+            case 2:
+                events.push_back(bego::Event::wheel(bego::Axis::Vertical, -120));
+                break;
+            case 3:
+                events.push_back(bego::Event::key(false, VK_RETURN, 0x1C, 0));
+                break;
+            default:
+                events.push_back(bego::Event::key((i % 2) != 0, 0, static_cast<uint16_t>('a' + i % 26),
+                                                  bego::event_flags::Unicode));
+                break;
+        }
+    }
+
+    return events;
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    int rounds = argc > 2 ? std::atoi(argv[2]) : 20;
+
+    std::vector<bego::Event> events = makeEvents(count);
+    std::vector<INPUT> expanded(count);
+
+    std::cout << "Events:             " << count << std::endl;
+    std::cout << "sizeof(Event):      " << sizeof(bego::Event) << " bytes" << std::endl;
+    std::cout << "sizeof(INPUT):      " << sizeof(INPUT) << " bytes" << std::endl;
+    std::cout << "Buffered as Event:  " << count * sizeof(bego::Event) / 1024 << " KiB" << std::endl;
+    std::cout << "Buffered as INPUT:  " << count * sizeof(INPUT) / 1024 << " KiB" << std::endl;
+
+    // Warm up caches and page in the destination
+    bego::expand_events(events.data(), count, bego::EVENT_MARKER, expanded.data());
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        bego::expand_events(events.data(), count, bego::EVENT_MARKER, expanded.data());
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    double total = static_cast<double>(count) * rounds;
+    std::cout << "Expansion:          " << elapsed.count() * 1e9 / total << " ns/event, "
+              << total / elapsed.count() / 1e6 << " M events/s" << std::endl;
+
+    // Keep the result observable so the loop is not optimized away
+    unsigned long checksum = 0;
+    for (size_t i = 0; i < count; i += 4096) {
+        checksum += expanded[i].type;
+    }
+    std::cout << "Checksum:           " << checksum << std::endl;
+
+    return 0;
+}
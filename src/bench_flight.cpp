@@ -0,0 +1,108 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstdlib>
+#include "../include/bego_win.h"
+#include "../include/bego_flight.h"
+
+// Benchmark for the flight recorder: cost of recording a batch, the overhead it adds
+// to Bego::send() per event, recording from several threads and the cost of a dump.
+// Usage: bego-bench-flight [batches, default 1000000] [dump file, default bego-bench.bfr]
+
+using Clock = std::chrono::steady_clock;
+
+// A batch of key strokes, moves and clicks
+std::vector<bego::Event> makeBatch(size_t size) {
+    std::vector<bego::Event> batch;
+    for (size_t i = 0; batch.size() < size; i++) {
+        switch (i % 3) {
+            case 0:
+                batch.push_back(bego::Event::key(i % 2 == 0, 'A', 0x1E, 0));
+                break;
+            case 1:
+                batch.push_back(bego::Event::move(true, static_cast<int>(i * 31 % 65536), 1000));
+                break;
+            default:
+                batch.push_back(bego::Event::button(i % 2 == 0, bego::Button::Left));
+                break;
+        }
+    }
+    return batch;
+}
+
+double nsPerEvent(Clock::duration elapsed, size_t events) {
+    return std::chrono::duration<double, std::nano>(elapsed).count() / events;
+}
+
+int main(int argc, char** argv) {
+    size_t batches = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    const char* path = argc > 2 ? argv[2] : "bego-bench.bfr";
+
+    bego::Bego bego(bego::Settings(), std::make_shared<bego::NullBackend>());
+    bego::FlightRecorder& recorder = bego::FlightRecorder::start();
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "batch   record ns/event   send off ns/event   send on ns/event   overhead ns/event" << std::endl;
+    for (size_t size : {1, 4, 16, 64, 256}) {
+        std::vector<bego::Event> batch = makeBatch(size);
+        size_t rounds = std::max<size_t>(1, batches / size);
+        size_t events = rounds * size;
+
+        auto start = Clock::now();
+        for (size_t i = 0; i < rounds; i++) {
+            recorder.record(batch.data(), size, bego::EventOrigin::Send);
+        }
+        double record = nsPerEvent(Clock::now() - start, events);
+
+        bego::FlightRecorder::stop();
+        start = Clock::now();
+        for (size_t i = 0; i < rounds; i++) {
+            bego.send(batch.data(), size);
+        }
+        double off = nsPerEvent(Clock::now() - start, events);
+
+        bego::FlightRecorder::start();
+        start = Clock::now();
+        for (size_t i = 0; i < rounds; i++) {
+            bego.send(batch.data(), size);
+        }
+        double on = nsPerEvent(Clock::now() - start, events);
+
+        std::cout << std::setw(5) << size << std::setw(18) << record << std::setw(20) << off << std::setw(19) << on
+                  << std::setw(20) << on - off << std::endl;
+    }
+
+    // All threads share one sequence counter, so this shows what contention on it costs
+    std::vector<bego::Event> batch = makeBatch(16);
+    for (unsigned threads : {1u, 2u, 4u, 8u}) {
+        auto start = Clock::now();
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; t++) {
+            workers.emplace_back([&] {
+                for (size_t i = 0; i < batches; i++) {
+                    recorder.record(batch.data(), batch.size(), bego::EventOrigin::Send);
+                }
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        Clock::duration elapsed = Clock::now() - start;
+        std::cout << threads << " thread(s) recording: " << nsPerEvent(elapsed, threads * batches * batch.size())
+                  << " ns/event" << std::endl;
+    }
+
+    auto start = Clock::now();
+    recorder.dump(path);
+    double dump_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    start = Clock::now();
+    recorder.dump_signal_safe(path);
+    double safe_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    std::cout << "Dump of " << recorder.capacity() << " records: " << dump_ms << " ms, signal-safe " << safe_ms
+              << " ms" << std::endl;
+
+    return 0;
+}
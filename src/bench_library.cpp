@@ -0,0 +1,83 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include "../include/bego_win.h"
+#include "../include/bego_script_library.h"
+
+// Benchmark for macro libraries: how opening, name lookup and first use scale
+// with the number of macros in the file.
+// Usage: bego-bench-library [largest macro count, default 100000] [library path, default bego-bench.bgl]
+
+using Clock = std::chrono::steady_clock;
+
+// Nanoseconds between two time points
+double elapsedNs(Clock::time_point start, Clock::time_point end) {
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+int main(int argc, char** argv) {
+    size_t largest = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    std::string path = argc > 2 ? argv[2] : "bego-bench.bgl";
+
+    bego::Bego bego(bego::Settings(), std::make_shared<bego::NullBackend>());
+    bego::Program program = bego::compile_script(
+        "set round 0\nloop 3\nkey W press\nsleep 20ms\nkey W release\nbutton Left\ntext gg\nadd round 1\nend\n", bego);
+
+    std::cout << std::setw(8) << "macros" << std::setw(12) << "file KiB" << std::setw(12) << "open us"
+              << std::setw(14) << "lookup ns" << std::setw(16) << "first use ns" << std::setw(14) << "reuse ns"
+              << std::endl;
+
+    for (size_t count = 1000; count <= largest; count *= 10) {
+        std::vector<std::string> names;
+        bego::ScriptLibraryBuilder builder;
+        for (size_t i = 0; i < count; i++) {
+            names.push_back("macro_" + std::to_string(i));
+            builder.add(names.back(), program);
+        }
+        builder.write(path);
+
+        auto start = Clock::now();
+        bego::ScriptLibrary library(path);
+        const double open_ns = elapsedNs(start, Clock::now());
+
+        // Lookups of random names, without loading
+        std::mt19937 rng(1);
+        const size_t lookups = 200000;
+        size_t found = 0;
+        start = Clock::now();
+        for (size_t i = 0; i < lookups; i++) {
+            found += library.contains(names[rng() % count]);
+        }
+        const double lookup_ns = elapsedNs(start, Clock::now()) / lookups;
+
+        // First use loads 1000 macros; using them again hits the loaded copies
+        const size_t used = std::min<size_t>(1000, count);
+        start = Clock::now();
+        for (size_t i = 0; i < used; i++) {
+            found += library.find(names[i * (count / used)]) != nullptr;
+        }
+        const double first_ns = elapsedNs(start, Clock::now()) / used;
+        start = Clock::now();
+        for (size_t i = 0; i < used; i++) {
+            found += library.find(names[i * (count / used)]) != nullptr;
+        }
+        const double reuse_ns = elapsedNs(start, Clock::now()) / used;
+
+        std::cout << std::fixed << std::setprecision(1) << std::setw(8) << count << std::setw(12)
+                  << std::filesystem::file_size(path) / 1024 << std::setw(12) << open_ns / 1000 << std::setw(14)
+                  << lookup_ns << std::setw(16) << first_ns << std::setw(14) << reuse_ns << std::endl;
+        if (found != lookups + 2 * used) {
+            std::cerr << "lookup failed" << std::endl;
+            return 1;
+        }
+    }
+
+    std::filesystem::remove(path);
+    return 0;
+}
@@ -0,0 +1,105 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstdlib>
+#include "../include/bego_win.h"
+#include "../include/bego_log.h"
+
+// Benchmark for the deferred-formatting logger: cost of a log call that is filtered out,
+// of one that is recorded with zero to six arguments, from several threads at once, and
+// of Bego::send() with per-dispatch debug logging on. Rings are drained between runs so
+// no record is dropped.
+// Usage: bego-bench-log [calls, default 1000000] [write the collected records to this log file]
+
+using Clock = std::chrono::steady_clock;
+
+// Calls per run between two collections, below the ring size
+constexpr size_t RUN = bego::log::RING_RECORDS / 2;
+
+double nsPerCall(Clock::duration elapsed, size_t calls) {
+    return std::chrono::duration<double, std::nano>(elapsed).count() / calls;
+}
+
+// Time calls of f in runs of RUN, draining the rings between runs outside the timing
+template <typename F>
+double measure(size_t calls, const bego::log::Collector::Sink& sink, F&& f) {
+    Clock::duration elapsed{};
+    for (size_t done = 0; done < calls; done += RUN) {
+        auto start = Clock::now();
+        for (size_t i = 0; i < RUN; i++) {
+            f(i);
+        }
+        elapsed += Clock::now() - start;
+        bego::log::collect(sink);
+    }
+    return nsPerCall(elapsed, (calls + RUN - 1) / RUN * RUN);
+}
+
+int main(int argc, char** argv) {
+    size_t calls = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    bego::log::Collector::Sink sink = [](const bego::log::Record*, size_t) {};
+    if (argc > 2) {
+        sink = bego::log::Collector::to_binary(argv[2]);
+    }
+
+    std::cout << std::fixed << std::setprecision(2);
+
+    bego::log::set_level(bego::log::Level::Warning);
+    std::cout << "Filtered out:    " << measure(calls, sink, [](size_t i) { BEGO_LOG(Debug, "value {}", i); })
+              << " ns/call" << std::endl;
+
+    bego::log::set_level(bego::log::Level::Debug);
+    std::cout << "No arguments:    " << measure(calls, sink, [](size_t) { BEGO_LOG(Debug, "tick"); })
+              << " ns/call" << std::endl;
+    std::cout << "Two arguments:   "
+              << measure(calls, sink, [](size_t i) { BEGO_LOG(Debug, "value {} of {}", i, 42); }) << " ns/call"
+              << std::endl;
+    std::cout << "Six arguments:   "
+              << measure(calls, sink,
+                         [](size_t i) { BEGO_LOG(Debug, "{} {} {} {} {} {}", i, -1, 2.5, true, &i, 7u); })
+              << " ns/call" << std::endl;
+
+    // Every thread writes its own ring, so the cost per call should not grow with more threads.
+    // Each worker times its own runs and drains the rings after each one.
+    for (unsigned threads : {1u, 2u, 4u, 8u}) {
+        std::vector<Clock::duration> elapsed(threads);
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; t++) {
+            workers.emplace_back([&, t] {
+                elapsed[t] = Clock::duration{};
+                for (size_t done = 0; done < calls; done += RUN) {
+                    auto start = Clock::now();
+                    for (size_t i = 0; i < RUN; i++) {
+                        BEGO_LOG(Debug, "thread {} call {}", t, i);
+                    }
+                    elapsed[t] += Clock::now() - start;
+                    bego::log::collect(sink);
+                }
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        Clock::duration total{};
+        for (Clock::duration time : elapsed) {
+            total += time;
+        }
+        std::cout << threads << " thread(s) logging: " << nsPerCall(total, threads * ((calls + RUN - 1) / RUN * RUN))
+                  << " ns/call" << std::endl;
+    }
+
+    bego::Bego bego(bego::Settings(), std::make_shared<bego::NullBackend>());
+    std::vector<bego::Event> batch = {bego::Event::key(false, 'A', 0x1E, 0), bego::Event::key(true, 'A', 0x1E, 0)};
+    bego::log::set_level(bego::log::Level::Warning);
+    double off = measure(calls, sink, [&](size_t) { bego.send(batch.data(), batch.size()); });
+    bego::log::set_level(bego::log::Level::Debug);
+    double on = measure(calls, sink, [&](size_t) { bego.send(batch.data(), batch.size()); });
+    std::cout << "send() without dispatch logging: " << off << " ns/call, with: " << on << " ns/call" << std::endl;
+
+    bego::log::set_level(bego::log::Level::Off);
+    std::cout << "Dropped records: " << bego::log::dropped() << std::endl;
+    return 0;
+}
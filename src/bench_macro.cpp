@@ -0,0 +1,125 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <algorithm>
+#include "../include/bego_macro.h"
+
+// Benchmark for macro editing: structure-of-arrays MacroBuffer kernels against
+// the record-by-record approach over an array of TimedEvent structures.
+// Usage: bego-bench-macro [event count, default 100000000]
+
+using Clock = std::chrono::steady_clock;
+
+// Generate a recording-like mix of moves, keys, clicks and scrolls at 1 kHz
+bego::TimedEvent makeEvent(size_t i) {
+    int64_t t = static_cast<int64_t>(i) * 1000000;
+    switch (i % 10) {
+        case 0:
+        case 1:
+        case 2:
+        case 3:
+        case 4:
+            return {t, bego::Event::move(false, static_cast<int>(i % 7) - 3, static_cast<int>(i % 5) - 2)};
+        case 5:
+            return {t, bego::Event::move(true, static_cast<int>(i % 65536), static_cast<int>((i * 3) % 65536))};
+        case 6:
+            return {t, bego::Event::key(false, 'W', 0x11, 0)};
+        case 7:
+            return {t, bego::Event::key(true, 'W', 0x11, 0)};
+        case 8:
+            return {t, bego::Event::button(i % 20 == 8, bego::Button::Left)};
+        default:
+            return {t, bego::Event::wheel(bego::Axis::Vertical, -120)};
+    }
+}
+
+// Print one result line
+void report(const std::string& name, Clock::duration aos, Clock::duration soa, size_t count) {
+    double aos_ns = std::chrono::duration<double, std::nano>(aos).count() / count;
+    double soa_ns = std::chrono::duration<double, std::nano>(soa).count() / count;
+    std::cout << std::left << std::setw(18) << name << std::right << std::fixed << std::setprecision(3)
+              << std::setw(10) << aos_ns << " ns/event" << std::setw(10) << soa_ns << " ns/event"
+              << std::setw(8) << std::setprecision(1) << aos_ns / soa_ns << "x" << std::endl;
+}
+
+// Time a callable
+template <typename F>
+Clock::duration timeIt(F&& f) {
+    auto start = Clock::now();
+    f();
+    return Clock::now() - start;
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000000;
+
+    std::cout << "Generating " << count << " events..." << std::endl;
+    std::vector<bego::TimedEvent> records;
+    bego::MacroBuffer macro;
+    records.reserve(count);
+    macro.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        bego::TimedEvent e = makeEvent(i);
+        records.push_back(e);
+        macro.push_back(e);
+    }
+
+    std::cout << std::left << std::setw(18) << "operation" << std::right << std::setw(19) << "record-by-record"
+              << std::setw(19) << "columns" << std::setw(9) << "speedup" << std::endl;
+
+    // Time shift
+    auto aos = timeIt([&] {
+        for (auto& r : records) {
+            r.timestamp += 5000000;
+        }
+    });
+    auto soa = timeIt([&] { macro.shift_time(5000000); });
+    report("shift_time", aos, soa, count);
+
+    // Time scale
+    aos = timeIt([&] {
+        for (auto& r : records) {
+            r.timestamp = static_cast<int64_t>(std::nearbyint(static_cast<double>(r.timestamp) * 1.25));
+        }
+    });
+    soa = timeIt([&] { macro.scale_time(1.25); });
+    report("scale_time", aos, soa, count);
+
+    // Coordinate affine transform
+    aos = timeIt([&] {
+        for (auto& r : records) {
+            if (r.event.kind == bego::EventKind::MoveAbs) {
+                r.event = bego::Event::move(true, static_cast<int>(std::nearbyint(r.event.x() * 0.5f + 100.0f)),
+                                            static_cast<int>(std::nearbyint(r.event.y() * 0.5f + 100.0f)));
+            } else if (r.event.kind == bego::EventKind::MoveRel) {
+                r.event = bego::Event::move(false, static_cast<int>(std::nearbyint(r.event.x() * 0.5f)),
+                                            static_cast<int>(std::nearbyint(r.event.y() * 0.5f)));
+            }
+        }
+    });
+    soa = timeIt([&] { macro.transform_coordinates(0.5f, 0.5f, 100.0f, 100.0f); });
+    report("transform", aos, soa, count);
+
+    // Kind filter: drop relative moves
+    uint32_t mask = ~bego::kind_bit(bego::EventKind::MoveRel);
+    aos = timeIt([&] {
+        records.erase(std::remove_if(records.begin(), records.end(),
+                                     [mask](const bego::TimedEvent& r) { return !(mask & bego::kind_bit(r.event.kind)); }),
+                      records.end());
+    });
+    soa = timeIt([&] { macro.filter_kinds(mask); });
+    report("filter_kinds", aos, soa, count);
+
+    // Cross-check the two representations
+    bool same = records.size() == macro.size();
+    for (size_t i = 0; same && i < records.size(); i += 997) {
+        same = records[i].timestamp == macro.timestamp(i) && records[i].event == macro.event(i);
+    }
+    std::cout << "Results match: " << (same ? "yes" : "NO") << " (" << macro.size() << " events left)" << std::endl;
+
+    return same ? 0 : 1;
+}
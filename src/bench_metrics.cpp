@@ -0,0 +1,115 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdlib>
+#include "../include/bego_win.h"
+#include "../include/bego_metrics.h"
+
+// Benchmark for the metrics subsystem: cost of recording a batch, the overhead it adds
+// to Bego::send() per event, and recording from several threads at once.
+// Usage: bego-bench-metrics [batches, default 1000000] [write the Prometheus text to this file]
+
+using Clock = std::chrono::steady_clock;
+
+// A batch of clicks, key strokes and moves
+std::vector<bego::Event> makeBatch(size_t size) {
+    std::vector<bego::Event> batch;
+    for (size_t i = 0; batch.size() < size; i++) {
+        switch (i % 4) {
+            case 0:
+                batch.push_back(bego::Event::key(false, 'A', 0x1E, 0));
+                break;
+            case 1:
+                batch.push_back(bego::Event::key(true, 'A', 0x1E, 0));
+                break;
+            case 2:
+                batch.push_back(bego::Event::move(true, static_cast<int>(i * 31 % 65536), 1000));
+                break;
+            default:
+                batch.push_back(bego::Event::button(i % 8 == 3, bego::Button::Left));
+                break;
+        }
+    }
+    return batch;
+}
+
+double seconds(Clock::duration elapsed) {
+    return std::chrono::duration<double>(elapsed).count();
+}
+
+double nsPerEvent(Clock::duration elapsed, size_t events) {
+    return std::chrono::duration<double, std::nano>(elapsed).count() / events;
+}
+
+int main(int argc, char** argv) {
+    size_t batches = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    const char* path = argc > 2 ? argv[2] : nullptr;
+
+    bego::Bego bego(bego::Settings(), std::make_shared<bego::NullBackend>());
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "batch   record ns/event   send off ns/event   send on ns/event   overhead ns/event" << std::endl;
+    for (size_t size : {1, 4, 16, 64, 256}) {
+        std::vector<bego::Event> batch = makeBatch(size);
+        size_t rounds = std::max<size_t>(1, batches / size);
+        size_t events = rounds * size;
+
+        auto start = Clock::now();
+        for (size_t i = 0; i < rounds; i++) {
+            bego::metrics::record_dispatch(batch.data(), size, 1500, true);
+        }
+        double record = nsPerEvent(Clock::now() - start, events);
+
+        bego::metrics::enable(false);
+        start = Clock::now();
+        for (size_t i = 0; i < rounds; i++) {
+            bego.send(batch.data(), size);
+        }
+        double off = nsPerEvent(Clock::now() - start, events);
+
+        bego::metrics::enable(true);
+        start = Clock::now();
+        for (size_t i = 0; i < rounds; i++) {
+            bego.send(batch.data(), size);
+        }
+        double on = nsPerEvent(Clock::now() - start, events);
+
+        std::cout << std::setw(5) << size << std::setw(18) << record << std::setw(20) << off << std::setw(19) << on
+                  << std::setw(20) << on - off << std::endl;
+    }
+
+    // Every thread writes its own counters, so the cost per event should not grow with more threads
+    std::vector<bego::Event> batch = makeBatch(16);
+    for (unsigned threads : {1u, 2u, 4u, 8u}) {
+        auto start = Clock::now();
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; t++) {
+            workers.emplace_back([&] {
+                for (size_t i = 0; i < batches; i++) {
+                    bego::metrics::record_dispatch(batch.data(), batch.size(), 1500, true);
+                }
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        Clock::duration elapsed = Clock::now() - start;
+        size_t events = threads * batches * batch.size();
+        std::cout << threads << " thread(s) recording: " << nsPerEvent(elapsed, events) << " ns/event, "
+                  << events / seconds(elapsed) / 1e6 << " M events/s" << std::endl;
+    }
+
+    bego::metrics::Snapshot totals = bego::metrics::snapshot();
+    std::cout << "Totals: " << totals.batches << " batches, " << totals.batch_events << " events" << std::endl;
+
+    if (path) {
+        bego::metrics::write_prometheus(path);
+        std::cout << "Wrote " << path << std::endl;
+    }
+
+    return 0;
+}
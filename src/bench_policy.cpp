@@ -0,0 +1,85 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <memory>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include "../include/bego_win.h"
+#include "../include/bego_basic.h"
+
+// Benchmark for the policy-based BasicBego: cost per call of Bego against a lean
+// BasicBego with every optional feature compiled out and a fully featured one,
+// all delivering to a backend that only counts events.
+// Usage: bego-bench-policy [calls per case, default 2000000]
+
+using Clock = std::chrono::steady_clock;
+
+// Backend that counts what it receives, so the calls cannot be optimized away
+class CountingBackend : public bego::Backend {
+public:
+    void dispatch(const bego::Event*, size_t count) override {
+        received += count;
+    }
+
+    std::optional<std::pair<int, int>> screen_size() override {
+        return std::make_pair(1920, 1080);
+    }
+
+    uint64_t received = 0;
+};
+
+using Lean = bego::BasicBego<CountingBackend, bego::NoTracking, bego::NoInstrumentation, bego::ThrowOnError>;
+using Full = bego::BasicBego<CountingBackend, bego::HeldTracking, bego::CountingInstrumentation, bego::RecordErrors>;
+
+// Nanoseconds per call of f, run calls times
+template <typename F>
+double nsPerCall(size_t calls, F&& f) {
+    auto start = Clock::now();
+    for (size_t i = 0; i < calls; i++) {
+        f(i);
+    }
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / calls;
+}
+
+template <typename B>
+void row(const char* name, B& target, size_t calls) {
+    const bego::Event batch[] = {
+        bego::Event::key(false, VK_SHIFT, 0x2A, 0),
+        bego::Event::key(false, 'A', 0x1E, 0),
+        bego::Event::key(true, 'A', 0x1E, 0),
+        bego::Event::key(true, VK_SHIFT, 0x2A, 0),
+    };
+
+    double key = nsPerCall(calls, [&](size_t) { target.key(bego::Key::A, bego::Direction::Click); });
+    double button = nsPerCall(calls, [&](size_t) { target.button(bego::Button::Left, bego::Direction::Click); });
+    double move = nsPerCall(calls, [&](size_t i) {
+        target.move_mouse(static_cast<int>(i % 1920), static_cast<int>(i % 1080), bego::Coordinate::Abs);
+    });
+    double send = nsPerCall(calls, [&](size_t) { target.send(batch, 4); });
+
+    std::cout << std::left << std::setw(10) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << key << std::setw(10) << button << std::setw(10) << move
+              << std::setw(10) << send << std::endl;
+}
+
+int main(int argc, char** argv) {
+    size_t calls = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+
+    auto backend = std::make_shared<CountingBackend>();
+    bego::Bego bego(bego::Settings(), backend);
+    Lean lean;
+    Full full;
+
+    std::cout << "ns per call  " << "      key    button      move      send" << std::endl;
+    row("Bego", bego, calls);
+    row("lean", lean, calls);
+    row("full", full, calls);
+
+    std::cout << "sizeof(Lean): " << sizeof(Lean) << " bytes, sizeof(Full): " << sizeof(Full) << " bytes" << std::endl;
+    std::cout << "Events: " << backend->received << " / " << lean.backend().received << " / "
+              << full.backend().received << ", full dispatches: " << full.instrumentation().dispatch_count()
+              << ", failures: " << full.errors().failure_count() << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,59 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <cstdlib>
+#include "../include/bego_win.h"
+#include "../include/bego_realtime.h"
+
+// Benchmark for real-time dispatch: latency of Bego::send() straight into a backend and
+// through a RealtimeBackend, waiting for delivery and queue-only, as percentiles. Prints
+// which real-time guarantees the process could get first.
+// Usage: bego-bench-realtime [sends, default 200000] [CPU to pin the dispatch thread to]
+
+using Clock = std::chrono::steady_clock;
+
+// Time each send of a small batch and print the latency percentiles
+void measure(const char* label, bego::Bego& bego, size_t sends) {
+    std::vector<bego::Event> batch = {bego::Event::key(false, 'A', 0x1E, 0), bego::Event::key(true, 'A', 0x1E, 0)};
+    std::vector<int64_t> samples(sends);
+
+    for (size_t i = 0; i < sends; i++) {
+        auto start = Clock::now();
+        bego.send(batch.data(), batch.size());
+        samples[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+    }
+
+    std::sort(samples.begin(), samples.end());
+    auto at = [&](double p) { return samples[std::min(sends - 1, static_cast<size_t>(p * sends))]; };
+    std::cout << std::left << std::setw(22) << label << std::right << std::setw(10) << at(0.5) << std::setw(10)
+              << at(0.99) << std::setw(10) << at(0.999) << std::setw(12) << samples.back() << std::endl;
+}
+
+int main(int argc, char** argv) {
+    size_t sends = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+
+    bego::RealtimeOptions options;
+    options.cpu = argc > 2 ? std::atoi(argv[2]) : -1;
+
+    auto null_backend = std::make_shared<bego::NullBackend>();
+    auto waiting = std::make_shared<bego::RealtimeBackend>(null_backend, options);
+    std::cout << waiting->guarantees().describe() << std::endl << std::endl;
+
+    options.wait = false;
+    auto queued = std::make_shared<bego::RealtimeBackend>(null_backend, options);
+
+    bego::Bego direct(bego::Settings(), null_backend);
+    bego::Bego through(bego::Settings(), waiting);
+    bego::Bego queue_only(bego::Settings(), queued);
+
+    std::cout << "send() latency, ns         p50       p99     p99.9         max" << std::endl;
+    measure("Direct", direct, sends);
+    measure("Real-time, waiting", through, sends);
+    measure("Real-time, queued", queue_only, sends);
+    queued->flush();
+
+    return 0;
+}
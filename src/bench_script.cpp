@@ -0,0 +1,107 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <cstdlib>
+#include "../include/bego_win.h"
+#include "../include/bego_script.h"
+
+// Benchmark for the script interpreter: cost per bytecode instruction and the
+// overhead of running a key macro through the VM instead of sending the same
+// events directly. Events go to a backend that drops them, so only the library
+// side is measured.
+// Usage: bego-bench-script [iterations, default 10000000]
+
+using Clock = std::chrono::steady_clock;
+
+// Backend that discards everything it receives
+class NullBackend : public bego::Backend {
+public:
+    void dispatch(const bego::Event*, size_t count) override {
+        received += count;
+    }
+
+    size_t received = 0;
+};
+
+// Print one result line
+void report(const std::string& name, Clock::duration elapsed, uint64_t count, const char* unit) {
+    double ns = std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(count);
+    std::cout << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << ns << " ns/" << unit << std::endl;
+}
+
+int main(int argc, char** argv) {
+    long long iterations = argc > 1 ? std::atoll(argv[1]) : 10000000;
+
+    auto backend = std::make_shared<NullBackend>();
+    bego::Bego bego(bego::Settings(), backend);
+    bego::ScriptVM vm(bego);
+
+    // Pure interpreter overhead: arithmetic, a comparison and a loop back-edge
+    std::string arithmetic =
+        "set n " + std::to_string(iterations) + "\n"
+        "set total 0\n"
+        "loop n\n"
+        "  add total 3\n"
+        "  mul total 5\n"
+        "  mod total 1000003\n"
+        "  if total > 500000\n"
+        "    sub total 7\n"
+        "  end\n"
+        "end\n";
+    bego::Program program = bego::compile_script(arithmetic, bego);
+
+    auto start = Clock::now();
+    bego::ScriptStats stats = vm.run(program);
+    auto elapsed = Clock::now() - start;
+    std::cout << "Arithmetic loop: " << stats.instructions << " instructions, total = "
+              << vm.variable(program, "total").value_or(0) << std::endl;
+    report("interpreter", elapsed, stats.instructions, "instruction");
+
+    // Event emission through the VM against sending the same events directly
+    long long rounds = iterations / 10 > 0 ? iterations / 10 : 1;
+    std::string macro =
+        "loop " + std::to_string(rounds) + "\n"
+        "  key W press\n"
+        "  button Left\n"
+        "  scroll 1\n"
+        "  key W release\n"
+        "end\n";
+    program = bego::compile_script(macro, bego);
+
+    backend->received = 0;
+    start = Clock::now();
+    stats = vm.run(program);
+    elapsed = Clock::now() - start;
+    std::cout << "Macro loop: " << stats.events << " events in " << stats.batches << " batches" << std::endl;
+    report("script", elapsed, stats.events, "event");
+
+    // Same events, built once and sent in batches of the same size
+    std::vector<bego::Event> round;
+    bego.queue_key(round, bego::Key::W, bego::Direction::Press);
+    bego.queue_button(round, bego::Button::Left, bego::Direction::Click);
+    bego.queue_scroll(round, 1, bego::Axis::Vertical);
+    bego.queue_key(round, bego::Key::W, bego::Direction::Release);
+
+    std::vector<bego::Event> batch;
+    uint64_t sent = 0;
+    start = Clock::now();
+    for (long long r = 0; r < rounds; r++) {
+        batch.insert(batch.end(), round.begin(), round.end());
+        if (batch.size() >= bego::ScriptVM::max_batch) {
+            bego.send(batch.data(), batch.size());
+            sent += batch.size();
+            batch.clear();
+        }
+    }
+    if (!batch.empty()) {
+        bego.send(batch.data(), batch.size());
+        sent += batch.size();
+    }
+    elapsed = Clock::now() - start;
+    report("direct send", elapsed, sent, "event");
+
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include "../include/bego_win.h"
+#include "../include/bego_script_cache.h"
+
+// Benchmark for agent startup: getting a set of compiled scripts ready without
+// a cache, with an empty (cold) cache and with a filled (warm) cache.
+// Usage: bego-bench-startup [script count, default 500] [lines per script, default 400]
+//                           [cache directory, default bego-bench-cache]
+
+using Clock = std::chrono::steady_clock;
+
+// Build a script resembling a recorded combo: keys, clicks, text, waits and a loop
+std::string makeScript(size_t index, size_t lines) {
+    static const char* keys[] = {"W", "A", "S", "D", "Space", "Shift", "Control", "Tab", "F5", "Num1"};
+    std::string script = "set round 0\nloop 3\n";
+    for (size_t line = 0; line < lines; line++) {
+        switch ((index + line) % 6) {
+            case 0:
+                script += std::string("key ") + keys[(index + line) % 10] + " press\n";
+                break;
+            case 1:
+                script += std::string("key ") + keys[(index + line) % 10] + " release\n";
+                break;
+            case 2:
+                script += "button Left\n";
+                break;
+            case 3:
+                script += "text gg wp " + std::to_string(index) + "\n";
+                break;
+            case 4:
+                script += "sleep " + std::to_string(10 + line % 40) + "ms\n";
+                break;
+            default:
+                script += "add round 1\n";
+                break;
+        }
+    }
+    return script + "end\n";
+}
+
+// Prepare every script through a cache and return the elapsed time
+Clock::duration prepare(const std::vector<std::string>& scripts, bego::ScriptCache* cache, bego::Bego& bego,
+                        size_t& events) {
+    events = 0;
+    auto start = Clock::now();
+    for (const std::string& script : scripts) {
+        bego::Program program = cache ? cache->compile(script, bego) : bego::compile_script(script, bego);
+        events += program.events.size();
+    }
+    return Clock::now() - start;
+}
+
+// Print one result line
+void report(const std::string& name, Clock::duration elapsed, size_t events) {
+    std::cout << std::left << std::setw(12) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << std::chrono::duration<double, std::milli>(elapsed).count() << " ms  ("
+              << events << " events)" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 500;
+    size_t lines = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 400;
+    std::string directory = argc > 3 ? argv[3] : "bego-bench-cache";
+
+    bego::Bego bego(bego::Settings(), std::make_shared<bego::NullBackend>());
+
+    std::vector<std::string> scripts;
+    size_t bytes = 0;
+    for (size_t i = 0; i < count; i++) {
+        scripts.push_back(makeScript(i, lines));
+        bytes += scripts.back().size();
+    }
+    std::cout << count << " scripts, " << bytes / 1024 << " KiB of source" << std::endl;
+
+    size_t events = 0;
+    auto elapsed = prepare(scripts, nullptr, bego, events);
+    report("no cache", elapsed, events);
+
+    std::filesystem::remove_all(directory);
+    {
+        bego::ScriptCache cache(directory);
+        elapsed = prepare(scripts, &cache, bego, events);
+        report("cold cache", elapsed, events);
+    }
+    {
+        bego::ScriptCache cache(directory);
+        elapsed = prepare(scripts, &cache, bego, events);
+        report("warm cache", elapsed, events);
+        std::cout << "hits " << cache.hits() << ", misses " << cache.misses() << std::endl;
+    }
+
+    std::filesystem::remove_all(directory);
+    return 0;
+}
@@ -0,0 +1,109 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <memory>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include "../include/bego_win.h"
+#include "../include/bego_basic.h"
+#include "../include/bego_static.h"
+
+// Benchmark for static dispatch: the same automation loop written once against the
+// virtual Mouse/Keyboard interfaces and once as a template on StaticMouse/StaticKeyboard,
+// run on an event writer and on Bego. Reports nanoseconds per action.
+// Usage: bego-bench-static [iterations, default 2000000]
+
+using Clock = std::chrono::steady_clock;
+
+// The event writer behind the virtual interfaces, so both paths build identical events
+class VirtualWriter : public bego::Mouse, public bego::Keyboard {
+public:
+    VirtualWriter(std::vector<bego::Event>& events, std::pair<int, int> screen) : writer(events, screen) {}
+
+    void button(bego::Button button, bego::Direction direction) override { writer.button(button, direction); }
+    void scroll(int length, bego::Axis axis) override { writer.scroll(length, axis); }
+    void move_mouse(int x, int y, bego::Coordinate coordinate) override { writer.move_mouse(x, y, coordinate); }
+    std::pair<int, int> main_display() override { return writer.main_display(); }
+    std::pair<int, int> location() override { return writer.location(); }
+    std::optional<bool> fast_text(const std::string& text) override { return writer.fast_text(text); }
+    void text(const std::string& text) override { writer.text(text); }
+    void key(bego::Key key, bego::Direction direction) override { writer.key(key, direction); }
+    void raw(uint16_t scan, bego::Direction direction) override { writer.raw(scan, direction); }
+
+private:
+    bego::EventWriter writer;
+};
+
+// Actions per iteration of the loops below
+constexpr int ACTIONS = 6;
+
+// Drag in small steps with the wheel and a modifier, through the virtual interfaces
+void virtualLoop(bego::Mouse& mouse, bego::Keyboard& keyboard, size_t iterations, std::vector<bego::Event>& events) {
+    for (size_t i = 0; i < iterations; i++) {
+        if (events.size() > 4096) {
+            events.clear();
+        }
+        mouse.move_mouse(static_cast<int>(i % 1000), static_cast<int>(i % 500), bego::Coordinate::Abs);
+        mouse.button(bego::Button::Left, bego::Direction::Press);
+        mouse.move_mouse(4, 3, bego::Coordinate::Rel);
+        mouse.button(bego::Button::Left, bego::Direction::Release);
+        mouse.scroll(1, bego::Axis::Vertical);
+        keyboard.key(bego::Key::Shift, bego::Direction::Click);
+    }
+}
+
+// The same loop against the static interfaces
+template <typename M, typename K>
+void staticLoop(bego::StaticMouse<M>& mouse, bego::StaticKeyboard<K>& keyboard, size_t iterations,
+                std::vector<bego::Event>& events) {
+    for (size_t i = 0; i < iterations; i++) {
+        if (events.size() > 4096) {
+            events.clear();
+        }
+        mouse.move_mouse(static_cast<int>(i % 1000), static_cast<int>(i % 500), bego::Coordinate::Abs);
+        mouse.button(bego::Button::Left, bego::Direction::Press);
+        mouse.move_mouse(4, 3, bego::Coordinate::Rel);
+        mouse.button(bego::Button::Left, bego::Direction::Release);
+        mouse.scroll(1, bego::Axis::Vertical);
+        keyboard.key(bego::Key::Shift, bego::Direction::Click);
+    }
+}
+
+template <typename F>
+void row(const char* name, size_t iterations, F&& f) {
+    auto start = Clock::now();
+    f();
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    std::cout << std::left << std::setw(32) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(8) << ns / (iterations * ACTIONS) << " ns/action" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+    std::pair<int, int> screen{1920, 1080};
+
+    std::vector<bego::Event> events;
+    events.reserve(8192);
+    std::vector<bego::Event> unused;
+
+    // A pointer the compiler cannot see through, so the virtual calls stay virtual
+    std::unique_ptr<VirtualWriter> virtual_writer = std::make_unique<VirtualWriter>(events, screen);
+    VirtualWriter* volatile opaque = virtual_writer.get();
+    bego::EventWriter writer(events, screen);
+
+    row("writer, virtual interface", iterations, [&] { virtualLoop(*opaque, *opaque, iterations, events); });
+    row("writer, static interface", iterations, [&] { staticLoop(writer, writer, iterations, events); });
+
+    auto backend = std::make_shared<bego::NullBackend>();
+    bego::Bego bego(bego::Settings(), backend);
+    bego::Bego* volatile opaque_bego = &bego;
+    bego::StaticAdapter<bego::Bego> adapter(bego);
+    bego::BasicBego<bego::NullBackend, bego::NoTracking> lean;
+
+    row("Bego, virtual interface", iterations, [&] { virtualLoop(*opaque_bego, *opaque_bego, iterations, unused); });
+    row("Bego, static adapter", iterations, [&] { staticLoop(adapter, adapter, iterations, unused); });
+    row("BasicBego, static interface", iterations, [&] { staticLoop(lean, lean, iterations, unused); });
+
+    return 0;
+}
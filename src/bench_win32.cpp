@@ -0,0 +1,64 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <cstdlib>
+#include "../include/bego_win.h"
+#include "bego_win32_shim.h"
+
+// Benchmark of the real Win32 code path against the in-memory shim: for each public
+// API call, how many Win32 calls it makes and how long it takes without the OS.
+// Only built with BEGO_WIN32_SHIM.
+// Usage: bego-bench-win32 [iterations per call, default 100000]
+
+using Clock = std::chrono::steady_clock;
+
+// Run one API call repeatedly and print its Win32 calls and time per call
+void measure(const std::string& name, size_t iterations, const std::function<void()>& call) {
+    call();  // Warm up
+
+    const bego::shim::CallCounts before = bego::shim::counts();
+    auto start = Clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+        call();
+    }
+    auto end = Clock::now();
+    const bego::shim::CallCounts calls = bego::shim::counts() - before;
+
+    auto per = [&](uint64_t total) { return static_cast<double>(total) / iterations; };
+    std::cout << std::left << std::setw(20) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(11) << per(calls.send_input) << std::setw(9) << per(calls.inputs_sent) << std::setw(10)
+              << per(calls.map_virtual_key) << std::setw(10) << per(calls.get_system_metrics) << std::setw(10)
+              << per(calls.get_cursor_pos) << std::setw(10) << per(calls.get_keyboard_layout) << std::setprecision(0)
+              << std::setw(10) << std::chrono::duration<double, std::nano>(end - start).count() / iterations
+              << std::endl;
+}
+
+int main(int argc, char** argv) {
+    size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+
+    bego::shim::reset();
+    bego::Settings settings;
+    bego::Bego bego(settings);
+
+    std::cout << std::left << std::setw(20) << "call" << std::right << std::setw(11) << "SendInput" << std::setw(9)
+              << "inputs" << std::setw(10) << "MapVK" << std::setw(10) << "Metrics" << std::setw(10) << "CursorPos"
+              << std::setw(10) << "Layout" << std::setw(10) << "ns" << std::endl;
+
+    measure("key click", iterations, [&] { bego.key(bego::Key::A, bego::Direction::Click); });
+    measure("key press+release", iterations, [&] {
+        bego.key(bego::Key::Shift, bego::Direction::Press);
+        bego.key(bego::Key::Shift, bego::Direction::Release);
+    });
+    measure("raw click", iterations, [&] { bego.raw(0x1E, bego::Direction::Click); });
+    measure("text (11 chars)", iterations, [&] { bego.text("hello world"); });
+    measure("button click", iterations, [&] { bego.button(bego::Button::Left, bego::Direction::Click); });
+    measure("scroll", iterations, [&] { bego.scroll(1, bego::Axis::Vertical); });
+    measure("move abs", iterations, [&] { bego.move_mouse(100, 200, bego::Coordinate::Abs); });
+    measure("move rel", iterations, [&] { bego.move_mouse(5, -5, bego::Coordinate::Rel); });
+    measure("location", iterations, [&] { bego.location(); });
+    measure("main_display", iterations, [&] { bego.main_display(); });
+
+    return 0;
+}
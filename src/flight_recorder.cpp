@@ -0,0 +1,396 @@
+#include "../include/bego_flight.h"
+#include "../include/bego.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @file flight_recorder.cpp
+ * @author Eterninety
+ * @brief Lock-free ring of dispatched events, flight dumps and the dump handlers
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace bego {
+
+namespace {
+
+constexpr char FLIGHT_MAGIC[8] = {'B', 'E', 'G', 'O', 'F', 'L', 'T', '\0'};
+constexpr uint32_t FLIGHT_VERSION = 1;
+
+/**
+ * @brief Records written per write() call by the signal-safe dump
+ */
+constexpr size_t DUMP_CHUNK = 64;
+
+/**
+ * @brief Path used by the dump handlers, fixed before any handler can run
+ */
+char handler_path[4096];
+
+int64_t steady_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int64_t system_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+#ifdef _WIN32
+
+LONG WINAPI dump_on_exception(EXCEPTION_POINTERS*) {
+    if (FlightRecorder* recorder = FlightRecorder::active()) {
+        recorder->dump_signal_safe(handler_path);
+    }
+    return EXCEPTION_CONTINUE_SEARCH;
+}
+
+#else
+
+void dump_on_request(int) {
+    int saved = errno;
+    if (FlightRecorder* recorder = FlightRecorder::active()) {
+        recorder->dump_signal_safe(handler_path);
+    }
+    errno = saved;
+}
+
+void dump_on_crash(int signal) {
+    if (FlightRecorder* recorder = FlightRecorder::active()) {
+        recorder->dump_signal_safe(handler_path);
+    }
+    // The handler was reset to the default action on entry, so this terminates as the crash would have
+    raise(signal);
+}
+
+#endif
+
+} // namespace
+
+std::atomic<FlightRecorder*> FlightRecorder::current{nullptr};
+
+/**
+ * @brief Creates a recorder
+ *
+ * @details All slots are allocated and touched here, so recording never
+ * allocates or faults in a fresh page.
+ *
+ * @param capacity Number of events kept, rounded up to a power of two
+ */
+FlightRecorder::FlightRecorder(size_t capacity) {
+    size_t size = 2;
+    while (size < capacity) {
+        size *= 2;
+    }
+    slots = std::make_unique<Slot[]>(size);
+    mask = size - 1;
+}
+
+/**
+ * @brief Records a dispatched batch
+ *
+ * @details One atomic add claims the sequence numbers of the whole batch. Each
+ * slot is then written seqlock style: an odd stamp first, the fields, and the
+ * final stamp with release order, so a reader that sees the final stamp before
+ * and after copying has a consistent record.
+ *
+ * @param events Pointer to the first event
+ * @param count Number of events
+ * @param origin The call that dispatched them
+ */
+void FlightRecorder::record(const Event* events, size_t count, EventOrigin origin) {
+    if (count == 0) {
+        return;
+    }
+
+    const int64_t now = steady_ns();
+    const uint64_t first = next_sequence.fetch_add(count, std::memory_order_acq_rel);
+
+    for (size_t i = 0; i < count; i++) {
+        const uint64_t sequence = first + i;
+        Slot& slot = slots[sequence & mask];
+        uint64_t bits;
+        std::memcpy(&bits, &events[i], sizeof(bits));
+
+        slot.stamp.store(2 * sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.timestamp.store(now, std::memory_order_relaxed);
+        slot.event.store(bits, std::memory_order_relaxed);
+        slot.origin.store(static_cast<uint64_t>(origin), std::memory_order_relaxed);
+        slot.stamp.store(2 * sequence + 2, std::memory_order_release);
+    }
+}
+
+/**
+ * @brief Copies one slot if it still holds the given sequence number
+ *
+ * @details Uses atomics only, so it is safe in a signal handler.
+ *
+ * @param sequence The sequence number wanted
+ * @param out Receives the record
+ * @return bool False if the slot is being written or holds another event
+ */
+bool FlightRecorder::read(uint64_t sequence, FlightRecord& out) const {
+    const Slot& slot = slots[sequence & mask];
+    const uint64_t expected = 2 * sequence + 2;
+
+    if (slot.stamp.load(std::memory_order_acquire) != expected) {
+        return false;
+    }
+    int64_t timestamp = slot.timestamp.load(std::memory_order_relaxed);
+    uint64_t bits = slot.event.load(std::memory_order_relaxed);
+    uint64_t origin = slot.origin.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.stamp.load(std::memory_order_relaxed) != expected) {
+        return false;
+    }
+
+    out = FlightRecord{};
+    out.sequence = sequence;
+    out.timestamp = timestamp;
+    std::memcpy(&out.event, &bits, sizeof(bits));
+    out.origin = static_cast<EventOrigin>(origin);
+    return true;
+}
+
+/**
+ * @brief Copies the recorded events, oldest first
+ *
+ * @param out Receives the records
+ */
+void FlightRecorder::snapshot(std::vector<FlightRecord>& out) const {
+    const uint64_t end = next_sequence.load(std::memory_order_acquire);
+    const uint64_t begin = end > capacity() ? end - capacity() : 0;
+
+    out.clear();
+    out.reserve(end - begin);
+    FlightRecord record;
+    for (uint64_t sequence = begin; sequence < end; sequence++) {
+        if (read(sequence, record)) {
+            out.push_back(record);
+        }
+    }
+}
+
+/**
+ * @brief Builds the header of a dump taken now
+ *
+ * @param count Number of records that follow
+ * @return FlightDumpHeader The header
+ */
+FlightDumpHeader FlightRecorder::header(uint64_t count) const {
+    FlightDumpHeader header{};
+    std::memcpy(header.magic, FLIGHT_MAGIC, sizeof(header.magic));
+    header.version = FLIGHT_VERSION;
+    header.record_size = sizeof(FlightRecord);
+    header.record_count = count;
+    header.next_sequence = next_sequence.load(std::memory_order_acquire);
+    header.steady_time = steady_ns();
+    header.system_time = system_ns();
+    return header;
+}
+
+/**
+ * @brief Writes a flight dump
+ *
+ * @param path The file to write
+ * @throws InputError If the file cannot be written
+ */
+void FlightRecorder::dump(const std::string& path) const {
+    std::vector<FlightRecord> records;
+    snapshot(records);
+    FlightDumpHeader head = header(records.size());
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&head), sizeof(head));
+    out.write(reinterpret_cast<const char*>(records.data()),
+              static_cast<std::streamsize>(records.size() * sizeof(FlightRecord)));
+    if (!out) {
+        throw InputError(InputError::Type::InvalidInput, "Cannot write flight dump " + path);
+    }
+}
+
+/**
+ * @brief Writes a flight dump with async-signal-safe calls only
+ *
+ * @details Records are staged in a small buffer on the stack and written in
+ * chunks. The header goes first with a zero count and is rewritten at the end,
+ * so a dump cut short by a second crash still reads as a valid, empty dump.
+ *
+ * @param path The file to write
+ * @return bool False if the file could not be written
+ */
+bool FlightRecorder::dump_signal_safe(const char* path) const {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    auto put = [file](const void* data, size_t size) {
+        DWORD written = 0;
+        return WriteFile(file, data, static_cast<DWORD>(size), &written, nullptr) && written == size;
+    };
+#else
+    int file = ::open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (file < 0) {
+        return false;
+    }
+    auto put = [file](const void* data, size_t size) {
+        const char* bytes = static_cast<const char*>(data);
+        while (size > 0) {
+            ssize_t written = ::write(file, bytes, size);
+            if (written <= 0) {
+                return false;
+            }
+            bytes += written;
+            size -= static_cast<size_t>(written);
+        }
+        return true;
+    };
+#endif
+
+    FlightDumpHeader head = header(0);
+    bool ok = put(&head, sizeof(head));
+
+    const uint64_t end = head.next_sequence;
+    const uint64_t begin = end > capacity() ? end - capacity() : 0;
+    FlightRecord chunk[DUMP_CHUNK];
+    size_t staged = 0;
+    uint64_t count = 0;
+
+    for (uint64_t sequence = begin; ok && sequence < end; sequence++) {
+        if (read(sequence, chunk[staged])) {
+            staged++;
+            count++;
+        }
+        if (staged == DUMP_CHUNK || (sequence + 1 == end && staged > 0)) {
+            ok = put(chunk, staged * sizeof(FlightRecord));
+            staged = 0;
+        }
+    }
+
+    // Rewrite the header with the final count
+    if (ok) {
+        head.record_count = count;
+#ifdef _WIN32
+        ok = SetFilePointer(file, 0, nullptr, FILE_BEGIN) == 0 && put(&head, sizeof(head));
+#else
+        ok = ::pwrite(file, &head, sizeof(head), 0) == static_cast<ssize_t>(sizeof(head));
+#endif
+    }
+
+#ifdef _WIN32
+    CloseHandle(file);
+#else
+    ::close(file);
+#endif
+    return ok;
+}
+
+/**
+ * @brief Starts the process-wide recorder
+ *
+ * @details The recorder is never destroyed, so a Bego dispatching or a handler
+ * dumping while the process exits cannot see it disappear.
+ *
+ * @param capacity Number of events kept
+ * @return FlightRecorder& The process-wide recorder
+ */
+FlightRecorder& FlightRecorder::start(size_t capacity) {
+    static FlightRecorder* instance = new FlightRecorder(capacity);
+    current.store(instance, std::memory_order_release);
+    return *instance;
+}
+
+/**
+ * @brief Stops recording into the process-wide recorder
+ */
+void FlightRecorder::stop() {
+    current.store(nullptr, std::memory_order_release);
+}
+
+/**
+ * @brief Installs the handlers that dump the process-wide recorder
+ *
+ * @param path The file to write
+ * @throws InputError If the path is too long or no recorder was started
+ */
+void FlightRecorder::install_dump_handlers(const std::string& path) {
+    if (path.size() >= sizeof(handler_path)) {
+        throw InputError(InputError::Type::InvalidInput, "The flight dump path is too long");
+    }
+    if (!active()) {
+        throw InputError(InputError::Type::InvalidInput, "The flight recorder has not been started");
+    }
+    std::memcpy(handler_path, path.c_str(), path.size() + 1);
+
+#ifdef _WIN32
+    SetUnhandledExceptionFilter(dump_on_exception);
+#else
+    struct sigaction request {};
+    request.sa_handler = dump_on_request;
+    request.sa_flags = SA_RESTART;
+    sigemptyset(&request.sa_mask);
+    sigaction(SIGUSR1, &request, nullptr);
+
+    struct sigaction crash {};
+    crash.sa_handler = dump_on_crash;
+    crash.sa_flags = SA_RESETHAND | SA_NODEFER;
+    sigemptyset(&crash.sa_mask);
+    for (int signal : {SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT}) {
+        sigaction(signal, &crash, nullptr);
+    }
+#endif
+}
+
+/**
+ * @brief Reads a flight dump
+ *
+ * @param path The file to read
+ * @param header Receives the header
+ * @return std::vector<FlightRecord> The records, oldest first
+ * @throws InputError If the file cannot be read or is not a flight dump
+ */
+std::vector<FlightRecord> FlightRecorder::load(const std::string& path, FlightDumpHeader& header) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        throw InputError(InputError::Type::InvalidInput, "Cannot read flight dump " + path);
+    }
+    if (std::memcmp(header.magic, FLIGHT_MAGIC, sizeof(FLIGHT_MAGIC)) != 0 || header.version != FLIGHT_VERSION ||
+        header.record_size != sizeof(FlightRecord)) {
+        throw InputError(InputError::Type::InvalidInput, path + " is not a flight dump");
+    }
+
+    in.seekg(0, std::ios::end);
+    uint64_t available = (static_cast<uint64_t>(in.tellg()) - sizeof(header)) / sizeof(FlightRecord);
+    if (header.record_count > available) {
+        throw InputError(InputError::Type::InvalidInput, "Flight dump " + path + " is truncated");
+    }
+
+    std::vector<FlightRecord> records(header.record_count);
+    in.seekg(sizeof(header));
+    in.read(reinterpret_cast<char*>(records.data()),
+            static_cast<std::streamsize>(records.size() * sizeof(FlightRecord)));
+    if (!in) {
+        throw InputError(InputError::Type::InvalidInput, "Cannot read flight dump " + path);
+    }
+    return records;
+}
+
+} // namespace bego
@@ -0,0 +1,124 @@
+#include "../include/bego_hold.h"
+#include "../include/bego_log.h"
+#include <exception>
+
+/**
+ * @file hold_scheduler.cpp
+ * @author Eterninety
+ * @brief Implementation of the deadline scheduler for timed holds
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace bego {
+
+/**
+ * @brief Constructor for the HoldScheduler class
+ *
+ * @details The worker thread is not started here. Most programs never use timed holds,
+ * so the thread is only spawned when the first deadline is scheduled.
+ *
+ * @param on_release Callback invoked for every expired deadline
+ */
+HoldScheduler::HoldScheduler(ReleaseCallback on_release)
+    : on_release(std::move(on_release)) {
+}
+
+/**
+ * @brief Destructor for the HoldScheduler class
+ *
+ * @details Wakes the worker thread, asks it to exit and joins it. Pending deadlines
+ * are dropped; the owner is responsible for releasing anything that is still held.
+ */
+HoldScheduler::~HoldScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeup.notify_all();
+
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Schedules a release at the given deadline
+ *
+ * @details The entry is pushed onto the min-heap and the worker is woken only if the
+ * new deadline became the earliest one; otherwise its current sleep is still correct.
+ *
+ * @param target The input to release
+ * @param deadline When to release it
+ * @param ticket Opaque value handed back to the callback
+ */
+void HoldScheduler::schedule(const HoldTarget& target, Clock::time_point deadline, uint64_t ticket) {
+    bool earliest;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (!worker.joinable()) {
+            worker = std::thread(&HoldScheduler::run, this);
+        }
+
+        deadlines.push(Entry{deadline, next_order++, target, ticket});
+        earliest = deadlines.top().order == next_order - 1;
+    }
+
+    if (earliest) {
+        wakeup.notify_one();
+    }
+}
+
+/**
+ * @brief Gets the number of deadlines that have not fired yet
+ *
+ * @return size_t The number of pending deadlines
+ */
+size_t HoldScheduler::pending() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return deadlines.size();
+}
+
+/**
+ * @brief Worker loop of the scheduler thread
+ *
+ * @details Sleeps until the earliest deadline (or indefinitely when the heap is empty),
+ * then pops and fires every entry that is due. The callback runs without the scheduler
+ * lock held so it can take the owner's locks and even schedule new deadlines.
+ * Errors raised by the callback are swallowed: there is nobody to report them to on
+ * this thread, and one failed release must not stop the others.
+ */
+void HoldScheduler::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (!stopping) {
+        if (deadlines.empty()) {
+            wakeup.wait(lock);
+            continue;
+        }
+
+        Clock::time_point next = deadlines.top().deadline;
+        if (Clock::now() < next) {
+            wakeup.wait_until(lock, next);
+            continue;
+        }
+
+        Entry entry = deadlines.top();
+        deadlines.pop();
+
+        lock.unlock();
+        try {
+            on_release(entry.target, entry.ticket);
+        } catch (const std::exception&) {
+            BEGO_LOG(Warning, "Timed release of target {}:{} (ticket {}) failed", entry.target.kind, entry.target.code,
+                     entry.ticket);
+        }
+        lock.lock();
+    }
+}
+
+} // namespace bego
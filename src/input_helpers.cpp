@@ -1,4 +1,8 @@
 #include "../include/bego_win.h"
+#include "../include/bego_log.h"
+#include "../include/bego_metrics.h"
+#include "../include/bego_probes.h"
+#include <algorithm>
 #include <stdexcept>
 
 /**
@@ -14,6 +18,18 @@
 
 namespace bego {
 
+namespace {
+
+/**
+ * @brief The calling thread's INPUT buffer; it keeps its capacity between calls
+ */
+std::vector<INPUT>& scratch_inputs() {
+    thread_local std::vector<INPUT> scratch;
+    return scratch;
+}
+
+} // namespace
+
 /**
  * @brief The core function that sends input events directly to the Windows input system
  * 
@@ -42,17 +58,146 @@ void send_input(const std::vector<INPUT>& input) {
     
     // Send input events to the system
     // Use const_cast to remove const qualifier as SendInput requires LPINPUT (non-const)
+    BEGO_PROBE1(send_input_entry, input_len);
     UINT result = SendInput(input_len, const_cast<LPINPUT>(input.data()), input_size);
     
+    // Get the last error code before anything else can overwrite it
+    DWORD error_code = result != input_len ? GetLastError() : 0;
+    BEGO_PROBE3(send_input_return, input_len, result, error_code);
+    
     if (result != input_len) {
-        // Get the last error code
-        DWORD error_code = GetLastError();
+        if (metrics::enabled()) {
+            metrics::record_short_send();
+        }
+        BEGO_LOG(Error, "SendInput inserted {} of {} inputs, error code {}", result, input_len, error_code);
         throw InputError(InputError::Type::Simulate, 
             "Not all input events were sent. They may have been blocked by UIPI. Error code: " + 
             std::to_string(error_code));
     }
 }
 
+/**
+ * @brief Expands compact events into INPUT structures
+ * 
+ * @details This is the kernel run at dispatch time. Each 8-byte Event becomes
+ * one INPUT; keyboard flags are stored with the KEYEVENTF_* bit values so they
+ * are copied as they are, and mouse buttons are translated through small lookup
+ * tables instead of a switch per direction.
+ * 
+ * @param events Pointer to the first event
+ * @param count Number of events
+ * @param dw_extra_info Custom marker value (typically 0x12345678)
+ * @param out Destination array with room for count INPUT structures
+ * @throws InputError If an event has an unknown kind or refers to an unknown mouse button
+ */
+void expand_events(const Event* events, size_t count, size_t dw_extra_info, INPUT* out) {
+    // Indexed by Button: Left, Middle, Right, Back, Forward
+    static constexpr DWORD button_down[] = {
+        MOUSEEVENTF_LEFTDOWN, MOUSEEVENTF_MIDDLEDOWN, MOUSEEVENTF_RIGHTDOWN, MOUSEEVENTF_XDOWN, MOUSEEVENTF_XDOWN
+    };
+    static constexpr DWORD button_up[] = {
+        MOUSEEVENTF_LEFTUP, MOUSEEVENTF_MIDDLEUP, MOUSEEVENTF_RIGHTUP, MOUSEEVENTF_XUP, MOUSEEVENTF_XUP
+    };
+    static constexpr int button_data[] = { 0, 0, 0, 1, 2 };
+    constexpr size_t button_count = sizeof(button_data) / sizeof(button_data[0]);
+    
+    for (size_t i = 0; i < count; ++i) {
+        const Event& event = events[i];
+        
+        switch (event.kind) {
+            case EventKind::KeyDown:
+                out[i] = create_keybd_event(event.flags, event.code,
+                                            static_cast<WORD>(event.payload), dw_extra_info);
+                break;
+            case EventKind::KeyUp:
+                out[i] = create_keybd_event(event.flags | KEYEVENTF_KEYUP, event.code,
+                                            static_cast<WORD>(event.payload), dw_extra_info);
+                break;
+            case EventKind::ButtonDown:
+            case EventKind::ButtonUp: {
+                if (event.code >= button_count) {
+                    throw InputError(InputError::Type::InvalidInput, "Invalid button type");
+                }
+                DWORD flags = event.kind == EventKind::ButtonDown ? button_down[event.code] : button_up[event.code];
+                out[i] = create_mouse_event(flags, button_data[event.code], 0, 0, dw_extra_info);
+                break;
+            }
+            case EventKind::MoveAbs:
+                out[i] = create_mouse_event(MOUSEEVENTF_MOVE | MOUSEEVENTF_ABSOLUTE, 0,
+                                            event.x(), event.y(), dw_extra_info);
+                break;
+            case EventKind::MoveRel:
+                out[i] = create_mouse_event(MOUSEEVENTF_MOVE, 0, event.x(), event.y(), dw_extra_info);
+                break;
+            case EventKind::Wheel:
+                out[i] = create_mouse_event(MOUSEEVENTF_WHEEL, event.wheel_data(), 0, 0, dw_extra_info);
+                break;
+            case EventKind::HWheel:
+                out[i] = create_mouse_event(MOUSEEVENTF_HWHEEL, event.wheel_data(), 0, 0, dw_extra_info);
+                break;
+            default:
+                throw InputError(InputError::Type::InvalidInput, "Invalid event kind");
+        }
+    }
+}
+
+/**
+ * @brief Expands compact events and sends them in a single SendInput call
+ * 
+ * @details The INPUT structures only exist for the duration of the call. They
+ * are written into a per-thread scratch buffer that keeps its capacity, so
+ * steady-state dispatch does not allocate.
+ * 
+ * @param events Pointer to the first event
+ * @param count Number of events
+ * @param dw_extra_info Custom marker value (typically 0x12345678)
+ * @throws InputError If not all inputs could be sent (e.g., blocked by UIPI)
+ */
+void send_events(const Event* events, size_t count, size_t dw_extra_info) {
+    if (count == 0) {
+        return;
+    }
+    
+    std::vector<INPUT>& scratch = scratch_inputs();
+    scratch.resize(count);
+    
+    expand_events(events, count, dw_extra_info, scratch.data());
+    send_input(scratch);
+}
+
+/**
+ * @brief Constructor for the Win32Backend class
+ * 
+ * @param dw_extra_info Marker value written to the dwExtraInfo field of every event
+ */
+Win32Backend::Win32Backend(size_t dw_extra_info)
+    : dw_extra_info(dw_extra_info) {
+}
+
+/**
+ * @brief Expands the events and sends them in a single SendInput call
+ * 
+ * @param events Pointer to the first event
+ * @param count Number of events
+ * @throws InputError If not all events were sent
+ */
+void Win32Backend::dispatch(const Event* events, size_t count) {
+    send_events(events, count, dw_extra_info);
+}
+
+/**
+ * @brief Sizes the calling thread's INPUT scratch buffer
+ * 
+ * @details The buffer is reserved and written once, so later dispatches from
+ * this thread neither allocate nor touch fresh pages.
+ * 
+ * @param max_batch The largest batch that will be dispatched
+ */
+void Win32Backend::prepare(size_t max_batch) {
+    std::vector<INPUT>& scratch = scratch_inputs();
+    scratch.assign(std::max(max_batch, scratch.size()), INPUT{});
+}
+
 /**
  * @brief Creates a mouse INPUT structure with specified parameters
  * 
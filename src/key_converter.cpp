@@ -2,6 +2,9 @@
 #include <Windows.h>
 #include <unordered_map>
 #include <stdexcept>
+#include <iterator>
+#include <algorithm>
+#include <string>
 
 /**
  * @file key_converter.cpp
@@ -234,4 +237,154 @@ Key vk_to_key(WORD vk) {
     }
 }
 
+namespace {
+
+/**
+ * @brief A name and the value it stands for
+ */
+template <typename T>
+struct NamedValue {
+    const char* name;
+    T value;
+};
+
+/**
+ * @brief Canonical key names, in Key enum order
+ */
+const NamedValue<Key> key_names[] = {
+    {"A", Key::A}, {"B", Key::B}, {"C", Key::C}, {"D", Key::D}, {"E", Key::E}, {"F", Key::F},
+    {"G", Key::G}, {"H", Key::H}, {"I", Key::I}, {"J", Key::J}, {"K", Key::K}, {"L", Key::L},
+    {"M", Key::M}, {"N", Key::N}, {"O", Key::O}, {"P", Key::P}, {"Q", Key::Q}, {"R", Key::R},
+    {"S", Key::S}, {"T", Key::T}, {"U", Key::U}, {"V", Key::V}, {"W", Key::W}, {"X", Key::X},
+    {"Y", Key::Y}, {"Z", Key::Z},
+    {"Num0", Key::Num0}, {"Num1", Key::Num1}, {"Num2", Key::Num2}, {"Num3", Key::Num3}, {"Num4", Key::Num4}, {"Num5", Key::Num5},
+    {"Num6", Key::Num6}, {"Num7", Key::Num7}, {"Num8", Key::Num8}, {"Num9", Key::Num9},
+    {"F1", Key::F1}, {"F2", Key::F2}, {"F3", Key::F3}, {"F4", Key::F4}, {"F5", Key::F5}, {"F6", Key::F6},
+    {"F7", Key::F7}, {"F8", Key::F8}, {"F9", Key::F9}, {"F10", Key::F10}, {"F11", Key::F11}, {"F12", Key::F12},
+    {"F13", Key::F13}, {"F14", Key::F14}, {"F15", Key::F15}, {"F16", Key::F16}, {"F17", Key::F17}, {"F18", Key::F18},
+    {"F19", Key::F19}, {"F20", Key::F20}, {"F21", Key::F21}, {"F22", Key::F22}, {"F23", Key::F23}, {"F24", Key::F24},
+    {"Return", Key::Return}, {"Tab", Key::Tab}, {"Space", Key::Space}, {"Backspace", Key::Backspace}, {"Escape", Key::Escape}, {"Delete", Key::Delete},
+    {"CapsLock", Key::CapsLock},
+    {"Control", Key::Control}, {"Alt", Key::Alt}, {"Shift", Key::Shift}, {"Super", Key::Super}, {"RightControl", Key::RightControl}, {"RightAlt", Key::RightAlt},
+    {"RightShift", Key::RightShift}, {"RightSuper", Key::RightSuper},
+    {"Up", Key::Up}, {"Down", Key::Down}, {"Left", Key::Left}, {"Right", Key::Right}, {"Home", Key::Home}, {"End", Key::End},
+    {"PageUp", Key::PageUp}, {"PageDown", Key::PageDown}, {"Insert", Key::Insert},
+    {"Numpad0", Key::Numpad0}, {"Numpad1", Key::Numpad1}, {"Numpad2", Key::Numpad2}, {"Numpad3", Key::Numpad3}, {"Numpad4", Key::Numpad4}, {"Numpad5", Key::Numpad5},
+    {"Numpad6", Key::Numpad6}, {"Numpad7", Key::Numpad7}, {"Numpad8", Key::Numpad8}, {"Numpad9", Key::Numpad9},
+    {"NumpadMultiply", Key::NumpadMultiply}, {"NumpadAdd", Key::NumpadAdd}, {"NumpadSubtract", Key::NumpadSubtract}, {"NumpadDivide", Key::NumpadDivide}, {"NumpadDecimal", Key::NumpadDecimal},
+    {"PrintScreen", Key::PrintScreen}, {"ScrollLock", Key::ScrollLock}, {"Pause", Key::Pause}, {"Menu", Key::Menu}, {"Unicode", Key::Unicode},
+};
+
+/**
+ * @brief Alternative key names accepted by key_from_name()
+ */
+const NamedValue<Key> key_aliases[] = {
+    {"0", Key::Num0}, {"1", Key::Num1}, {"2", Key::Num2}, {"3", Key::Num3}, {"4", Key::Num4},
+    {"5", Key::Num5}, {"6", Key::Num6}, {"7", Key::Num7}, {"8", Key::Num8}, {"9", Key::Num9},
+    {"Enter", Key::Return}, {"Esc", Key::Escape}, {"Del", Key::Delete}, {"Ctrl", Key::Control},
+    {"Win", Key::Super}, {"Meta", Key::Super}, {"RightCtrl", Key::RightControl},
+    {"RightWin", Key::RightSuper}, {"PgUp", Key::PageUp}, {"PgDn", Key::PageDown},
+    {"Ins", Key::Insert}, {"Caps", Key::CapsLock}, {"Apps", Key::Menu}
+};
+
+/**
+ * @brief Button names, including the X1/X2 aliases
+ */
+const NamedValue<Button> button_names[] = {
+    {"Left", Button::Left}, {"Middle", Button::Middle}, {"Right", Button::Right},
+    {"Back", Button::Back}, {"Forward", Button::Forward}, {"X1", Button::Back},
+    {"X2", Button::Forward}, {"ScrollUp", Button::ScrollUp}, {"ScrollDown", Button::ScrollDown},
+    {"ScrollLeft", Button::ScrollLeft}, {"ScrollRight", Button::ScrollRight}
+};
+
+/**
+ * @brief Lowercase ASCII letters; std::tolower would consult the locale on every call
+ */
+char fold_case(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+/**
+ * @brief Compare a name against a table entry, ignoring ASCII case
+ */
+bool same_name(std::string_view name, const char* entry) {
+    size_t i = 0;
+    for (; i < name.size() && entry[i] != '\0'; i++) {
+        if (fold_case(name[i]) != fold_case(entry[i])) {
+            return false;
+        }
+    }
+    return i == name.size() && entry[i] == '\0';
+}
+
+/**
+ * @brief Find a name in a table
+ */
+template <typename T, size_t N>
+std::optional<T> find_name(const NamedValue<T> (&table)[N], std::string_view name) {
+    for (const auto& entry : table) {
+        if (same_name(name, entry.name)) {
+            return entry.value;
+        }
+    }
+    return std::nullopt;
+}
+
+} // namespace
+
+/**
+ * @brief Looks up a key by name
+ * 
+ * @details Canonical enumerator names take precedence over the aliases. The
+ * comparison ignores ASCII case so scripts and command lines can use any spelling.
+ * 
+ * @param name The key name
+ * @return std::optional<Key> The key, or std::nullopt if the name is unknown
+ */
+std::optional<Key> key_from_name(std::string_view name) {
+    // Bulk importers look up a name per event, so the tables are indexed once
+    static const std::unordered_map<std::string, Key> index = [] {
+        std::unordered_map<std::string, Key> map;
+        auto add = [&map](const auto& table) {
+            for (const auto& entry : table) {
+                std::string folded(entry.name);
+                std::transform(folded.begin(), folded.end(), folded.begin(), fold_case);
+                map.emplace(std::move(folded), entry.value);  // Canonical names win over aliases
+            }
+        };
+        add(key_names);
+        add(key_aliases);
+        return map;
+    }();
+
+    std::string folded(name);
+    std::transform(folded.begin(), folded.end(), folded.begin(), fold_case);
+    auto found = index.find(folded);
+    if (found == index.end()) {
+        return std::nullopt;
+    }
+    return found->second;
+}
+
+/**
+ * @brief Gets the canonical name of a key
+ * 
+ * @param key The key
+ * @return const char* The enumerator name, or "Unknown" for out-of-range values
+ */
+const char* key_name(Key key) {
+    size_t index = static_cast<size_t>(key);
+    return index < std::size(key_names) ? key_names[index].name : "Unknown";
+}
+
+/**
+ * @brief Looks up a mouse button by name
+ * 
+ * @param name The button name, compared ignoring ASCII case
+ * @return std::optional<Button> The button, or std::nullopt if the name is unknown
+ */
+std::optional<Button> button_from_name(std::string_view name) {
+    return find_name(button_names, name);
+}
+
 } // namespace bego 
\ No newline at end of file
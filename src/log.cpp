@@ -0,0 +1,599 @@
+#include "../include/bego_log.h"
+#include "../include/bego.h"
+#include "../include/bego_per_thread.h"
+#include <algorithm>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <unordered_map>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define BEGO_LOG_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BEGO_LOG_TSC 1
+#endif
+
+/**
+ * @file log.cpp
+ * @author Eterninety
+ * @brief Per-thread log rings, the format table, collection and the log file format
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace bego {
+namespace log {
+
+namespace {
+
+constexpr char LOG_MAGIC[8] = {'B', 'E', 'G', 'O', 'L', 'O', 'G', '\0'};
+constexpr uint32_t LOG_VERSION = 1;
+
+/**
+ * @brief Rings of exited threads kept for collection before further ones are discarded
+ */
+constexpr size_t MAX_CLOSED_RINGS = 64;
+
+/**
+ * @struct LogFileHeader
+ * @brief The first 32 bytes of a binary log file
+ * @details Followed by entries, each a tag byte and its body: 'F' for a format, 'R' for a Record
+ */
+struct LogFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    int64_t origin;
+    int64_t steady_time;
+    int64_t system_time;
+};
+
+int64_t steady_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int64_t system_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Timestamp source of the hot path: the time stamp counter where there is one
+ * @details Converted to steady clock time when collected, by interpolating between
+ * the anchor taken when logging was enabled and a reading taken at collection.
+ */
+inline int64_t ticks() {
+#ifdef BEGO_LOG_TSC
+    return static_cast<int64_t>(__rdtsc());
+#else
+    return steady_ns();
+#endif
+}
+
+/**
+ * @brief What is kept of the rings of exited threads
+ */
+struct ClosedRings {
+    size_t waiting = 0;    ///< Closed rings still holding records for the next collection
+    uint64_t dropped = 0;  ///< Records dropped by rings that were freed
+};
+
+/// Number given to the next thread that gets a ring
+std::atomic<uint32_t> next_thread{1};
+
+/**
+ * @brief One thread's ring; the thread writes head, collection writes tail
+ */
+struct Ring {
+    std::atomic<uint64_t> head{0};
+    uint64_t cached_tail = 0;             ///< Producer's copy of tail, refreshed when the ring looks full
+    std::atomic<uint64_t> dropped{0};
+    uint32_t thread = next_thread.fetch_add(1, std::memory_order_relaxed);
+    bool closed = false;                  ///< The thread exited; guarded by the ring registry mutex
+    alignas(64) std::atomic<uint64_t> tail{0};
+    alignas(64) std::array<Record, RING_RECORDS> records{};
+
+    // At thread exit: an empty ring is freed at once; one with records waits for the
+    // next collection, unless too many are already waiting
+    bool retire(ClosedRings& rings) {
+        const uint64_t pending = head.load(std::memory_order_acquire) - tail.load(std::memory_order_relaxed);
+        if (pending == 0 || rings.waiting >= MAX_CLOSED_RINGS) {
+            rings.dropped += dropped.load(std::memory_order_relaxed) + pending;
+            return true;
+        }
+        closed = true;
+        rings.waiting++;
+        return false;
+    }
+};
+
+/**
+ * @brief Every thread's ring
+ */
+using Rings = bego::detail::ThreadRegistry<Ring, ClosedRings>;
+
+/**
+ * @brief The format table and the clock anchor
+ */
+struct Registry {
+    std::mutex anchor_mutex;
+
+    std::mutex formats_mutex;
+    std::deque<Format> formats{Format()};  ///< ID 0 is never handed out
+
+    std::mutex collect_mutex;
+    std::vector<Record> batch;
+
+    std::atomic<int64_t> anchor_ticks{0};
+    std::atomic<int64_t> anchor_ns{0};
+};
+
+Registry& registry() {
+    // Never destroyed, like the ring registry, so late log calls still find their formats
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+const char* level_name(Level level) {
+    static const char* names[] = {"DEBUG", "INFO", "WARN", "ERROR", "OFF"};
+    size_t index = static_cast<size_t>(level);
+    return index < std::size(names) ? names[index] : "?";
+}
+
+void format_arg(std::ostringstream& out, ArgType type, uint64_t word) {
+    switch (type) {
+        case ArgType::Signed:
+            out << static_cast<int64_t>(word);
+            break;
+        case ArgType::Unsigned:
+            out << word;
+            break;
+        case ArgType::Double: {
+            double value;
+            std::memcpy(&value, &word, sizeof(value));
+            out << value;
+            break;
+        }
+        case ArgType::Bool:
+            out << (word ? "true" : "false");
+            break;
+        case ArgType::Pointer:
+            out << "0x" << std::hex << word << std::dec;
+            break;
+    }
+}
+
+template <typename T>
+void put(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+bool get(std::istream& in, T& value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+/**
+ * @brief State of a binary sink: the file and which formats it already holds
+ */
+struct BinaryFile {
+    std::ofstream out;
+    std::vector<bool> written;
+};
+
+} // namespace
+
+/**
+ * @brief Sets the lowest level that is logged
+ *
+ * @details The first time logging is enabled the tick counter is anchored to the
+ * steady clock; collected timestamps are interpolated from there.
+ *
+ * @param threshold The lowest level logged, or Level::Off
+ */
+void set_level(Level threshold) {
+    Registry& r = registry();
+    if (threshold != Level::Off && r.anchor_ns.load(std::memory_order_acquire) == 0) {
+        std::lock_guard<std::mutex> lock(r.anchor_mutex);
+        if (r.anchor_ns.load(std::memory_order_relaxed) == 0) {
+            r.anchor_ticks.store(ticks(), std::memory_order_relaxed);
+            r.anchor_ns.store(steady_ns(), std::memory_order_release);
+        }
+    }
+    detail::minimum.store(static_cast<uint8_t>(threshold), std::memory_order_release);
+}
+
+/**
+ * @brief Gets the lowest level that is logged
+ *
+ * @return Level The threshold
+ */
+Level level() {
+    return static_cast<Level>(detail::minimum.load(std::memory_order_relaxed));
+}
+
+/**
+ * @brief Gets a registered format
+ *
+ * @param id The format ID of a record
+ * @return Format A copy of the format
+ * @throws InputError If no format has this ID
+ */
+Format format(uint16_t id) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.formats_mutex);
+    if (id == 0 || id >= r.formats.size()) {
+        throw InputError(InputError::Type::InvalidInput, "Unknown log format " + std::to_string(id));
+    }
+    return r.formats[id];
+}
+
+namespace detail {
+
+/**
+ * @brief Registers a call site's format
+ *
+ * @details Two threads reaching a new site at once both end up here; the second
+ * finds the ID the first stored and uses it.
+ *
+ * @param site The call site
+ * @param text Format string
+ * @param types Argument types
+ * @param count Number of arguments
+ * @return uint16_t The format ID, or 0 if the table is full
+ */
+uint16_t define(Site& site, const char* text, const ArgType* types, size_t count) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.formats_mutex);
+
+    uint16_t id = site.format.load(std::memory_order_relaxed);
+    if (id != 0 || r.formats.size() > UINT16_MAX) {
+        return id;
+    }
+
+    Format format;
+    format.level = site.level;
+    format.count = static_cast<uint8_t>(count);
+    std::copy(types, types + count, format.types.begin());
+    format.text = text;
+    format.file = site.file;
+    format.file.erase(0, format.file.find_last_of("/\\") + 1);
+    format.line = site.line;
+
+    id = static_cast<uint16_t>(r.formats.size());
+    r.formats.push_back(std::move(format));
+    site.format.store(id, std::memory_order_release);
+    return id;
+}
+
+/**
+ * @brief Writes a record into the calling thread's ring
+ *
+ * @details The ring has a single producer, so claiming a slot is a plain load of
+ * head; tail is only read again when the ring looks full. A full ring drops the
+ * record instead of waiting for collection.
+ *
+ * @param format The format ID, 0 if the site could not be registered
+ * @param args Raw argument words, zero past count
+ * @param count Number of arguments
+ */
+void append(uint16_t format, const std::array<uint64_t, MAX_ARGS>& args, size_t count) {
+    if (format == 0) {
+        return;
+    }
+
+    Ring& ring = Rings::local();
+    const uint64_t head = ring.head.load(std::memory_order_relaxed);
+    if (head - ring.cached_tail >= RING_RECORDS) {
+        ring.cached_tail = ring.tail.load(std::memory_order_acquire);
+        if (head - ring.cached_tail >= RING_RECORDS) {
+            bego::detail::bump(ring.dropped);
+            return;
+        }
+    }
+
+    Record& record = ring.records[head & (RING_RECORDS - 1)];
+    record.timestamp = ticks();
+    record.format = format;
+    record.count = static_cast<uint8_t>(count);
+    record.thread = ring.thread;
+    record.args = args;
+    ring.head.store(head + 1, std::memory_order_release);
+}
+
+} // namespace detail
+
+/**
+ * @brief Drains every thread's ring and hands the records to a sink
+ *
+ * @details The rings are copied out under the ring registry lock, which is all a
+ * thread starting or exiting can wait on; conversion, sorting and the sink run
+ * after it is released. Rings of exited threads are freed once drained.
+ *
+ * @param sink Receives the records, if there are any
+ * @return size_t Number of records collected
+ */
+size_t collect(const std::function<void(const Record* records, size_t count)>& sink) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> collecting(r.collect_mutex);
+    std::vector<Record>& batch = r.batch;
+    batch.clear();
+
+    {
+        Rings& rings = Rings::get();
+        std::lock_guard<std::mutex> lock(rings.mutex);
+        for (auto it = rings.live.begin(); it != rings.live.end();) {
+            Ring* ring = *it;
+            const uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+            const uint64_t head = ring->head.load(std::memory_order_acquire);
+            for (uint64_t i = tail; i < head; i++) {
+                batch.push_back(ring->records[i & (RING_RECORDS - 1)]);
+            }
+            ring->tail.store(head, std::memory_order_release);
+
+            if (ring->closed) {
+                rings.retired.dropped += ring->dropped.load(std::memory_order_relaxed);
+                rings.retired.waiting--;
+                delete ring;
+                it = rings.live.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    if (batch.empty()) {
+        return 0;
+    }
+
+    // Interpolate between the anchor and now; without a tick counter this is the identity
+    const int64_t anchor_ticks = r.anchor_ticks.load(std::memory_order_relaxed);
+    const int64_t anchor_ns = r.anchor_ns.load(std::memory_order_acquire);
+    const int64_t now_ticks = ticks();
+    const int64_t now_ns = steady_ns();
+    const double ns_per_tick =
+        now_ticks > anchor_ticks ? static_cast<double>(now_ns - anchor_ns) / (now_ticks - anchor_ticks) : 1.0;
+
+    for (Record& record : batch) {
+        record.timestamp = anchor_ns + static_cast<int64_t>((record.timestamp - anchor_ticks) * ns_per_tick);
+        record.reserved = 0;
+    }
+    std::stable_sort(batch.begin(), batch.end(),
+                     [](const Record& a, const Record& b) { return a.timestamp < b.timestamp; });
+
+    sink(batch.data(), batch.size());
+    return batch.size();
+}
+
+/**
+ * @brief Gets the number of records dropped because a ring was full
+ *
+ * @return uint64_t Dropped records since the process started
+ */
+uint64_t dropped() {
+    Rings& rings = Rings::get();
+    std::lock_guard<std::mutex> lock(rings.mutex);
+
+    uint64_t total = rings.retired.dropped;
+    for (const Ring* ring : rings.live) {
+        total += ring->dropped.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+/**
+ * @brief Gets the time logging was first enabled
+ *
+ * @return int64_t Steady clock nanoseconds, or 0 if logging was never enabled
+ */
+int64_t origin() {
+    return registry().anchor_ns.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Formats a record as one line of text
+ *
+ * @details The line holds the time in seconds since origin, the thread, the level,
+ * the call site and the message. Placeholders without an argument are kept as they are.
+ *
+ * @param format The record's format
+ * @param record The record
+ * @param origin Steady clock nanoseconds the printed time counts from
+ * @return std::string The line, without a line break
+ */
+std::string render(const Format& format, const Record& record, int64_t origin) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(6) << (record.timestamp - origin) / 1e9 << std::defaultfloat << " T"
+        << record.thread << ' ' << level_name(format.level) << ' ' << format.file << ':' << format.line << "  ";
+
+    size_t arg = 0;
+    size_t position = 0;
+    for (;;) {
+        size_t placeholder = format.text.find("{}", position);
+        if (placeholder == std::string::npos || arg >= MAX_ARGS || arg >= format.count || arg >= record.count) {
+            out << format.text.substr(position);
+            break;
+        }
+        out << format.text.substr(position, placeholder - position);
+        format_arg(out, format.types[arg], record.args[arg]);
+        arg++;
+        position = placeholder + 2;
+    }
+    return out.str();
+}
+
+/**
+ * @brief Reads a binary log file
+ *
+ * @param path The file to read
+ * @return LogFile Its formats and records
+ * @throws InputError If the file cannot be read, is not a log file or is corrupt
+ */
+LogFile load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    LogFileHeader header;
+    if (!get(in, header)) {
+        throw InputError(InputError::Type::InvalidInput, "Cannot read log file " + path);
+    }
+    if (std::memcmp(header.magic, LOG_MAGIC, sizeof(LOG_MAGIC)) != 0 || header.version != LOG_VERSION ||
+        header.record_size != sizeof(Record)) {
+        throw InputError(InputError::Type::InvalidInput, path + " is not a log file");
+    }
+
+    LogFile file;
+    file.origin = header.origin;
+    file.steady_time = header.steady_time;
+    file.system_time = header.system_time;
+
+    auto truncated = [&path] {
+        return InputError(InputError::Type::InvalidInput, "Log file " + path + " is truncated");
+    };
+    auto corrupt = [&path] {
+        return InputError(InputError::Type::InvalidInput, "Log file " + path + " is corrupt");
+    };
+
+    // Nothing in the file can be longer than the file itself
+    in.seekg(0, std::ios::end);
+    const uint64_t file_size = static_cast<uint64_t>(in.tellg());
+    in.seekg(sizeof(header));
+
+    char tag;
+    while (in.get(tag)) {
+        if (tag == 'R') {
+            Record record;
+            if (!get(in, record)) {
+                throw truncated();
+            }
+            // render() indexes the arguments by count
+            if (record.count > MAX_ARGS) {
+                throw corrupt();
+            }
+            file.records.push_back(record);
+        } else if (tag == 'F') {
+            uint16_t id;
+            Format format;
+            uint32_t line, name_size, text_size;
+            if (!get(in, id) || !get(in, format.level) || !get(in, format.count) || !get(in, format.types) ||
+                !get(in, line) || !get(in, name_size) || !get(in, text_size)) {
+                throw truncated();
+            }
+            if (format.count > MAX_ARGS) {
+                throw corrupt();
+            }
+            if (uint64_t(name_size) + text_size > file_size) {
+                throw truncated();
+            }
+            format.line = static_cast<int>(line);
+            format.file.resize(name_size);
+            format.text.resize(text_size);
+            if (!in.read(format.file.data(), name_size) || !in.read(format.text.data(), text_size)) {
+                throw truncated();
+            }
+            if (file.formats.size() <= id) {
+                file.formats.resize(id + size_t(1));
+            }
+            file.formats[id] = std::move(format);
+        } else {
+            throw corrupt();
+        }
+    }
+    return file;
+}
+
+/**
+ * @brief Starts the collector thread
+ *
+ * @param interval Time between two collections
+ * @param sink Receives the records
+ */
+Collector::Collector(std::chrono::milliseconds interval, Sink sink)
+    : sink(std::move(sink)), worker(interval, [this] { collect(this->sink); }) {
+}
+
+/**
+ * @brief Creates a sink that formats records as text lines
+ *
+ * @param out The stream to write
+ * @return Sink The sink
+ */
+Collector::Sink Collector::to_stream(std::ostream& out) {
+    auto formats = std::make_shared<std::unordered_map<uint16_t, Format>>();
+
+    return [&out, formats](const Record* records, size_t count) {
+        const int64_t from = origin();
+        for (size_t i = 0; i < count; i++) {
+            auto found = formats->find(records[i].format);
+            if (found == formats->end()) {
+                found = formats->emplace(records[i].format, format(records[i].format)).first;
+            }
+            out << render(found->second, records[i], from) << '\n';
+        }
+        out.flush();
+    };
+}
+
+/**
+ * @brief Creates a sink that writes records to a binary log file
+ *
+ * @details Each format is written once, before the first record that uses it.
+ *
+ * @param path The file to create
+ * @return Sink The sink
+ * @throws InputError If the file cannot be created
+ */
+Collector::Sink Collector::to_binary(const std::string& path) {
+    auto file = std::make_shared<BinaryFile>();
+    file->out.open(path, std::ios::binary | std::ios::trunc);
+
+    LogFileHeader header{};
+    std::memcpy(header.magic, LOG_MAGIC, sizeof(header.magic));
+    header.version = LOG_VERSION;
+    header.record_size = sizeof(Record);
+    header.origin = origin();
+    header.steady_time = steady_ns();
+    header.system_time = system_ns();
+    put(file->out, header);
+    file->out.flush();
+    if (!file->out) {
+        throw InputError(InputError::Type::InvalidInput, "Cannot create log file " + path);
+    }
+
+    return [file](const Record* records, size_t count) {
+        std::ostream& out = file->out;
+        for (size_t i = 0; i < count; i++) {
+            const uint16_t id = records[i].format;
+            if (file->written.size() <= id) {
+                file->written.resize(id + size_t(1));
+            }
+            if (!file->written[id]) {
+                const Format found = format(id);
+                out.put('F');
+                put(out, id);
+                put(out, found.level);
+                put(out, found.count);
+                put(out, found.types);
+                put(out, static_cast<uint32_t>(found.line));
+                put(out, static_cast<uint32_t>(found.file.size()));
+                put(out, static_cast<uint32_t>(found.text.size()));
+                out.write(found.file.data(), static_cast<std::streamsize>(found.file.size()));
+                out.write(found.text.data(), static_cast<std::streamsize>(found.text.size()));
+                file->written[id] = true;
+            }
+            out.put('R');
+            put(out, records[i]);
+        }
+        out.flush();
+    };
+}
+
+} // namespace log
+} // namespace bego
@@ -0,0 +1,354 @@
+#include "../include/bego_macro.h"
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BEGO_MACRO_SSE2 1
+#endif
+
+/**
+ * @file macro_buffer.cpp
+ * @author Eterninety
+ * @brief Implementation of column-oriented macro buffers and their SIMD editing kernels
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace bego {
+
+namespace {
+
+/**
+ * @brief Magic constant for exact int64 <-> double conversion of values below 2^51
+ * @details Adding 1.5 * 2^52 moves the integer into the mantissa, so the conversion is
+ * an integer add plus a reinterpretation. SSE2 has no packed int64 <-> double instructions.
+ */
+constexpr double MAGIC = 6755399441055744.0;  // 1.5 * 2^52
+
+/**
+ * @brief Index of the lowest set bit of a non-zero value
+ * @param bits The value to scan
+ * @return unsigned The bit index
+ */
+inline unsigned lowest_bit(unsigned bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctz(bits));
+#else
+    unsigned index = 0;
+    while (!(bits & 1u)) {
+        bits >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+
+} // namespace
+
+/**
+ * @brief Reserves room in every column
+ *
+ * @param count Number of events to reserve room for
+ */
+void MacroBuffer::reserve(size_t count) {
+    ts.reserve(count);
+    kind_column.reserve(count);
+    flag_column.reserve(count);
+    code_column.reserve(count);
+    x_column.reserve(count);
+    y_column.reserve(count);
+}
+
+/**
+ * @brief Removes all events
+ */
+void MacroBuffer::clear() {
+    resize(0);
+}
+
+/**
+ * @brief Resizes every column to the same length
+ *
+ * @param count The new number of events
+ */
+void MacroBuffer::resize(size_t count) {
+    ts.resize(count);
+    kind_column.resize(count);
+    flag_column.resize(count);
+    code_column.resize(count);
+    x_column.resize(count);
+    y_column.resize(count);
+}
+
+/**
+ * @brief Appends an event, unpacking its payload into the x and y columns
+ *
+ * @param timestamp Nanoseconds from the start of the macro
+ * @param event The event to append
+ */
+void MacroBuffer::push_back(int64_t timestamp, const Event& event) {
+    int32_t x = 0;
+    int32_t y = 0;
+
+    switch (event.kind) {
+        case EventKind::MoveAbs:
+        case EventKind::MoveRel:
+            x = event.x();
+            y = event.y();
+            break;
+        case EventKind::Wheel:
+        case EventKind::HWheel:
+            x = event.wheel_data();
+            break;
+        case EventKind::KeyDown:
+        case EventKind::KeyUp:
+            x = static_cast<int32_t>(event.payload);
+            break;
+        case EventKind::ButtonDown:
+        case EventKind::ButtonUp:
+            break;
+    }
+
+    ts.push_back(timestamp);
+    kind_column.push_back(event.kind);
+    flag_column.push_back(event.flags);
+    code_column.push_back(event.code);
+    x_column.push_back(x);
+    y_column.push_back(y);
+}
+
+/**
+ * @brief Rebuilds the compact event at an index
+ *
+ * @param index Position of the event
+ * @return Event The event, with coordinates clamped to the compact range
+ */
+Event MacroBuffer::event(size_t index) const {
+    EventKind kind = kind_column[index];
+
+    switch (kind) {
+        case EventKind::MoveAbs:
+            return Event::move(true, x_column[index], y_column[index]);
+        case EventKind::MoveRel:
+            return Event::move(false, x_column[index], y_column[index]);
+        default:
+            return Event{kind, flag_column[index], code_column[index], static_cast<uint32_t>(x_column[index])};
+    }
+}
+
+/**
+ * @brief Adds an offset to every timestamp
+ *
+ * @details Two timestamps per SSE2 register; the scalar tail handles the rest.
+ *
+ * @param offset Nanoseconds to add (may be negative)
+ */
+void MacroBuffer::shift_time(int64_t offset) {
+    int64_t* t = ts.data();
+    size_t n = ts.size();
+    size_t i = 0;
+
+#ifdef BEGO_MACRO_SSE2
+    const __m128i add = _mm_set1_epi64x(offset);
+    for (; i + 4 <= n; i += 4) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t + i + 2));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(t + i), _mm_add_epi64(a, add));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(t + i + 2), _mm_add_epi64(b, add));
+    }
+#endif
+
+    for (; i < n; ++i) {
+        t[i] += offset;
+    }
+}
+
+/**
+ * @brief Stretches or compresses time around an origin
+ *
+ * @details The distance from the origin is converted to double with the magic
+ * number trick (exact below 2^51), scaled, and converted back the same way,
+ * which rounds to nearest-even just like the scalar std::nearbyint() tail.
+ *
+ * @param factor Scale factor; 2.0 makes the macro twice as slow
+ * @param origin Timestamp that stays in place
+ */
+void MacroBuffer::scale_time(double factor, int64_t origin) {
+    int64_t* t = ts.data();
+    size_t n = ts.size();
+    size_t i = 0;
+
+#ifdef BEGO_MACRO_SSE2
+    const __m128i magic_bits = _mm_castpd_si128(_mm_set1_pd(MAGIC));
+    const __m128d magic = _mm_set1_pd(MAGIC);
+    const __m128d scale = _mm_set1_pd(factor);
+    const __m128i base = _mm_set1_epi64x(origin);
+
+    for (; i + 2 <= n; i += 2) {
+        __m128i v = _mm_sub_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(t + i)), base);
+        __m128d d = _mm_sub_pd(_mm_castsi128_pd(_mm_add_epi64(v, magic_bits)), magic);
+        d = _mm_add_pd(_mm_mul_pd(d, scale), magic);
+        v = _mm_sub_epi64(_mm_castpd_si128(d), magic_bits);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(t + i), _mm_add_epi64(v, base));
+    }
+#endif
+
+    for (; i < n; ++i) {
+        t[i] = origin + static_cast<int64_t>(std::nearbyint(static_cast<double>(t[i] - origin) * factor));
+    }
+}
+
+/**
+ * @brief Applies an affine transform to mouse coordinates
+ *
+ * @details Four rows per iteration: the kind bytes are widened to 32-bit lanes and
+ * compared against MoveAbs and MoveRel to build blend masks, both transforms are
+ * computed in single precision and the right one is selected per lane.
+ *
+ * @param scale_x Horizontal scale factor
+ * @param scale_y Vertical scale factor
+ * @param offset_x Horizontal offset applied to absolute moves
+ * @param offset_y Vertical offset applied to absolute moves
+ */
+void MacroBuffer::transform_coordinates(float scale_x, float scale_y, float offset_x, float offset_y) {
+    const EventKind* k = kind_column.data();
+    int32_t* xs = x_column.data();
+    int32_t* ys = y_column.data();
+    size_t n = ts.size();
+    size_t i = 0;
+
+#ifdef BEGO_MACRO_SSE2
+    const __m128i abs_kind = _mm_set1_epi32(static_cast<int>(EventKind::MoveAbs));
+    const __m128i rel_kind = _mm_set1_epi32(static_cast<int>(EventKind::MoveRel));
+    const __m128 sx = _mm_set1_ps(scale_x);
+    const __m128 sy = _mm_set1_ps(scale_y);
+    const __m128 ox = _mm_set1_ps(offset_x);
+    const __m128 oy = _mm_set1_ps(offset_y);
+    const __m128i zero = _mm_setzero_si128();
+
+    for (; i + 4 <= n; i += 4) {
+        int32_t packed_kinds;
+        std::memcpy(&packed_kinds, k + i, sizeof(packed_kinds));
+        __m128i kinds = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed_kinds), zero), zero);
+
+        __m128i is_abs = _mm_cmpeq_epi32(kinds, abs_kind);
+        __m128i is_rel = _mm_cmpeq_epi32(kinds, rel_kind);
+        if (_mm_movemask_epi8(_mm_or_si128(is_abs, is_rel)) == 0) {
+            continue;
+        }
+
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(xs + i));
+        __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ys + i));
+        __m128 fx = _mm_mul_ps(_mm_cvtepi32_ps(x), sx);
+        __m128 fy = _mm_mul_ps(_mm_cvtepi32_ps(y), sy);
+
+        __m128i rel_x = _mm_cvtps_epi32(fx);
+        __m128i rel_y = _mm_cvtps_epi32(fy);
+        __m128i abs_x = _mm_cvtps_epi32(_mm_add_ps(fx, ox));
+        __m128i abs_y = _mm_cvtps_epi32(_mm_add_ps(fy, oy));
+
+        __m128i keep = _mm_andnot_si128(_mm_or_si128(is_abs, is_rel), _mm_set1_epi32(-1));
+        x = _mm_or_si128(_mm_and_si128(keep, x),
+                         _mm_or_si128(_mm_and_si128(is_abs, abs_x), _mm_and_si128(is_rel, rel_x)));
+        y = _mm_or_si128(_mm_and_si128(keep, y),
+                         _mm_or_si128(_mm_and_si128(is_abs, abs_y), _mm_and_si128(is_rel, rel_y)));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(xs + i), x);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(ys + i), y);
+    }
+#endif
+
+    for (; i < n; ++i) {
+        if (k[i] == EventKind::MoveAbs) {
+            xs[i] = static_cast<int32_t>(std::nearbyint(static_cast<float>(xs[i]) * scale_x + offset_x));
+            ys[i] = static_cast<int32_t>(std::nearbyint(static_cast<float>(ys[i]) * scale_y + offset_y));
+        } else if (k[i] == EventKind::MoveRel) {
+            xs[i] = static_cast<int32_t>(std::nearbyint(static_cast<float>(xs[i]) * scale_x));
+            ys[i] = static_cast<int32_t>(std::nearbyint(static_cast<float>(ys[i]) * scale_y));
+        }
+    }
+}
+
+/**
+ * @brief Keeps only events whose kind is in a mask, preserving order
+ *
+ * @details Sixteen kind bytes are tested at once against every kept kind to
+ * produce a 16-bit selection mask. Fully selected blocks are moved as a whole (or
+ * skipped while nothing has been dropped yet), fully rejected blocks cost nothing,
+ * and mixed blocks are compacted row by row.
+ *
+ * @param kind_mask Bitwise OR of kind_bit() values to keep
+ * @return size_t The number of events removed
+ */
+size_t MacroBuffer::filter_kinds(uint32_t kind_mask) {
+    const size_t n = ts.size();
+    int64_t* t = ts.data();
+    EventKind* k = kind_column.data();
+    uint8_t* f = flag_column.data();
+    uint16_t* c = code_column.data();
+    int32_t* xs = x_column.data();
+    int32_t* ys = y_column.data();
+
+    size_t write = 0;
+    size_t i = 0;
+
+    auto move_rows = [&](size_t from, size_t to, size_t count) {
+        std::memmove(t + to, t + from, count * sizeof(*t));
+        std::memmove(k + to, k + from, count * sizeof(*k));
+        std::memmove(f + to, f + from, count * sizeof(*f));
+        std::memmove(c + to, c + from, count * sizeof(*c));
+        std::memmove(xs + to, xs + from, count * sizeof(*xs));
+        std::memmove(ys + to, ys + from, count * sizeof(*ys));
+    };
+
+#ifdef BEGO_MACRO_SSE2
+    for (; i + 16 <= n; i += 16) {
+        __m128i kinds = _mm_loadu_si128(reinterpret_cast<const __m128i*>(k + i));
+        __m128i selected = _mm_setzero_si128();
+        for (uint32_t kind = 0; kind < EVENT_KIND_COUNT; ++kind) {
+            if (kind_mask & (1u << kind)) {
+                selected = _mm_or_si128(selected, _mm_cmpeq_epi8(kinds, _mm_set1_epi8(static_cast<char>(kind))));
+            }
+        }
+
+        unsigned bits = static_cast<unsigned>(_mm_movemask_epi8(selected));
+        if (bits == 0xFFFF) {
+            if (write != i) {
+                move_rows(i, write, 16);
+            }
+            write += 16;
+            continue;
+        }
+
+        while (bits != 0) {
+            size_t row = i + lowest_bit(bits);
+            bits &= bits - 1;
+            t[write] = t[row];
+            k[write] = k[row];
+            f[write] = f[row];
+            c[write] = c[row];
+            xs[write] = xs[row];
+            ys[write] = ys[row];
+            ++write;
+        }
+    }
+#endif
+
+    for (; i < n; ++i) {
+        if (kind_mask & kind_bit(k[i])) {
+            if (write != i) {
+                move_rows(i, write, 1);
+            }
+            ++write;
+        }
+    }
+
+    resize(write);
+    return n - write;
+}
+
+} // namespace bego
@@ -0,0 +1,139 @@
+#include "../include/bego_mapped_file.h"
+#include "../include/bego.h"
+#include <utility>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @file mapped_file.cpp
+ * @author Eterninety
+ * @brief Implementation of read-only memory-mapped files
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace bego {
+
+/**
+ * @brief Maps a whole file read-only
+ *
+ * @details The file handle is closed right after mapping; the mapping keeps the
+ * contents reachable. Empty files give an empty mapping since they cannot be mapped.
+ *
+ * @param path The file to map
+ * @throws InputError If the file cannot be opened or mapped
+ */
+MappedFile::MappedFile(const std::string& path) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw InputError(InputError::Type::InvalidInput, "Cannot open " + path);
+    }
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size)) {
+        CloseHandle(file);
+        throw InputError(InputError::Type::InvalidInput, "Cannot read the size of " + path);
+    }
+    if (file_size.QuadPart == 0) {
+        CloseHandle(file);
+        return;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) {
+        throw InputError(InputError::Type::InvalidInput, "Cannot map " + path);
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (view == nullptr) {
+        throw InputError(InputError::Type::InvalidInput, "Cannot map " + path);
+    }
+
+    base = static_cast<const uint8_t*>(view);
+    length = static_cast<size_t>(file_size.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw InputError(InputError::Type::InvalidInput, "Cannot open " + path);
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw InputError(InputError::Type::InvalidInput, "Cannot read the size of " + path);
+    }
+    if (info.st_size == 0) {
+        ::close(fd);
+        return;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        throw InputError(InputError::Type::InvalidInput, "Cannot map " + path);
+    }
+
+    base = static_cast<const uint8_t*>(view);
+    length = static_cast<size_t>(info.st_size);
+#endif
+}
+
+/**
+ * @brief Destructor - unmaps the file
+ */
+MappedFile::~MappedFile() {
+    close();
+}
+
+/**
+ * @brief Move constructor - takes over the mapping
+ */
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : base(std::exchange(other.base, nullptr)), length(std::exchange(other.length, 0)) {
+}
+
+/**
+ * @brief Move assignment - releases the current mapping and takes over the other
+ */
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        base = std::exchange(other.base, nullptr);
+        length = std::exchange(other.length, 0);
+    }
+    return *this;
+}
+
+/**
+ * @brief Unmaps the file
+ */
+void MappedFile::close() {
+    if (base == nullptr) {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(base);
+#else
+    munmap(const_cast<uint8_t*>(base), length);
+#endif
+
+    base = nullptr;
+    length = 0;
+}
+
+} // namespace bego
@@ -0,0 +1,299 @@
+#include "../include/bego_metrics.h"
+#include "../include/bego_per_thread.h"
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+/**
+ * @file metrics.cpp
+ * @author Eterninety
+ * @brief Per-thread dispatch counters, their aggregation and Prometheus export
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace fs = std::filesystem;
+
+namespace bego {
+namespace metrics {
+
+namespace {
+
+std::atomic<bool> recording{false};
+
+using detail::bump;
+
+/**
+ * @brief The counters of one thread
+ * @details Only the owning thread writes, through bump(), so recording never waits.
+ */
+struct alignas(64) ThreadCounters {
+    std::array<std::atomic<uint64_t>, EVENT_KIND_COUNT> events{};
+    std::atomic<uint64_t> batches{0};
+    std::atomic<uint64_t> failures{0};
+    std::atomic<uint64_t> short_sends{0};
+    std::array<std::atomic<uint64_t>, BATCH_BUCKETS> batch_sizes{};
+    std::atomic<uint64_t> batch_events{0};
+    std::array<std::atomic<uint64_t>, LATENCY_BUCKETS> latency{};
+    std::atomic<uint64_t> latency_ns{0};
+
+    void add_to(Snapshot& totals) const {
+        for (size_t i = 0; i < EVENT_KIND_COUNT; i++) {
+            totals.events[i] += events[i].load(std::memory_order_relaxed);
+        }
+        totals.batches += batches.load(std::memory_order_relaxed);
+        totals.failures += failures.load(std::memory_order_relaxed);
+        totals.short_sends += short_sends.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < BATCH_BUCKETS; i++) {
+            totals.batch_sizes[i] += batch_sizes[i].load(std::memory_order_relaxed);
+        }
+        totals.batch_events += batch_events.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < LATENCY_BUCKETS; i++) {
+            totals.latency[i] += latency[i].load(std::memory_order_relaxed);
+        }
+        totals.latency_ns += latency_ns.load(std::memory_order_relaxed);
+    }
+
+    // At thread exit: the totals carry the counts on, the block is freed
+    bool retire(Snapshot& retired) const {
+        add_to(retired);
+        return true;
+    }
+};
+
+/**
+ * @brief Every live thread's counters, plus the totals of threads that have exited
+ */
+using Registry = detail::ThreadRegistry<ThreadCounters, Snapshot>;
+
+ThreadCounters& local() {
+    return Registry::local();
+}
+
+size_t batch_bucket(size_t count) {
+    size_t bucket = 0;
+    while (bucket < BATCH_BUCKETS - 1 && (size_t(1) << bucket) < count) {
+        bucket++;
+    }
+    return bucket;
+}
+
+size_t latency_bucket(int64_t ns) {
+    return std::lower_bound(LATENCY_BOUNDS.begin(), LATENCY_BOUNDS.end(), ns) - LATENCY_BOUNDS.begin();
+}
+
+void family(std::ostringstream& out, const char* name, const char* type, const char* help) {
+    out << "# HELP " << name << ' ' << help << "\n# TYPE " << name << ' ' << type << '\n';
+}
+
+/**
+ * @brief Replaces a file with a text, through a temporary file and a rename
+ */
+void write_text(const std::string& path, const std::string& text) {
+    std::string temporary = path + ".tmp";
+
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        out.write(text.data(), static_cast<std::streamsize>(text.size()));
+        if (!out) {
+            out.close();
+            std::error_code error;
+            fs::remove(temporary, error);
+            throw InputError(InputError::Type::InvalidInput, "Cannot write metrics to " + path);
+        }
+    }
+
+    std::error_code error;
+    fs::rename(temporary, path, error);
+    if (error) {
+        fs::remove(temporary, error);
+        throw InputError(InputError::Type::InvalidInput, "Cannot write metrics to " + path);
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Turns recording on or off for the whole process
+ *
+ * @param on Whether to record
+ */
+void enable(bool on) {
+    recording.store(on, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Checks whether recording is on
+ *
+ * @return bool True if dispatches are being recorded
+ */
+bool enabled() {
+    return recording.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Records one batch handed to a backend
+ *
+ * @details Counting by kind is a single pass over the batch into a local array,
+ * folded into the thread's counters once per batch rather than once per event.
+ * Events of an unknown kind are skipped.
+ *
+ * @param events Pointer to the first event
+ * @param count Number of events
+ * @param latency_ns How long the backend took
+ * @param delivered False if the backend threw
+ */
+void record_dispatch(const Event* events, size_t count, int64_t latency_ns, bool delivered) {
+    ThreadCounters& counters = local();
+
+    if (delivered) {
+        std::array<uint64_t, EVENT_KIND_COUNT> kinds{};
+        for (size_t i = 0; i < count; i++) {
+            // A backend may accept kinds this table has no row for; they are not counted
+            const size_t kind = static_cast<size_t>(events[i].kind);
+            if (kind < EVENT_KIND_COUNT) {
+                kinds[kind]++;
+            }
+        }
+        for (size_t i = 0; i < EVENT_KIND_COUNT; i++) {
+            if (kinds[i] != 0) {
+                bump(counters.events[i], kinds[i]);
+            }
+        }
+    } else {
+        bump(counters.failures);
+    }
+
+    bump(counters.batches);
+    bump(counters.batch_sizes[batch_bucket(count)]);
+    bump(counters.batch_events, count);
+    bump(counters.latency[latency_bucket(latency_ns)]);
+    bump(counters.latency_ns, static_cast<uint64_t>(latency_ns));
+}
+
+/**
+ * @brief Records a SendInput call that inserted fewer events than it was given
+ */
+void record_short_send() {
+    bump(local().short_sends);
+}
+
+/**
+ * @brief Adds up the counters of every thread
+ *
+ * @details Each counter is read atomically, but the threads keep counting while
+ * they are read, so related totals (events and batches) may be a batch apart.
+ *
+ * @return Snapshot The totals since the process started
+ */
+Snapshot snapshot() {
+    Registry& r = Registry::get();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    Snapshot totals = r.retired;
+    for (const ThreadCounters* counters : r.live) {
+        counters->add_to(totals);
+    }
+    return totals;
+}
+
+/**
+ * @brief Formats totals in the Prometheus text exposition format
+ *
+ * @param totals The totals to format
+ * @return std::string The metrics
+ */
+std::string to_prometheus(const Snapshot& totals) {
+    static const char* kind_names[EVENT_KIND_COUNT] = {
+        "key_down", "key_up", "button_down", "button_up", "move_abs", "move_rel", "wheel", "hwheel"
+    };
+
+    std::ostringstream out;
+
+    family(out, "bego_events_total", "counter", "Events delivered to the backend, by kind.");
+    for (size_t i = 0; i < EVENT_KIND_COUNT; i++) {
+        out << "bego_events_total{kind=\"" << kind_names[i] << "\"} " << totals.events[i] << '\n';
+    }
+
+    family(out, "bego_batches_total", "counter", "Batches handed to the backend.");
+    out << "bego_batches_total " << totals.batches << '\n';
+
+    family(out, "bego_dispatch_failures_total", "counter", "Batches whose dispatch failed.");
+    out << "bego_dispatch_failures_total " << totals.failures << '\n';
+
+    family(out, "bego_short_sends_total", "counter", "SendInput calls that inserted fewer events than given.");
+    out << "bego_short_sends_total " << totals.short_sends << '\n';
+
+    family(out, "bego_batch_size", "histogram", "Events per batch.");
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < BATCH_BUCKETS; i++) {
+        cumulative += totals.batch_sizes[i];
+        out << "bego_batch_size_bucket{le=\"";
+        if (i + 1 < BATCH_BUCKETS) {
+            out << (size_t(1) << i);
+        } else {
+            out << "+Inf";
+        }
+        out << "\"} " << cumulative << '\n';
+    }
+    out << "bego_batch_size_sum " << totals.batch_events << '\n';
+    out << "bego_batch_size_count " << totals.batches << '\n';
+
+    family(out, "bego_dispatch_latency_seconds", "histogram", "Time the backend took per batch.");
+    cumulative = 0;
+    for (size_t i = 0; i < LATENCY_BUCKETS; i++) {
+        cumulative += totals.latency[i];
+        out << "bego_dispatch_latency_seconds_bucket{le=\"";
+        if (i < LATENCY_BOUNDS.size()) {
+            out << LATENCY_BOUNDS[i] / 1e9;
+        } else {
+            out << "+Inf";
+        }
+        out << "\"} " << cumulative << '\n';
+    }
+    out << "bego_dispatch_latency_seconds_sum " << std::fixed << std::setprecision(9) << totals.latency_ns / 1e9
+        << '\n';
+    out << "bego_dispatch_latency_seconds_count " << totals.batches << '\n';
+
+    return out.str();
+}
+
+/**
+ * @brief Writes the current totals to a file in the Prometheus text format
+ *
+ * @param path The file to write
+ * @throws InputError If the file cannot be written
+ */
+void write_prometheus(const std::string& path) {
+    write_text(path, to_prometheus(snapshot()));
+}
+
+/**
+ * @brief Starts the exporter thread
+ *
+ * @param interval Time between two exports
+ * @param sink Receives the text
+ */
+Exporter::Exporter(std::chrono::milliseconds interval, Sink sink)
+    : sink(std::move(sink)), worker(interval, [this] { this->sink(to_prometheus(snapshot())); }) {
+}
+
+/**
+ * @brief Creates a sink that replaces a file with every export
+ *
+ * @param path The file to write
+ * @return Sink The sink
+ */
+Exporter::Sink Exporter::to_file(std::string path) {
+    return [path = std::move(path)](const std::string& text) { write_text(path, text); };
+}
+
+} // namespace metrics
+} // namespace bego
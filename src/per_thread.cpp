@@ -0,0 +1,59 @@
+#include "../include/bego_per_thread.h"
+
+/**
+ * @file per_thread.cpp
+ * @author Eterninety
+ * @brief The interval worker behind the metrics exporter and the log collector
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace bego {
+namespace detail {
+
+/**
+ * @brief Starts the worker thread
+ *
+ * @param interval Time between two runs
+ * @param task The task to run
+ */
+IntervalWorker::IntervalWorker(std::chrono::milliseconds interval, std::function<void()> task)
+    : interval(interval), task(std::move(task)), worker([this] { run(); }) {
+}
+
+/**
+ * @brief Stops the worker thread after a last run
+ */
+IntervalWorker::~IntervalWorker() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    worker.join();
+}
+
+/**
+ * @brief Runs the task at every interval until stopped, then once more
+ */
+void IntervalWorker::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    bool last = false;
+
+    while (!last) {
+        last = wake.wait_for(lock, interval, [this] { return stopping; });
+        lock.unlock();
+        try {
+            task();
+        } catch (...) {
+            // A failing task must not take the worker down
+        }
+        lock.lock();
+    }
+}
+
+} // namespace detail
+} // namespace bego
@@ -0,0 +1,383 @@
+#include "../include/bego_realtime.h"
+#include "../include/bego.h"
+#include "../include/bego_log.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <sstream>
+#include <system_error>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#endif
+
+/**
+ * @file realtime.cpp
+ * @author Eterninety
+ * @brief The real-time dispatch thread, its queue and the privileges it asks for
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace bego {
+
+namespace {
+
+/**
+ * @brief Stack the dispatch thread writes before it starts, so its calls do not fault in new pages
+ */
+constexpr size_t STACK_PREFAULT = 64 * 1024;
+
+#if defined(__GNUC__)
+__attribute__((noinline))
+#elif defined(_MSC_VER)
+__declspec(noinline)
+#endif
+void prefault_stack() {
+    char pages[STACK_PREFAULT];
+    volatile char* touch = pages;
+    for (size_t i = 0; i < STACK_PREFAULT; i += 4096) {
+        touch[i] = 0;
+    }
+}
+
+std::string system_error_text(int error) {
+#ifdef _WIN32
+    return "error " + std::to_string(error);
+#else
+    return std::strerror(error);
+#endif
+}
+
+} // namespace
+
+/**
+ * @brief Summarizes the guarantees
+ *
+ * @return std::string One line per guarantee, then the notes
+ */
+std::string RealtimeGuarantees::describe() const {
+    static const char* locks[] = {"none", "queue only", "whole process"};
+
+    std::ostringstream out;
+    out << "Pinned to a CPU: " << (pinned ? "yes" : "no") << '\n'
+        << "Real-time priority: " << (realtime_priority ? "yes" : "no") << '\n'
+        << "Memory locked: " << locks[static_cast<size_t>(memory)] << '\n'
+        << "Prefaulted: " << (prefaulted ? "yes" : "no");
+    for (const std::string& note : notes) {
+        out << "\nNote: " << note;
+    }
+    return out.str();
+}
+
+/**
+ * @brief Allocates the queue and starts the dispatch thread
+ *
+ * @details The queue is allocated here and written by the dispatch thread during
+ * setup, before any memory is locked, so every page of it is resident.
+ *
+ * @param backend The backend the events are delivered to
+ * @param options What to ask for
+ * @throws InputError If the options are invalid or the thread cannot be started
+ */
+RealtimeBackend::RealtimeBackend(std::shared_ptr<Backend> backend, RealtimeOptions options)
+    : backend(std::move(backend)), options(options) {
+    if (!this->backend) {
+        throw InputError(InputError::Type::InvalidInput, "A real-time backend needs a backend to wrap");
+    }
+    if (options.queue_slots == 0 || options.max_batch == 0) {
+        throw InputError(InputError::Type::InvalidInput, "Queue slots and batch size must be positive");
+    }
+
+    slots = std::make_unique<Slot[]>(options.queue_slots);
+    storage = std::make_unique<Event[]>(options.queue_slots * options.max_batch);
+    for (size_t i = 0; i < options.queue_slots; i++) {
+        slots[i].events = storage.get() + i * options.max_batch;
+    }
+
+    try {
+        worker = std::thread([this] { run(); });
+    } catch (const std::system_error& e) {
+        throw InputError(InputError::Type::Simulate, std::string("Cannot start the dispatch thread: ") + e.what());
+    }
+
+    std::unique_lock<std::mutex> lock(sleep_mutex);
+    ready.wait(lock, [this] { return started; });
+}
+
+/**
+ * @brief Delivers what is queued, stops the dispatch thread and unlocks what it locked
+ */
+RealtimeBackend::~RealtimeBackend() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        stopping.store(true);
+    }
+    wake.notify_one();
+    worker.join();
+
+    const size_t slot_bytes = options.queue_slots * sizeof(Slot);
+    const size_t event_bytes = options.queue_slots * options.max_batch * sizeof(Event);
+#ifdef _WIN32
+    if (obtained.memory == MemoryLock::Queue) {
+        VirtualUnlock(slots.get(), slot_bytes);
+        VirtualUnlock(storage.get(), event_bytes);
+    }
+#else
+    if (obtained.memory == MemoryLock::Process) {
+        munlockall();
+    } else if (obtained.memory == MemoryLock::Queue) {
+        munlock(slots.get(), slot_bytes);
+        munlock(storage.get(), event_bytes);
+    }
+#endif
+}
+
+/**
+ * @brief Queues a batch for the dispatch thread
+ *
+ * @details Slots are claimed under a mutex held for the whole batch, so a batch
+ * split over several slots is not interleaved with another caller's. A full queue
+ * makes the caller yield until the dispatch thread frees a slot; nothing on this
+ * path allocates.
+ *
+ * @param events Pointer to the first event
+ * @param count Number of events
+ * @throws InputError With RealtimeOptions::wait, if the wrapped backend failed
+ */
+void RealtimeBackend::dispatch(const Event* events, size_t count) {
+    if (count == 0) {
+        return;
+    }
+
+    Completion completion;
+    Completion* waiting = options.wait ? &completion : nullptr;
+    completion.pending.store((count + options.max_batch - 1) / options.max_batch, std::memory_order_relaxed);
+
+    {
+        std::lock_guard<std::mutex> lock(producer_mutex);
+        for (size_t offset = 0; offset < count; offset += options.max_batch) {
+            const uint64_t sequence = next_sequence;
+            while (sequence - delivered.load(std::memory_order_acquire) >= options.queue_slots) {
+                std::this_thread::yield();
+            }
+
+            Slot& slot = slots[sequence % options.queue_slots];
+            slot.count = std::min(options.max_batch, count - offset);
+            slot.completion = waiting;
+            std::copy(events + offset, events + offset + slot.count, slot.events);
+            slot.ready.store(sequence + 1);
+            next_sequence = sequence + 1;
+
+            // Paired with the dispatch thread setting sleeping before its last look at the queue
+            if (sleeping.load()) {
+                { std::lock_guard<std::mutex> wake_lock(sleep_mutex); }
+                wake.notify_one();
+            }
+        }
+    }
+
+    if (!waiting) {
+        return;
+    }
+    while (completion.pending.load(std::memory_order_acquire) != 0) {
+        std::this_thread::yield();
+    }
+    if (completion.error) {
+        std::rethrow_exception(completion.error);
+    }
+}
+
+/**
+ * @brief Waits until everything queued so far has been delivered
+ */
+void RealtimeBackend::flush() {
+    uint64_t target;
+    {
+        std::lock_guard<std::mutex> lock(producer_mutex);
+        target = next_sequence;
+    }
+    while (delivered.load(std::memory_order_acquire) < target) {
+        std::this_thread::yield();
+    }
+}
+
+/**
+ * @brief Applies the options from the dispatch thread and records what worked
+ *
+ * @details Every step that fails is noted and skipped. Memory is locked last, so
+ * that the queue, the stack and the backend's buffers written before are resident.
+ */
+void RealtimeBackend::setup() {
+#ifdef _WIN32
+    if (options.cpu >= 0) {
+        if (options.cpu < static_cast<int>(sizeof(DWORD_PTR) * 8) &&
+            SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << options.cpu) != 0) {
+            obtained.pinned = true;
+        } else {
+            obtained.notes.push_back("Not pinned to CPU " + std::to_string(options.cpu) + ": " +
+                                     system_error_text(static_cast<int>(GetLastError())));
+        }
+    }
+    if (options.priority > 0) {
+        if (SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL)) {
+            obtained.realtime_priority = true;
+        } else {
+            obtained.notes.push_back("No time critical priority: " +
+                                     system_error_text(static_cast<int>(GetLastError())));
+        }
+    }
+#else
+    if (options.cpu >= 0) {
+        int error = EINVAL;
+        if (options.cpu < CPU_SETSIZE) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(options.cpu, &set);
+            error = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        }
+        if (error == 0) {
+            obtained.pinned = true;
+        } else {
+            obtained.notes.push_back("Not pinned to CPU " + std::to_string(options.cpu) + ": " +
+                                     system_error_text(error));
+        }
+    }
+    if (options.priority > 0) {
+        sched_param param{};
+        param.sched_priority = options.priority;
+        int error = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (error == 0) {
+            obtained.realtime_priority = true;
+        } else {
+            obtained.notes.push_back("No SCHED_FIFO priority " + std::to_string(options.priority) + ": " +
+                                     system_error_text(error));
+        }
+    }
+#endif
+
+    // Write every page the dispatch path uses
+    std::fill(storage.get(), storage.get() + options.queue_slots * options.max_batch, Event{});
+    prefault_stack();
+    try {
+        backend->prepare(options.max_batch);
+        obtained.prefaulted = true;
+    } catch (const std::exception& e) {
+        obtained.notes.push_back(std::string("The backend could not prepare: ") + e.what());
+    }
+
+    // Locking the whole process is opt-in: with MCL_FUTURE every later allocation of
+    // the host counts against RLIMIT_MEMLOCK. Either way the queue is the fallback.
+    if (options.lock_memory != MemoryLock::None) {
+        const size_t slot_bytes = options.queue_slots * sizeof(Slot);
+        const size_t event_bytes = options.queue_slots * options.max_batch * sizeof(Event);
+#ifdef _WIN32
+        if (options.lock_memory == MemoryLock::Process) {
+            obtained.notes.push_back("Process memory not locked: not supported on Windows");
+        }
+        if (VirtualLock(slots.get(), slot_bytes) && VirtualLock(storage.get(), event_bytes)) {
+            obtained.memory = MemoryLock::Queue;
+        } else {
+            obtained.notes.push_back("Queue not locked: " + system_error_text(static_cast<int>(GetLastError())));
+            VirtualUnlock(slots.get(), slot_bytes);
+        }
+#else
+        if (options.lock_memory == MemoryLock::Process) {
+            if (mlockall(MCL_CURRENT | MCL_FUTURE) == 0) {
+                obtained.memory = MemoryLock::Process;
+            } else {
+                obtained.notes.push_back("Process memory not locked: " + system_error_text(errno));
+            }
+        }
+        if (obtained.memory == MemoryLock::None) {
+            if (mlock(slots.get(), slot_bytes) == 0 && mlock(storage.get(), event_bytes) == 0) {
+                obtained.memory = MemoryLock::Queue;
+            } else {
+                obtained.notes.push_back("Queue not locked: " + system_error_text(errno));
+                munlock(slots.get(), slot_bytes);
+            }
+        }
+#endif
+    }
+
+    BEGO_LOG(Info, "real-time dispatch: pinned {}, real-time priority {}, memory lock {}, prefaulted {}",
+             obtained.pinned, obtained.realtime_priority, obtained.memory, obtained.prefaulted);
+}
+
+/**
+ * @brief Hands one slot to the wrapped backend and reports to its caller
+ *
+ * @param slot The slot to deliver
+ */
+void RealtimeBackend::deliver(Slot& slot) {
+    Completion* completion = slot.completion;
+
+    try {
+        backend->dispatch(slot.events, slot.count);
+    } catch (...) {
+        failed.store(failed.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (completion && !completion->error) {
+            completion->error = std::current_exception();
+        }
+    }
+
+    if (completion) {
+        completion->pending.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+/**
+ * @brief The dispatch thread: delivers slots in order, polling briefly before sleeping
+ */
+void RealtimeBackend::run() {
+    setup();
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        started = true;
+    }
+    ready.notify_all();
+
+    using Clock = std::chrono::steady_clock;
+    uint64_t sequence = 0;
+    Clock::time_point idle_since = Clock::now();
+    bool idle = false;
+
+    for (;;) {
+        Slot& slot = slots[sequence % options.queue_slots];
+        if (slot.ready.load(std::memory_order_acquire) == sequence + 1) {
+            deliver(slot);
+            sequence++;
+            delivered.store(sequence, std::memory_order_release);
+            idle = false;
+            continue;
+        }
+
+        if (stopping.load(std::memory_order_acquire)) {
+            return;
+        }
+        if (!idle) {
+            idle = true;
+            idle_since = Clock::now();
+            continue;
+        }
+        if (Clock::now() - idle_since < std::chrono::microseconds(options.spin_us)) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+        sleeping.store(true);
+        wake.wait(lock, [&] { return slot.ready.load() == sequence + 1 || stopping.load(); });
+        sleeping.store(false);
+        idle = false;
+    }
+}
+
+} // namespace bego
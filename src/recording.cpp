@@ -0,0 +1,603 @@
+#include "../include/bego_recording.h"
+#include "../include/bego.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @file recording.cpp
+ * @author Eterninety
+ * @brief Implementation of recording file writing and reading
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace bego {
+
+namespace {
+
+/// Segment sizes are multiples of the Windows allocation granularity, which also
+/// makes them multiples of the page size everywhere
+constexpr size_t segment_alignment = 64u << 10;
+
+constexpr char recording_magic[8] = {'B', 'E', 'G', 'O', 'R', 'E', 'C', '\0'};
+
+#ifdef _WIN32
+
+intptr_t create_file(const std::string& path) {
+    HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                                CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    return handle == INVALID_HANDLE_VALUE ? -1 : reinterpret_cast<intptr_t>(handle);
+}
+
+/**
+ * @brief Map segment index of the file, growing the file to cover it
+ */
+uint8_t* map_segment(intptr_t file, uint64_t index, size_t size) {
+    const uint64_t offset = index * size;
+    const uint64_t end = offset + size;
+    HANDLE mapping = CreateFileMappingA(reinterpret_cast<HANDLE>(file), nullptr, PAGE_READWRITE,
+                                        static_cast<DWORD>(end >> 32), static_cast<DWORD>(end), nullptr);
+    if (mapping == nullptr) {
+        return nullptr;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_WRITE, static_cast<DWORD>(offset >> 32),
+                               static_cast<DWORD>(offset), size);
+    CloseHandle(mapping);
+    return static_cast<uint8_t*>(view);
+}
+
+void unmap_segment(uint8_t* base, size_t) {
+    UnmapViewOfFile(base);
+}
+
+/**
+ * @brief Cut the file to its final size, append the trailer, write the header and close it
+ */
+bool finish_file(intptr_t file, uint64_t size, const std::vector<uint8_t>& trailer, const RecordingHeader& header) {
+    HANDLE handle = reinterpret_cast<HANDLE>(file);
+    LARGE_INTEGER position;
+    position.QuadPart = static_cast<LONGLONG>(size);
+    DWORD written = 0;
+    bool ok = SetFilePointerEx(handle, position, nullptr, FILE_BEGIN) && SetEndOfFile(handle) &&
+              (trailer.empty() || (WriteFile(handle, trailer.data(), static_cast<DWORD>(trailer.size()), &written, nullptr) &&
+                                   written == trailer.size()));
+
+    position.QuadPart = 0;
+    written = 0;
+    ok = ok && SetFilePointerEx(handle, position, nullptr, FILE_BEGIN) &&
+         WriteFile(handle, &header, sizeof(header), &written, nullptr) && written == sizeof(header);
+
+    CloseHandle(handle);
+    return ok;
+}
+
+#else
+
+intptr_t create_file(const std::string& path) {
+    return ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+}
+
+/**
+ * @brief Map segment index of the file, growing the file to cover it
+ */
+uint8_t* map_segment(intptr_t file, uint64_t index, size_t size) {
+    const off_t offset = static_cast<off_t>(index * size);
+    if (ftruncate(static_cast<int>(file), offset + static_cast<off_t>(size)) != 0) {
+        return nullptr;
+    }
+    void* view = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, static_cast<int>(file), offset);
+    return view == MAP_FAILED ? nullptr : static_cast<uint8_t*>(view);
+}
+
+void unmap_segment(uint8_t* base, size_t size) {
+    munmap(base, size);
+}
+
+/**
+ * @brief Cut the file to its final size, append the trailer, write the header and close it
+ */
+bool finish_file(intptr_t file, uint64_t size, const std::vector<uint8_t>& trailer, const RecordingHeader& header) {
+    int fd = static_cast<int>(file);
+    bool ok = ftruncate(fd, static_cast<off_t>(size)) == 0 &&
+              (trailer.empty() || pwrite(fd, trailer.data(), trailer.size(), static_cast<off_t>(size)) ==
+                                      static_cast<ssize_t>(trailer.size())) &&
+              pwrite(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header));
+    ok = ::close(fd) == 0 && ok;
+    return ok;
+}
+
+#endif
+
+/**
+ * @brief Build a header for the current state of a recording
+ */
+RecordingHeader make_header(uint64_t count, int64_t start_time, uint64_t dropped) {
+    RecordingHeader header{};
+    std::memcpy(header.magic, recording_magic, sizeof(recording_magic));
+    header.version = RecordingHeader::current_version;
+    header.record_size = sizeof(TimedEvent);
+    header.record_count = count;
+    header.start_time = start_time;
+    header.dropped = dropped;
+    return header;
+}
+
+} // namespace
+
+/**
+ * @brief Creates a recording file and maps its first segment
+ *
+ * @details The first segment starts with a header whose record count is 0, so a
+ * file left behind by a crash is recognizable as unfinished.
+ *
+ * @param path The file to write
+ * @param segment_size Bytes mapped at a time
+ * @param index_interval Records between seek index entries
+ * @throws InputError If the file cannot be created or mapped
+ */
+RecordingWriter::RecordingWriter(const std::string& path, size_t segment_size, uint64_t index_interval)
+    : path(path),
+      segment_size((segment_size + segment_alignment - 1) / segment_alignment * segment_alignment),
+      index_interval(index_interval),
+      until_index(index_interval != 0 ? 1 : 0) {
+    if (this->segment_size == 0) {
+        this->segment_size = segment_alignment;
+    }
+
+    file = create_file(path);
+    if (file == -1) {
+        throw InputError(InputError::Type::InvalidInput, "Cannot create recording " + path);
+    }
+
+    current = map_segment(file, 0, this->segment_size);
+    if (current == nullptr) {
+        finish_file(file, 0, {}, make_header(0, 0, 0));
+        file = -1;
+        throw InputError(InputError::Type::InvalidInput, "Cannot map recording " + path);
+    }
+
+    RecordingHeader header = make_header(0, 0, 0);
+    std::memcpy(current, &header, sizeof(header));
+    offset = sizeof(header);
+
+    spare_wanted = true;
+    helper = std::thread(&RecordingWriter::run, this);
+}
+
+/**
+ * @brief Destructor - finishes the file, ignoring errors
+ */
+RecordingWriter::~RecordingWriter() {
+    try {
+        close();
+    } catch (const InputError&) {
+        // Nothing sensible to do in a destructor; call close() to see errors
+    }
+}
+
+/**
+ * @brief Switches to the next segment
+ *
+ * @details Normally the helper has already mapped it and this is a pointer swap under
+ * a briefly held lock. Otherwise it waits for the helper, counting a stall.
+ *
+ * @throws InputError If the helper failed to map the segment
+ */
+void RecordingWriter::rotate() {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    if (spare == nullptr && helper_error.empty()) {
+        stall_count++;
+        ready.wait(lock, [this] { return spare != nullptr || !helper_error.empty(); });
+    }
+    if (spare == nullptr) {
+        throw InputError(InputError::Type::Simulate, helper_error);
+    }
+
+    retired.push_back(current);
+    current = spare;
+    spare = nullptr;
+    segment_index++;
+    offset = 0;
+
+    spare_wanted = true;
+    wake.notify_one();
+}
+
+/**
+ * @brief Helper thread body
+ *
+ * @details Maps the segment after the current one whenever it is requested, and
+ * unmaps retired segments, which lets the kernel write them back in its own time.
+ */
+void RecordingWriter::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    for (;;) {
+        wake.wait(lock, [this] { return stopping || spare_wanted || !retired.empty(); });
+
+        if (spare_wanted && !stopping) {
+            spare_wanted = false;
+            const uint64_t index = segment_index + 1;
+
+            lock.unlock();
+            uint8_t* segment = map_segment(file, index, segment_size);
+            lock.lock();
+
+            if (segment != nullptr) {
+                spare = segment;
+            } else {
+                helper_error = "Cannot extend recording " + path;
+            }
+            ready.notify_all();
+        }
+
+        while (!retired.empty()) {
+            uint8_t* segment = retired.back();
+            retired.pop_back();
+
+            lock.unlock();
+            unmap_segment(segment, segment_size);
+            lock.lock();
+        }
+
+        if (stopping) {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Adds a seek index entry for the record about to be appended
+ *
+ * @param timestamp Timestamp of that record
+ */
+void RecordingWriter::add_index_entry(int64_t timestamp) {
+    RecordingIndexEntry entry;
+    entry.timestamp = timestamp;
+    entry.record = count;
+    entry.snapshot_offset = static_cast<uint32_t>(snapshot_events.size());
+    state.restore(snapshot_events);
+    entry.snapshot_count = static_cast<uint32_t>(snapshot_events.size() - entry.snapshot_offset);
+    index.push_back(entry);
+    until_index = index_interval;
+}
+
+/**
+ * @brief Finishes the file
+ *
+ * @details Stops the helper, unmaps every segment, truncates the file to the header
+ * plus the records actually written, appends the seek index and stores the final header.
+ *
+ * @throws InputError If the file cannot be finished
+ */
+void RecordingWriter::close() {
+    if (file == -1) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    helper.join();
+
+    unmap_segment(current, segment_size);
+    current = nullptr;
+    if (spare != nullptr) {
+        unmap_segment(spare, segment_size);
+        spare = nullptr;
+    }
+
+    const uint64_t size = sizeof(RecordingHeader) + count * sizeof(TimedEvent);
+    RecordingHeader header = make_header(count, start_time, dropped);
+
+    // The seek index goes after the records
+    std::vector<uint8_t> trailer;
+    if (!index.empty()) {
+        const size_t entries = index.size() * sizeof(RecordingIndexEntry);
+        trailer.resize(entries + snapshot_events.size() * sizeof(Event));
+        std::memcpy(trailer.data(), index.data(), entries);
+        if (!snapshot_events.empty()) {
+            std::memcpy(trailer.data() + entries, snapshot_events.data(), snapshot_events.size() * sizeof(Event));
+        }
+        header.index_offset = size;
+        header.index_count = index.size();
+        header.snapshot_count = snapshot_events.size();
+    }
+
+    const bool ok = finish_file(file, size, trailer, header);
+    file = -1;
+
+    if (!ok) {
+        throw InputError(InputError::Type::Simulate, "Cannot finish recording " + path);
+    }
+}
+
+/**
+ * @brief Updates the state with an event
+ *
+ * @param event The event
+ */
+void HeldState::apply(const Event& event) {
+    switch (event.kind) {
+        case EventKind::KeyDown:
+            if (find(event) == held_keys.end()) {
+                held_keys.push_back(event);
+            }
+            break;
+        case EventKind::KeyUp: {
+            auto held = find(event);
+            if (held != held_keys.end()) {
+                held_keys.erase(held);
+            }
+            break;
+        }
+        case EventKind::ButtonDown:
+            if (event.code < 8) {
+                held_buttons |= static_cast<uint8_t>(1u << event.code);
+            }
+            break;
+        case EventKind::ButtonUp:
+            if (event.code < 8) {
+                held_buttons &= static_cast<uint8_t>(~(1u << event.code));
+            }
+            break;
+        case EventKind::MoveAbs:
+            absolute = true;
+            absolute_x = event.x();
+            absolute_y = event.y();
+            relative_x = relative_y = 0;
+            break;
+        case EventKind::MoveRel:
+            relative_x += event.x();
+            relative_y += event.y();
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Appends the events that change one held state into this one
+ *
+ * @param out Receives the events
+ * @param from The state to start from, or null for nothing held at the origin
+ */
+void HeldState::restore(std::vector<Event>& out, const HeldState* from) const {
+    const uint8_t from_buttons = from ? from->held_buttons : 0;
+
+    if (from) {
+        for (const Event& key : from->held_keys) {
+            if (find(key) == held_keys.end()) {
+                Event release = key;
+                release.kind = EventKind::KeyUp;
+                out.push_back(release);
+            }
+        }
+        for (uint16_t button = 0; button < 8; button++) {
+            if ((from_buttons & ~held_buttons) & (1u << button)) {
+                out.push_back(Event::button(true, static_cast<Button>(button)));
+            }
+        }
+    }
+
+    int64_t dx = relative_x;
+    int64_t dy = relative_y;
+    const bool same_base = from && from->absolute == absolute &&
+                           (!absolute || (from->absolute_x == absolute_x && from->absolute_y == absolute_y));
+    if (same_base) {
+        dx -= from->relative_x;
+        dy -= from->relative_y;
+    } else if (absolute) {
+        out.push_back(Event::move(true, absolute_x, absolute_y));
+    }
+    while (dx != 0 || dy != 0) {
+        // Split so each part fits the 16-bit relative range of an Event
+        const int64_t x = std::clamp<int64_t>(dx, -32768, 32767);
+        const int64_t y = std::clamp<int64_t>(dy, -32768, 32767);
+        out.push_back(Event::move(false, static_cast<int>(x), static_cast<int>(y)));
+        dx -= x;
+        dy -= y;
+    }
+
+    for (const Event& key : held_keys) {
+        if (!from || from->find(key) == from->held_keys.end()) {
+            out.push_back(key);
+        }
+    }
+    for (uint16_t button = 0; button < 8; button++) {
+        if ((held_buttons & ~from_buttons) & (1u << button)) {
+            out.push_back(Event::button(false, static_cast<Button>(button)));
+        }
+    }
+}
+
+/**
+ * @brief Finds the held press matching a key event
+ *
+ * @details Presses and releases match on virtual key and scan code (or UTF-16 unit).
+ *
+ * @param event A key event
+ * @return The held press, or held_keys.end()
+ */
+std::vector<Event>::const_iterator HeldState::find(const Event& event) const {
+    return std::find_if(held_keys.begin(), held_keys.end(), [&event](const Event& key) {
+        return key.code == event.code && key.payload == event.payload;
+    });
+}
+
+/**
+ * @brief Opens a recording and validates its header
+ *
+ * @param path The file to read
+ * @throws InputError If the file is not a recording or holds an unknown event kind
+ */
+RecordingTrack::RecordingTrack(const std::string& path) : file(path) {
+    if (file.size() < sizeof(RecordingHeader)) {
+        throw InputError(InputError::Type::InvalidInput, path + " is not a recording");
+    }
+    std::memcpy(&head, file.data(), sizeof(head));
+
+    if (std::memcmp(head.magic, recording_magic, sizeof(recording_magic)) != 0) {
+        throw InputError(InputError::Type::InvalidInput, path + " is not a recording");
+    }
+    if (head.version != RecordingHeader::current_version || head.record_size != sizeof(TimedEvent)) {
+        throw InputError(InputError::Type::InvalidInput, path + " uses an unsupported recording version");
+    }
+
+    data = reinterpret_cast<const TimedEvent*>(file.data() + sizeof(RecordingHeader));
+    const size_t available = (file.size() - sizeof(RecordingHeader)) / sizeof(TimedEvent);
+
+    if (head.record_count != 0 && head.record_count <= available) {
+        count = static_cast<size_t>(head.record_count);
+
+        // Use the index only if it lies exactly after the records and fits the file
+        const uint64_t records_end = sizeof(RecordingHeader) + head.record_count * sizeof(TimedEvent);
+        const uint64_t index_end = records_end + head.index_count * sizeof(RecordingIndexEntry) +
+                                   head.snapshot_count * sizeof(Event);
+        if (head.index_offset == records_end && head.index_count != 0 && index_end <= file.size()) {
+            index = reinterpret_cast<const RecordingIndexEntry*>(file.data() + records_end);
+            snapshots = reinterpret_cast<const Event*>(index + head.index_count);
+            index_count = static_cast<size_t>(head.index_count);
+        }
+    } else {
+        // Unfinished file: the tail of the last segment is still zero-filled, and an
+        // all-zero record (a key press of virtual key 0 at time 0) is never written
+        static const TimedEvent empty{};
+        count = available;
+        while (count > 0 && std::memcmp(&data[count - 1], &empty, sizeof(empty)) == 0) {
+            count--;
+        }
+    }
+
+    // Records are dispatched as they are, so an unknown kind must not get past here
+    for (size_t i = 0; i < count; i++) {
+        if (static_cast<size_t>(data[i].event.kind) >= EVENT_KIND_COUNT) {
+            throw InputError(InputError::Type::InvalidInput, path + " contains an invalid event kind");
+        }
+    }
+    for (size_t i = 0; index && i < head.snapshot_count; i++) {
+        if (static_cast<size_t>(snapshots[i].kind) >= EVENT_KIND_COUNT) {
+            throw InputError(InputError::Type::InvalidInput, path + " contains an invalid event kind");
+        }
+    }
+}
+
+/**
+ * @brief Reads the next record
+ *
+ * @param out Receives the record
+ * @return bool False once every record has been read
+ */
+bool RecordingTrack::next(TimedEvent& out) {
+    if (position >= count) {
+        return false;
+    }
+
+    out = data[position++];
+    return true;
+}
+
+/**
+ * @brief Finds the first record at or after a time
+ *
+ * @param time Timestamp in nanoseconds
+ * @return size_t The record index, or size() if every record is earlier
+ */
+size_t RecordingTrack::find_time(int64_t time) const {
+    size_t first = 0;
+    size_t last = count;
+
+    // Narrow the search to one index interval; the index stays small and resident
+    if (index_count != 0) {
+        const RecordingIndexEntry* entries_end = index + index_count;
+        const RecordingIndexEntry* after = std::upper_bound(
+            index, entries_end, time, [](int64_t t, const RecordingIndexEntry& entry) { return t <= entry.timestamp; });
+        if (after != index) {
+            first = static_cast<size_t>((after - 1)->record);
+        }
+        if (after != entries_end) {
+            last = static_cast<size_t>(after->record);
+        }
+    }
+
+    const TimedEvent* found = std::lower_bound(
+        data + first, data + last, time, [](const TimedEvent& record, int64_t t) { return record.timestamp < t; });
+    return static_cast<size_t>(found - data);
+}
+
+/**
+ * @brief Gets the held state just before a record
+ *
+ * @param record The record index
+ * @return HeldState The state
+ */
+HeldState RecordingTrack::state_at(size_t record) const {
+    record = std::min(record, count);
+
+    HeldState state;
+    size_t replayed = 0;
+    if (const RecordingIndexEntry* entry = entry_for(record)) {
+        for (uint32_t i = 0; i < entry->snapshot_count; i++) {
+            state.apply(snapshots[entry->snapshot_offset + i]);
+        }
+        replayed = static_cast<size_t>(entry->record);
+    }
+
+    for (; replayed < record; replayed++) {
+        state.apply(data[replayed].event);
+    }
+    return state;
+}
+
+/**
+ * @brief Continues reading at a time, with the events that recreate the held state there
+ *
+ * @param time Timestamp in nanoseconds
+ * @param restore Receives the events reaching the held state at that point
+ * @param from The state the receiver is in, or null for nothing held
+ * @return size_t The record reading continues at
+ */
+size_t RecordingTrack::seek_time(int64_t time, std::vector<Event>& restore, const HeldState* from) {
+    const size_t record = find_time(time);
+    state_at(record).restore(restore, from);
+    position = record;
+    return record;
+}
+
+/**
+ * @brief Finds the last index entry at or before a record
+ *
+ * @details Entries whose snapshot does not fit the file are ignored.
+ *
+ * @param record The record index
+ * @return const RecordingIndexEntry* The entry, or null if there is none
+ */
+const RecordingIndexEntry* RecordingTrack::entry_for(size_t record) const {
+    const RecordingIndexEntry* after = std::upper_bound(
+        index, index + index_count, record, [](size_t r, const RecordingIndexEntry& entry) { return r < entry.record; });
+    if (after == index) {
+        return nullptr;
+    }
+
+    const RecordingIndexEntry* entry = after - 1;
+    if (static_cast<uint64_t>(entry->snapshot_offset) + entry->snapshot_count > head.snapshot_count) {
+        return nullptr;
+    }
+    return entry;
+}
+
+} // namespace bego
@@ -0,0 +1,191 @@
+#include "../include/bego_replay.h"
+#include "../include/bego_win.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+/**
+ * @file replay.cpp
+ * @author Eterninety
+ * @brief Implementation of multi-track replay with a streaming k-way merge
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace bego {
+
+namespace {
+
+/// Interval at which a replay waiting for its next event checks the cancel flag
+constexpr std::chrono::milliseconds cancel_poll_interval(20);
+
+/**
+ * @brief Heap ordering: earliest time first, then lowest track index
+ */
+struct LaterHead {
+    template <typename H>
+    bool operator()(const H& a, const H& b) const {
+        if (a.time != b.time) {
+            return a.time > b.time;
+        }
+        return a.track > b.track;
+    }
+};
+
+} // namespace
+
+/**
+ * @brief Reads the next event of a macro
+ *
+ * @param out Receives the event
+ * @return bool False once the macro is exhausted
+ */
+bool MacroTrack::next(TimedEvent& out) {
+    if (position >= macro.size()) {
+        return false;
+    }
+
+    out.timestamp = macro.timestamp(position);
+    out.event = macro.event(position);
+    ++position;
+    return true;
+}
+
+/**
+ * @brief Reads the next event of an array
+ *
+ * @param out Receives the event
+ * @return bool False once the array is exhausted
+ */
+bool SpanTrack::next(TimedEvent& out) {
+    if (position >= count) {
+        return false;
+    }
+
+    out = events[position++];
+    return true;
+}
+
+/**
+ * @brief Adds a track to the merge
+ *
+ * @details The first event of the track is pulled immediately so the heap
+ * always holds exactly one head per non-exhausted track.
+ *
+ * @param source The track to merge
+ * @param speed Playback speed factor for this track
+ * @throws InputError If the speed is not positive
+ */
+void Replay::add_track(TrackSource& source, double speed) {
+    if (!(speed > 0.0)) {
+        throw InputError(InputError::Type::InvalidInput, "Track speed must be positive");
+    }
+
+    tracks.push_back(Track{&source, speed});
+    refill(static_cast<uint32_t>(tracks.size() - 1));
+}
+
+/**
+ * @brief Pulls the next event of a track and pushes it onto the heap
+ *
+ * @param track Index of the track
+ */
+void Replay::refill(uint32_t track) {
+    TimedEvent event;
+    if (!tracks[track].source->next(event)) {
+        return;
+    }
+
+    int64_t time = event.timestamp;
+    if (tracks[track].speed != 1.0) {
+        time = static_cast<int64_t>(std::llround(static_cast<double>(time) / tracks[track].speed));
+    }
+
+    heap.push_back(Head{time, track, event.event});
+    std::push_heap(heap.begin(), heap.end(), LaterHead());
+}
+
+/**
+ * @brief Gets the next event in merged order
+ *
+ * @details Pops the earliest head and replaces it with the next event of the
+ * same track: O(log N) per event for N tracks.
+ *
+ * @param out Receives the event, with its timestamp scaled by the track speed
+ * @return bool False once every track is exhausted
+ */
+bool Replay::next(TimedEvent& out) {
+    if (heap.empty()) {
+        return false;
+    }
+
+    std::pop_heap(heap.begin(), heap.end(), LaterHead());
+    Head head = heap.back();
+    heap.pop_back();
+
+    out.timestamp = head.time;
+    out.event = head.event;
+
+    refill(head.track);
+    return true;
+}
+
+/**
+ * @brief Replays the merged tracks into a Bego instance in real time
+ *
+ * @details Merged time from (zero unless the tracks were seeked) is mapped to the
+ * moment play() is called. Every event that is due when the replay wakes up goes
+ * into the same batch, so simultaneous events from different tracks reach the
+ * system in one dispatch, and a replay that fell behind catches up without sleeping.
+ *
+ * @param bego The instance receiving the events
+ * @param cancel Optional flag; setting it stops the replay after the current batch, or while it waits for the next one
+ * @param from Merged time mapped to the moment play() is called
+ * @return size_t The number of events sent
+ */
+size_t Replay::play(Bego& bego, const std::atomic<bool>* cancel, int64_t from) {
+    using Clock = std::chrono::steady_clock;
+
+    const Clock::time_point start = Clock::now();
+    std::vector<Event> batch;
+    size_t sent = 0;
+
+    TimedEvent event;
+    bool pending = next(event);
+
+    while (pending) {
+        if (cancel && cancel->load(std::memory_order_relaxed)) {
+            break;
+        }
+
+        // Sleep in slices, so a long gap in the recording does not delay cancelling
+        Clock::time_point due = start + std::chrono::nanoseconds(event.timestamp - from);
+        Clock::time_point now_point = Clock::now();
+        while (due > now_point && !(cancel && cancel->load(std::memory_order_relaxed))) {
+            std::this_thread::sleep_until(cancel ? std::min(due, now_point + cancel_poll_interval) : due);
+            now_point = Clock::now();
+        }
+        if (due > now_point) {
+            break;
+        }
+
+        // Collect everything that is due by now
+        const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count() + from;
+        batch.clear();
+        do {
+            batch.push_back(event.event);
+            pending = next(event);
+        } while (pending && event.timestamp <= now);
+
+        bego.send(batch.data(), batch.size());
+        sent += batch.size();
+    }
+
+    return sent;
+}
+
+} // namespace bego
@@ -0,0 +1,277 @@
+#include "../include/bego_script_cache.h"
+#include "../include/bego_mapped_file.h"
+#include "../include/bego_win.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+/**
+ * @file script_cache.cpp
+ * @author Eterninety
+ * @brief Implementation of the on-disk cache of compiled scripts
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace bego {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+/**
+ * @struct EntryHeader
+ * @brief Start of every cache file, followed by the code, the event pool and
+ * the NUL-terminated variable names
+ */
+struct EntryHeader {
+    char magic[4];            ///< "BGSC"
+    uint32_t format;          ///< ScriptCache::format_version
+    uint64_t key;             ///< Key the entry was stored under
+    uint32_t code_count;      ///< Number of instructions
+    uint32_t event_count;     ///< Number of events in the pool
+    uint32_t variable_count;  ///< Number of variable names
+    uint32_t names_size;      ///< Bytes of variable names, terminators included
+};
+
+static_assert(sizeof(EntryHeader) == 32, "EntryHeader layout changed");
+
+constexpr char entry_magic[4] = {'B', 'G', 'S', 'C'};
+
+/// Domains keep script and text keys apart even for identical strings
+constexpr uint64_t script_domain = 1;
+constexpr uint64_t text_domain = 2;
+
+/**
+ * @brief Hash everything an entry depends on besides its own content
+ */
+uint64_t environment_seed(uint64_t domain) {
+    // The layout decides the scan codes the compiler resolves keys to
+    uintptr_t layout = reinterpret_cast<uintptr_t>(Bego::get_keyboard_layout());
+
+    uint64_t seed = script_hash(LIBRARY_VERSION);
+    uint64_t values[] = {ScriptCache::format_version, domain, static_cast<uint64_t>(layout)};
+    return script_hash(std::string_view(reinterpret_cast<const char*>(values), sizeof(values)), seed);
+}
+
+} // namespace
+
+/**
+ * @brief Uses a cache directory, creating it if needed
+ *
+ * @details A directory that cannot be created makes every lookup a miss.
+ *
+ * @param directory Where entries are stored
+ */
+ScriptCache::ScriptCache(std::string directory) : directory(std::move(directory)) {
+    std::error_code error;
+    fs::create_directories(this->directory, error);
+}
+
+/**
+ * @brief Computes the key of a script for the current layout
+ *
+ * @param source The script text
+ * @return uint64_t The cache key
+ */
+uint64_t ScriptCache::script_key(std::string_view source) {
+    return script_hash(source, environment_seed(script_domain));
+}
+
+/**
+ * @brief Computes the key of a text buffer for the current layout
+ *
+ * @param text The text to type
+ * @return uint64_t The cache key
+ */
+uint64_t ScriptCache::text_key(std::string_view text) {
+    return script_hash(text, environment_seed(text_domain));
+}
+
+/**
+ * @brief Compiles a script, or loads it from the cache
+ *
+ * @param source The script text
+ * @param bego Instance used to compile on a miss
+ * @return Program The compiled program
+ * @throws InputError If the script does not compile
+ */
+Program ScriptCache::compile(std::string_view source, Bego& bego) {
+    const uint64_t key = script_key(source);
+    auto cached = find(key);
+    // A damaged or colliding entry must not reach ScriptVM::run; treat it as a miss
+    if (cached && validate(*cached)) {
+        hit_count.fetch_add(1, std::memory_order_relaxed);
+        return std::move(*cached);
+    }
+
+    miss_count.fetch_add(1, std::memory_order_relaxed);
+    Program program = compile_script(source, bego);
+    store(key, program);
+    return program;
+}
+
+/**
+ * @brief Builds the events that type a string, or loads them from the cache
+ *
+ * @details Text buffers are stored as entries without code.
+ *
+ * @param text The text to type
+ * @param bego Instance used to build the events on a miss
+ * @return std::vector<Event> The events
+ * @throws InputError If the text contains a null byte
+ */
+std::vector<Event> ScriptCache::text(const std::string& text, Bego& bego) {
+    const uint64_t key = text_key(text);
+    auto cached = find(key);
+    if (cached && cached->code.empty() &&
+        std::all_of(cached->events.begin(), cached->events.end(),
+                    [](const Event& event) { return static_cast<size_t>(event.kind) < EVENT_KIND_COUNT; })) {
+        hit_count.fetch_add(1, std::memory_order_relaxed);
+        return std::move(cached->events);
+    }
+
+    miss_count.fetch_add(1, std::memory_order_relaxed);
+    Program entry;
+    bego.queue_text(entry.events, text);
+    store(key, entry);
+    return std::move(entry.events);
+}
+
+/**
+ * @brief Loads an entry
+ *
+ * @details The file is mapped and validated against its header before anything is
+ * copied out; any mismatch is a miss. The operands are not checked here, callers
+ * validate the program before using it.
+ *
+ * @param key The cache key
+ * @return std::optional<Program> The entry, or std::nullopt on a miss
+ */
+std::optional<Program> ScriptCache::find(uint64_t key) const {
+    MappedFile file;
+    try {
+        file = MappedFile(path(key));
+    } catch (const InputError&) {
+        return std::nullopt;
+    }
+
+    EntryHeader header;
+    if (file.size() < sizeof(header)) {
+        return std::nullopt;
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+
+    const uint64_t expected_size = sizeof(header) + static_cast<uint64_t>(header.code_count) * sizeof(Instruction) +
+                                   static_cast<uint64_t>(header.event_count) * sizeof(Event) + header.names_size;
+    if (std::memcmp(header.magic, entry_magic, sizeof(entry_magic)) != 0 || header.format != format_version ||
+        header.key != key || expected_size != file.size()) {
+        return std::nullopt;
+    }
+
+    Program program;
+    const uint8_t* cursor = file.data() + sizeof(header);
+
+    const Instruction* code = reinterpret_cast<const Instruction*>(cursor);
+    program.code.assign(code, code + header.code_count);
+    cursor += header.code_count * sizeof(Instruction);
+
+    const Event* events = reinterpret_cast<const Event*>(cursor);
+    program.events.assign(events, events + header.event_count);
+    cursor += header.event_count * sizeof(Event);
+
+    const char* names = reinterpret_cast<const char*>(cursor);
+    const char* names_end = names + header.names_size;
+    program.variables.reserve(header.variable_count);
+    while (names < names_end && program.variables.size() < header.variable_count) {
+        const char* terminator = static_cast<const char*>(std::memchr(names, '\0', names_end - names));
+        if (terminator == nullptr) {
+            return std::nullopt;
+        }
+        program.variables.emplace_back(names, terminator);
+        names = terminator + 1;
+    }
+    if (program.variables.size() != header.variable_count) {
+        return std::nullopt;
+    }
+
+    return program;
+}
+
+/**
+ * @brief Stores an entry, replacing any previous one
+ *
+ * @details The entry is written to a file private to this call and renamed over
+ * the final name, which is atomic on both POSIX and Windows.
+ *
+ * @param key The cache key
+ * @param program The entry
+ * @return bool False if the entry could not be written
+ */
+bool ScriptCache::store(uint64_t key, const Program& program) const {
+    EntryHeader header{};
+    std::memcpy(header.magic, entry_magic, sizeof(entry_magic));
+    header.format = format_version;
+    header.key = key;
+    header.code_count = static_cast<uint32_t>(program.code.size());
+    header.event_count = static_cast<uint32_t>(program.events.size());
+    header.variable_count = static_cast<uint32_t>(program.variables.size());
+    for (const std::string& name : program.variables) {
+        header.names_size += static_cast<uint32_t>(name.size() + 1);
+    }
+
+    const std::string final_path = path(key);
+    std::ostringstream temporary;
+    temporary << final_path << '.' << std::hash<std::thread::id>()(std::this_thread::get_id()) << '.'
+              << std::chrono::steady_clock::now().time_since_epoch().count() << ".tmp";
+
+    {
+        std::ofstream out(temporary.str(), std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(program.code.data()), program.code.size() * sizeof(Instruction));
+        out.write(reinterpret_cast<const char*>(program.events.data()), program.events.size() * sizeof(Event));
+        for (const std::string& name : program.variables) {
+            out.write(name.c_str(), name.size() + 1);
+        }
+        if (!out) {
+            out.close();
+            std::error_code error;
+            fs::remove(temporary.str(), error);
+            return false;
+        }
+    }
+
+    std::error_code error;
+    fs::rename(temporary.str(), final_path, error);
+    if (error) {
+        fs::remove(temporary.str(), error);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Gets the file of an entry
+ *
+ * @param key The cache key
+ * @return std::string The path: the key in hexadecimal with a .bgc extension
+ */
+std::string ScriptCache::path(uint64_t key) const {
+    std::ostringstream name;
+    name << std::hex << std::setw(16) << std::setfill('0') << key << ".bgc";
+    return (fs::path(directory) / name.str()).string();
+}
+
+} // namespace bego
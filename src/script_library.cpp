@@ -0,0 +1,419 @@
+#include "../include/bego_script_library.h"
+#include "../include/bego_win.h"
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <thread>
+
+/**
+ * @file script_library.cpp
+ * @author Eterninety
+ * @brief Implementation of indexed macro library files
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace bego {
+
+namespace fs = std::filesystem;
+
+/**
+ * @struct ScriptLibrary::Entry
+ * @brief One macro in the entry table
+ */
+struct ScriptLibrary::Entry {
+    uint64_t hash;         ///< script_hash() of the name
+    uint64_t data_offset;  ///< File offset of the macro data
+    uint32_t data_size;    ///< Bytes of macro data
+    uint32_t name_offset;  ///< Offset of the name in the name block
+    uint32_t name_size;    ///< Bytes in the name, without terminator
+    uint32_t reserved;     ///< Zero
+};
+
+namespace {
+
+/**
+ * @struct LibraryHeader
+ * @brief Start of a library file
+ *
+ * @details Followed by the bucket table (uint32 per bucket, entry index + 1, 0 for
+ * empty), the entry table, the NUL-terminated names and the macro data, each part
+ * starting on an 8-byte boundary.
+ */
+struct LibraryHeader {
+    char magic[8];            ///< "BEGOLIB" and a NUL
+    uint32_t format;          ///< ScriptLibrary::format_version
+    uint32_t entry_count;     ///< Number of macros
+    uint64_t environment;     ///< Layout and library version the macros were compiled for
+    uint32_t bucket_count;    ///< Hash table size, a power of two
+    uint32_t reserved;        ///< Zero
+    uint64_t buckets_offset;  ///< File offset of the bucket table
+    uint64_t entries_offset;  ///< File offset of the entry table
+    uint64_t names_offset;    ///< File offset of the name block
+    uint64_t names_size;      ///< Bytes in the name block
+};
+
+/**
+ * @struct MacroHeader
+ * @brief Start of each macro's data, followed by the code, the event pool and
+ * the NUL-terminated variable names
+ */
+struct MacroHeader {
+    uint32_t code_count;
+    uint32_t event_count;
+    uint32_t variable_count;
+    uint32_t names_size;
+};
+
+static_assert(sizeof(LibraryHeader) == 64, "LibraryHeader layout changed");
+static_assert(sizeof(MacroHeader) == 16, "MacroHeader layout changed");
+
+constexpr char library_magic[8] = {'B', 'E', 'G', 'O', 'L', 'I', 'B', '\0'};
+
+/**
+ * @brief Hash everything compiled macros depend on besides their source
+ */
+uint64_t environment() {
+    // The layout decides the scan codes the compiler resolves keys to
+    uintptr_t layout = reinterpret_cast<uintptr_t>(Bego::get_keyboard_layout());
+
+    uint64_t seed = script_hash(LIBRARY_VERSION);
+    uint64_t values[] = {ScriptLibrary::format_version, static_cast<uint64_t>(layout)};
+    return script_hash(std::string_view(reinterpret_cast<const char*>(values), sizeof(values)), seed);
+}
+
+/**
+ * @brief Round up to a multiple of 8
+ */
+uint64_t align8(uint64_t value) {
+    return (value + 7) & ~uint64_t(7);
+}
+
+/**
+ * @brief Append raw bytes to a buffer
+ */
+void put(std::vector<uint8_t>& out, const void* data, size_t size) {
+    if (size != 0) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        out.insert(out.end(), bytes, bytes + size);
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Opens a library
+ *
+ * @details Only the header is validated against the file size here; entries and
+ * macro data are checked when they are used, so opening stays O(1).
+ *
+ * @param path The library file
+ * @throws InputError If the file is not a usable library
+ */
+ScriptLibrary::ScriptLibrary(const std::string& path) : file(path) {
+    LibraryHeader header;
+    if (file.size() < sizeof(header)) {
+        throw InputError(InputError::Type::InvalidInput, path + " is not a script library");
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+
+    if (std::memcmp(header.magic, library_magic, sizeof(library_magic)) != 0) {
+        throw InputError(InputError::Type::InvalidInput, path + " is not a script library");
+    }
+    if (header.format != format_version) {
+        throw InputError(InputError::Type::InvalidInput, path + " uses an unsupported library format");
+    }
+    if (header.environment != environment()) {
+        throw InputError(InputError::Type::InvalidInput,
+                         path + " was built for a different keyboard layout or library version");
+    }
+
+    const uint64_t size = file.size();
+    const bool power_of_two = header.bucket_count != 0 && (header.bucket_count & (header.bucket_count - 1)) == 0;
+    if (!power_of_two || header.bucket_count < header.entry_count ||
+        header.buckets_offset % 8 != 0 || header.buckets_offset + uint64_t(header.bucket_count) * 4 > size ||
+        header.entries_offset % 8 != 0 || header.entries_offset + uint64_t(header.entry_count) * sizeof(Entry) > size ||
+        header.names_offset + header.names_size > size) {
+        throw InputError(InputError::Type::InvalidInput, path + " is damaged");
+    }
+
+    entry_count = header.entry_count;
+    bucket_mask = header.bucket_count - 1;
+    buckets = reinterpret_cast<const uint32_t*>(file.data() + header.buckets_offset);
+    entries = reinterpret_cast<const Entry*>(file.data() + header.entries_offset);
+    names = reinterpret_cast<const char*>(file.data() + header.names_offset);
+    names_size = static_cast<size_t>(header.names_size);
+}
+
+/**
+ * @brief Finds the entry of a name in the hash table
+ *
+ * @details Linear probing from the bucket the hash selects; the stored hash rejects
+ * almost every non-matching entry before the names are compared.
+ *
+ * @param name The macro name
+ * @return const Entry* The entry, or null if there is none
+ */
+const ScriptLibrary::Entry* ScriptLibrary::lookup(std::string_view name) const {
+    if (entry_count == 0) {
+        return nullptr;
+    }
+
+    const uint64_t hash = script_hash(name);
+    for (uint32_t bucket = static_cast<uint32_t>(hash) & bucket_mask, probes = 0; probes <= bucket_mask;
+         bucket = (bucket + 1) & bucket_mask, probes++) {
+        const uint32_t slot = buckets[bucket];
+        if (slot == 0 || slot > entry_count) {
+            return nullptr;
+        }
+
+        const Entry& entry = entries[slot - 1];
+        if (entry.hash == hash && entry.name_size == name.size() &&
+            uint64_t(entry.name_offset) + entry.name_size <= names_size &&
+            std::memcmp(names + entry.name_offset, name.data(), name.size()) == 0) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Gets a macro, loading it on first use
+ *
+ * @param name The macro name
+ * @return std::shared_ptr<const Program> The macro, or null if there is none
+ * @throws InputError If the macro's data is damaged
+ */
+std::shared_ptr<const Program> ScriptLibrary::find(std::string_view name) const {
+    const Entry* entry = lookup(name);
+    if (entry == nullptr) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto cached = cache.find(entry);
+    if (cached != cache.end()) {
+        return cached->second;
+    }
+
+    const auto damaged = [&] {
+        return InputError(InputError::Type::InvalidInput, "Macro '" + std::string(name) + "' is damaged");
+    };
+
+    MacroHeader header;
+    if (entry->data_offset + entry->data_size > file.size() || entry->data_size < sizeof(header)) {
+        throw damaged();
+    }
+    const uint8_t* cursor = file.data() + entry->data_offset;
+    std::memcpy(&header, cursor, sizeof(header));
+
+    const uint64_t expected = sizeof(header) + uint64_t(header.code_count) * sizeof(Instruction) +
+                              uint64_t(header.event_count) * sizeof(Event) + header.names_size;
+    if (expected != entry->data_size) {
+        throw damaged();
+    }
+    cursor += sizeof(header);
+
+    auto program = std::make_shared<Program>();
+    const Instruction* code = reinterpret_cast<const Instruction*>(cursor);
+    program->code.assign(code, code + header.code_count);
+    cursor += header.code_count * sizeof(Instruction);
+
+    const Event* events = reinterpret_cast<const Event*>(cursor);
+    program->events.assign(events, events + header.event_count);
+    cursor += header.event_count * sizeof(Event);
+
+    const char* variable = reinterpret_cast<const char*>(cursor);
+    const char* variables_end = variable + header.names_size;
+    program->variables.reserve(header.variable_count);
+    while (variable < variables_end && program->variables.size() < header.variable_count) {
+        const char* terminator = static_cast<const char*>(std::memchr(variable, '\0', variables_end - variable));
+        if (terminator == nullptr) {
+            throw damaged();
+        }
+        program->variables.emplace_back(variable, terminator);
+        variable = terminator + 1;
+    }
+    if (program->variables.size() != header.variable_count || !validate(*program)) {
+        throw damaged();
+    }
+
+    cache.emplace(entry, program);
+    return program;
+}
+
+/**
+ * @brief Checks whether a macro exists, without loading it
+ *
+ * @param name The macro name
+ * @return bool True if the library has the macro
+ */
+bool ScriptLibrary::contains(std::string_view name) const {
+    return lookup(name) != nullptr;
+}
+
+/**
+ * @brief Gets the name of a macro by position
+ *
+ * @param index Position in the library
+ * @return std::string_view The name, or an empty view if the index or entry is out of range
+ */
+std::string_view ScriptLibrary::name(size_t index) const {
+    if (index >= entry_count) {
+        return {};
+    }
+    const Entry& entry = entries[index];
+    if (uint64_t(entry.name_offset) + entry.name_size > names_size) {
+        return {};
+    }
+    return std::string_view(names + entry.name_offset, entry.name_size);
+}
+
+/**
+ * @brief Gets the number of macros loaded so far
+ *
+ * @return size_t The loaded count
+ */
+size_t ScriptLibrary::loaded() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return cache.size();
+}
+
+/**
+ * @brief Adds a macro
+ *
+ * @param name The macro name
+ * @param program The compiled macro
+ * @throws InputError If the name is empty or already used
+ */
+void ScriptLibraryBuilder::add(const std::string& name, Program program) {
+    if (name.empty()) {
+        throw InputError(InputError::Type::InvalidInput, "Macro names cannot be empty");
+    }
+    if (!positions.emplace(name, macros.size()).second) {
+        throw InputError(InputError::Type::InvalidInput, "Duplicate macro name '" + name + "'");
+    }
+    macros.push_back(Macro{name, std::move(program)});
+}
+
+/**
+ * @brief Compiles a script and adds it
+ *
+ * @param name The macro name
+ * @param source The script text
+ * @param bego Instance used to compile the script
+ * @throws InputError If the script does not compile or the name is taken
+ */
+void ScriptLibraryBuilder::add_script(const std::string& name, std::string_view source, Bego& bego) {
+    if (positions.count(name) != 0) {
+        throw InputError(InputError::Type::InvalidInput, "Duplicate macro name '" + name + "'");
+    }
+    add(name, compile_script(source, bego));
+}
+
+/**
+ * @brief Writes the library
+ *
+ * @details The hash table has at least twice as many buckets as macros, which keeps
+ * probe sequences short.
+ *
+ * @param path The library file
+ * @throws InputError If the file cannot be written
+ */
+void ScriptLibraryBuilder::write(const std::string& path) const {
+    uint32_t bucket_count = 1;
+    while (bucket_count < macros.size() * 2) {
+        bucket_count <<= 1;
+    }
+
+    std::vector<ScriptLibrary::Entry> entries(macros.size());
+    std::vector<uint32_t> buckets(bucket_count, 0);
+    std::vector<uint8_t> name_block;
+    std::vector<uint8_t> data;
+
+    LibraryHeader header{};
+    std::memcpy(header.magic, library_magic, sizeof(library_magic));
+    header.format = ScriptLibrary::format_version;
+    header.entry_count = static_cast<uint32_t>(macros.size());
+    header.environment = environment();
+    header.bucket_count = bucket_count;
+    header.buckets_offset = sizeof(LibraryHeader);
+    header.entries_offset = align8(header.buckets_offset + uint64_t(bucket_count) * sizeof(uint32_t));
+    header.names_offset = header.entries_offset + entries.size() * sizeof(ScriptLibrary::Entry);
+
+    for (const Macro& macro : macros) {
+        header.names_size += macro.name.size() + 1;
+    }
+    const uint64_t data_offset = align8(header.names_offset + header.names_size);
+
+    for (size_t i = 0; i < macros.size(); i++) {
+        const Macro& macro = macros[i];
+        ScriptLibrary::Entry& entry = entries[i];
+        entry.hash = script_hash(macro.name);
+        entry.name_offset = static_cast<uint32_t>(name_block.size());
+        entry.name_size = static_cast<uint32_t>(macro.name.size());
+        put(name_block, macro.name.c_str(), macro.name.size() + 1);
+
+        MacroHeader macro_header{};
+        macro_header.code_count = static_cast<uint32_t>(macro.program.code.size());
+        macro_header.event_count = static_cast<uint32_t>(macro.program.events.size());
+        macro_header.variable_count = static_cast<uint32_t>(macro.program.variables.size());
+        for (const std::string& variable : macro.program.variables) {
+            macro_header.names_size += static_cast<uint32_t>(variable.size() + 1);
+        }
+
+        data.resize(align8(data.size()));
+        const size_t start = data.size();
+        entry.data_offset = data_offset + start;
+        put(data, &macro_header, sizeof(macro_header));
+        put(data, macro.program.code.data(), macro.program.code.size() * sizeof(Instruction));
+        put(data, macro.program.events.data(), macro.program.events.size() * sizeof(Event));
+        for (const std::string& variable : macro.program.variables) {
+            put(data, variable.c_str(), variable.size() + 1);
+        }
+        entry.data_size = static_cast<uint32_t>(data.size() - start);
+
+        uint32_t bucket = static_cast<uint32_t>(entry.hash) & (bucket_count - 1);
+        while (buckets[bucket] != 0) {
+            bucket = (bucket + 1) & (bucket_count - 1);
+        }
+        buckets[bucket] = static_cast<uint32_t>(i + 1);
+    }
+
+    std::ostringstream temporary;
+    temporary << path << '.' << std::hash<std::thread::id>()(std::this_thread::get_id()) << '.'
+              << std::chrono::steady_clock::now().time_since_epoch().count() << ".tmp";
+
+    {
+        std::ofstream out(temporary.str(), std::ios::binary | std::ios::trunc);
+        const char padding[8] = {};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(buckets.data()), buckets.size() * sizeof(uint32_t));
+        out.write(padding, header.entries_offset - (header.buckets_offset + buckets.size() * sizeof(uint32_t)));
+        out.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(ScriptLibrary::Entry));
+        out.write(reinterpret_cast<const char*>(name_block.data()), name_block.size());
+        out.write(padding, data_offset - (header.names_offset + header.names_size));
+        out.write(reinterpret_cast<const char*>(data.data()), data.size());
+        if (!out) {
+            out.close();
+            std::error_code error;
+            fs::remove(temporary.str(), error);
+            throw InputError(InputError::Type::InvalidInput, "Cannot write script library " + path);
+        }
+    }
+
+    std::error_code error;
+    fs::rename(temporary.str(), path, error);
+    if (error) {
+        fs::remove(temporary.str(), error);
+        throw InputError(InputError::Type::InvalidInput, "Cannot write script library " + path);
+    }
+}
+
+} // namespace bego
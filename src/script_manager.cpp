@@ -0,0 +1,400 @@
+#include "../include/bego_script_manager.h"
+#include "../include/bego_script_cache.h"
+#include "../include/bego_win.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <unordered_set>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @file script_manager.cpp
+ * @author Eterninety
+ * @brief Implementation of script loading and live reload
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace bego {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+/// How long the watcher blocks before checking whether it should stop
+constexpr int watch_timeout_ms = 100;
+
+/// Rescan interval where no change notification API is available
+constexpr std::chrono::milliseconds rescan_interval(500);
+
+/**
+ * @brief Get a file's modification time as a plain number
+ * @return int64_t The time, or 0 if the file cannot be queried
+ */
+int64_t modified_time(const std::string& path) {
+    std::error_code error;
+    auto time = fs::last_write_time(path, error);
+    return error ? 0 : static_cast<int64_t>(time.time_since_epoch().count());
+}
+
+} // namespace
+
+/**
+ * @brief Constructs a manager with an empty script table
+ *
+ * @param bego Instance used to compile scripts
+ * @param extension File extension of scripts, including the dot
+ */
+ScriptManager::ScriptManager(Bego& bego, std::string extension)
+    : bego(bego), extension(std::move(extension)), table(std::make_shared<const Table>()) {
+}
+
+/**
+ * @brief Destructor - stops the watcher thread
+ */
+ScriptManager::~ScriptManager() {
+    stop();
+}
+
+/**
+ * @brief Loads every script of a directory and starts the watcher thread
+ *
+ * @param directory The directory to watch
+ * @throws InputError If the directory cannot be read or a directory is already watched
+ */
+void ScriptManager::watch(const std::string& directory) {
+    if (watcher.joinable()) {
+        throw InputError(InputError::Type::InvalidInput, "Already watching " + this->directory);
+    }
+
+    std::error_code error;
+    if (!fs::is_directory(directory, error)) {
+        throw InputError(InputError::Type::InvalidInput, "Cannot read script directory " + directory);
+    }
+
+    this->directory = directory;
+    rescan();
+
+    stopping.store(false);
+    watcher = std::thread(&ScriptManager::run, this);
+}
+
+/**
+ * @brief Stops the watcher thread
+ *
+ * @details The watcher wakes up at least every watch_timeout_ms to notice the request.
+ */
+void ScriptManager::stop() {
+    stopping.store(true);
+    if (watcher.joinable()) {
+        watcher.join();
+    }
+    directory.clear();
+}
+
+/**
+ * @brief Compiles one file and publishes it
+ *
+ * @details The source is hashed first; a file whose contents did not change since
+ * the last successful compile is not recompiled. Compiling happens on the caller's
+ * thread, so readers of the table are never blocked by it.
+ *
+ * @param path The script file
+ * @return bool False if the file is unchanged since it was last compiled
+ * @throws InputError If the file cannot be read or does not compile
+ */
+bool ScriptManager::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw InputError(InputError::Type::InvalidInput, "Cannot read script " + path);
+    }
+    std::string source((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    const uint64_t hash = script_hash(source);
+    const int64_t modified = modified_time(path);
+    const std::string name = fs::path(path).stem().string();
+
+    std::lock_guard<std::mutex> lock(writer_mutex);
+
+    auto known = sources.find(path);
+    if (known != sources.end() && known->second.hash == hash && known->second.compiled) {
+        known->second.modified = modified;
+        return false;
+    }
+
+    std::shared_ptr<const Program> program;
+    try {
+        program = std::make_shared<const Program>(cache ? cache->compile(source, bego) : compile_script(source, bego));
+    } catch (const InputError& e) {
+        // Keep the previous version published and remember the file time so
+        // rescans do not retry the same broken contents
+        if (known != sources.end()) {
+            known->second = Source{known->second.name, hash, modified, false};
+        } else {
+            sources.emplace(path, Source{name, hash, modified, false});
+        }
+        throw InputError(e.get_type(), path + ": " + e.what());
+    }
+
+    sources[path] = Source{name, hash, modified, true};
+    publish(name, std::move(program));
+    return true;
+}
+
+/**
+ * @brief Looks up the current version of a script
+ *
+ * @details Lock-free for readers: one atomic load of the table pointer. The returned
+ * pointer keeps that version alive for as long as the caller holds it.
+ *
+ * @param name The script name
+ * @return std::shared_ptr<const Program> The program, or null if there is none
+ */
+std::shared_ptr<const Program> ScriptManager::get(std::string_view name) const {
+    std::shared_ptr<const Table> current = std::atomic_load(&table);
+    auto it = current->find(std::string(name));
+    return it != current->end() ? it->second : nullptr;
+}
+
+/**
+ * @brief Gets the names of all loaded scripts
+ *
+ * @return std::vector<std::string> The names, sorted
+ */
+std::vector<std::string> ScriptManager::names() const {
+    std::shared_ptr<const Table> current = std::atomic_load(&table);
+
+    std::vector<std::string> result;
+    result.reserve(current->size());
+    for (const auto& entry : *current) {
+        result.push_back(entry.first);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+/**
+ * @brief Compiles through an on-disk cache
+ *
+ * @param cache The cache, or null to always compile
+ */
+void ScriptManager::use_cache(std::shared_ptr<ScriptCache> cache) {
+    std::lock_guard<std::mutex> lock(writer_mutex);
+    this->cache = std::move(cache);
+}
+
+/**
+ * @brief Sets the handler for compile errors found while watching
+ *
+ * @param handler The handler
+ */
+void ScriptManager::on_error(ErrorHandler handler) {
+    std::lock_guard<std::mutex> lock(writer_mutex);
+    error_handler = std::move(handler);
+}
+
+/**
+ * @brief Reloads a changed file, reporting compile errors instead of throwing
+ *
+ * @param path The script file
+ */
+void ScriptManager::reload(const std::string& path) {
+    try {
+        load(path);
+    } catch (const InputError& e) {
+        ErrorHandler handler;
+        {
+            std::lock_guard<std::mutex> lock(writer_mutex);
+            handler = error_handler;
+        }
+        if (handler) {
+            handler(path, e);
+        }
+    }
+}
+
+/**
+ * @brief Drops a deleted file's script
+ *
+ * @param path The script file
+ */
+void ScriptManager::remove(const std::string& path) {
+    std::lock_guard<std::mutex> lock(writer_mutex);
+
+    auto known = sources.find(path);
+    if (known == sources.end()) {
+        return;
+    }
+
+    std::string name = known->second.name;
+    sources.erase(known);
+    publish(name, nullptr);
+}
+
+/**
+ * @brief Compares the directory with what was loaded and applies the differences
+ *
+ * @details Files whose modification time did not change are not even read.
+ */
+void ScriptManager::rescan() {
+    std::unordered_set<std::string> present;
+
+    std::error_code error;
+    for (fs::directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+        std::string path = it->path().string();
+        if (!it->is_regular_file(error) || !is_script(path)) {
+            continue;
+        }
+        present.insert(path);
+
+        bool changed;
+        {
+            std::lock_guard<std::mutex> lock(writer_mutex);
+            auto known = sources.find(path);
+            changed = known == sources.end() || known->second.modified != modified_time(path);
+        }
+        if (changed) {
+            reload(path);
+        }
+    }
+
+    std::vector<std::string> gone;
+    {
+        std::lock_guard<std::mutex> lock(writer_mutex);
+        for (const auto& entry : sources) {
+            if (fs::path(entry.first).parent_path() == fs::path(directory) && !present.count(entry.first)) {
+                gone.push_back(entry.first);
+            }
+        }
+    }
+    for (const std::string& path : gone) {
+        remove(path);
+    }
+}
+
+/**
+ * @brief Replaces one table entry and publishes the new table
+ *
+ * @details The caller holds writer_mutex. The table is copied, which copies only
+ * shared pointers, and swapped in with one atomic store; readers holding the old
+ * table or old programs are unaffected.
+ *
+ * @param name The script name
+ * @param program The new program, or null to remove the entry
+ */
+void ScriptManager::publish(const std::string& name, std::shared_ptr<const Program> program) {
+    auto next = std::make_shared<Table>(*std::atomic_load(&table));
+    if (program) {
+        (*next)[name] = std::move(program);
+    } else {
+        next->erase(name);
+    }
+
+    std::atomic_store(&table, std::shared_ptr<const Table>(std::move(next)));
+    published.fetch_add(1, std::memory_order_release);
+}
+
+/**
+ * @brief Checks whether a path has the script extension
+ *
+ * @param path The path to check
+ * @return bool True for script files
+ */
+bool ScriptManager::is_script(const std::string& path) const {
+    return fs::path(path).extension().string() == extension;
+}
+
+/**
+ * @brief Watcher thread body
+ *
+ * @details On Linux, inotify reports each closed-after-write, renamed or deleted
+ * file, and only that file is reloaded; a queue overflow falls back to a rescan.
+ * On Windows, a change notification wakes the thread and the directory is rescanned,
+ * which rereads only files with a new modification time. Elsewhere the directory
+ * is rescanned periodically.
+ */
+void ScriptManager::run() {
+#if defined(__linux__)
+    int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd >= 0 && inotify_add_watch(fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE) >= 0) {
+        alignas(inotify_event) char buffer[16 * 1024];
+
+        // Pick up anything that changed between watch() and the watch being armed
+        rescan();
+
+        while (!stopping.load()) {
+            pollfd descriptor{fd, POLLIN, 0};
+            if (poll(&descriptor, 1, watch_timeout_ms) <= 0) {
+                continue;
+            }
+
+            ssize_t length = read(fd, buffer, sizeof(buffer));
+            for (ssize_t offset = 0; offset < length;) {
+                const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                offset += sizeof(inotify_event) + event->len;
+
+                if (event->mask & IN_Q_OVERFLOW) {
+                    rescan();
+                    continue;
+                }
+                if (event->len == 0) {
+                    continue;
+                }
+
+                std::string path = (fs::path(directory) / event->name).string();
+                if (!is_script(path)) {
+                    continue;
+                }
+                if (event->mask & (IN_MOVED_FROM | IN_DELETE)) {
+                    remove(path);
+                } else {
+                    reload(path);
+                }
+            }
+        }
+
+        close(fd);
+        return;
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+#elif defined(_WIN32)
+    HANDLE change = FindFirstChangeNotificationA(directory.c_str(), FALSE,
+                                                 FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE);
+    if (change != INVALID_HANDLE_VALUE) {
+        rescan();
+        while (!stopping.load()) {
+            if (WaitForSingleObject(change, watch_timeout_ms) == WAIT_OBJECT_0) {
+                rescan();
+                FindNextChangeNotification(change);
+            }
+        }
+
+        FindCloseChangeNotification(change);
+        return;
+    }
+#endif
+
+    // No notification API: poll the directory
+    auto next_scan = std::chrono::steady_clock::now() + rescan_interval;
+    while (!stopping.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(watch_timeout_ms));
+        if (std::chrono::steady_clock::now() >= next_scan) {
+            rescan();
+            next_scan = std::chrono::steady_clock::now() + rescan_interval;
+        }
+    }
+}
+
+} // namespace bego
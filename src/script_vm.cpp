@@ -0,0 +1,935 @@
+#include "../include/bego_script.h"
+#include "../include/bego_win.h"
+#include <algorithm>
+#include <cctype>
+#include <limits>
+#include <thread>
+
+/**
+ * @file script_vm.cpp
+ * @author Eterninety
+ * @brief Implementation of the script compiler and bytecode interpreter
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace bego {
+
+namespace {
+
+/// Jump targets and counts live in the 16-bit a field
+constexpr size_t max_code_size = std::numeric_limits<uint16_t>::max();
+
+/// Interval at which long waits check the cancel flag
+constexpr std::chrono::milliseconds cancel_poll_interval(20);
+
+/**
+ * @brief Check whether a character is whitespace
+ */
+bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+/**
+ * @brief Compare two words ignoring ASCII case
+ */
+bool same_word(std::string_view word, std::string_view expected) {
+    return word.size() == expected.size() &&
+           std::equal(word.begin(), word.end(), expected.begin(), [](char a, char b) {
+               return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+           });
+}
+
+/**
+ * @brief Check whether a word can name a variable
+ */
+bool is_identifier(std::string_view word) {
+    if (word.empty() || !(std::isalpha(static_cast<unsigned char>(word[0])) || word[0] == '_')) {
+        return false;
+    }
+    return std::all_of(word.begin(), word.end(), [](char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+    });
+}
+
+/**
+ * @brief Parse a comparison operator
+ */
+std::optional<Comparison> parse_comparison(std::string_view word) {
+    if (word == "==") return Comparison::Equal;
+    if (word == "!=") return Comparison::NotEqual;
+    if (word == "<") return Comparison::Less;
+    if (word == "<=") return Comparison::LessEqual;
+    if (word == ">") return Comparison::Greater;
+    if (word == ">=") return Comparison::GreaterEqual;
+    return std::nullopt;
+}
+
+/**
+ * @brief Evaluate a comparison
+ */
+bool compare(Comparison comparison, int32_t left, int32_t right) {
+    switch (comparison) {
+        case Comparison::Equal: return left == right;
+        case Comparison::NotEqual: return left != right;
+        case Comparison::Less: return left < right;
+        case Comparison::LessEqual: return left <= right;
+        case Comparison::Greater: return left > right;
+        case Comparison::GreaterEqual: return left >= right;
+    }
+    return false;
+}
+
+/**
+ * @brief Wrapping 32-bit arithmetic, so scripts cannot trigger undefined behavior
+ */
+int32_t wrap(uint32_t value) {
+    return static_cast<int32_t>(value);
+}
+
+/**
+ * @struct Block
+ * @brief An open loop, if or else block during compilation
+ */
+struct Block {
+    enum class Kind { Loop, If, Else } kind;
+    size_t line;        ///< Line that opened the block, for error messages
+    size_t patch;       ///< Instruction whose target is filled in at the end of the block
+    uint16_t body = 0;  ///< First instruction of a loop body
+    int32_t counter = 0; ///< Loop counter register
+};
+
+/**
+ * @class ScriptCompiler
+ * @brief Single-pass compiler from script text to a Program
+ */
+class ScriptCompiler {
+public:
+    explicit ScriptCompiler(Bego& bego) : bego(bego) {}
+
+    Program compile(std::string_view source) {
+        while (!source.empty()) {
+            size_t end = source.find('\n');
+            std::string_view text = source.substr(0, end);
+            source = end == std::string_view::npos ? std::string_view() : source.substr(end + 1);
+            ++line;
+
+            try {
+                compile_line(text);
+            } catch (const InputError& e) {
+                throw InputError(e.get_type(), "line " + std::to_string(line) + ": " + e.what());
+            }
+        }
+
+        if (!blocks.empty()) {
+            throw InputError(InputError::Type::InvalidInput,
+                             "line " + std::to_string(blocks.back().line) + ": " +
+                             (blocks.back().kind == Block::Kind::Loop ? "loop without end" : "if without end"));
+        }
+
+        push(Opcode::Halt, 0, 0, 0);
+        return std::move(program);
+    }
+
+private:
+    /**
+     * @brief Reject the current line; compile() adds the line number
+     */
+    [[noreturn]] void fail(const std::string& message) {
+        throw InputError(InputError::Type::InvalidInput, message);
+    }
+
+    size_t push(Opcode op, uint8_t flags, uint16_t a, int32_t b) {
+        if (program.code.size() >= max_code_size) {
+            fail("script is too long");
+        }
+        program.code.push_back(Instruction{op, flags, a, b});
+        return program.code.size() - 1;
+    }
+
+    /**
+     * @brief Mark the next instruction as a jump target and return its index
+     */
+    uint16_t target() {
+        if (program.code.size() >= max_code_size) {
+            fail("script is too long");
+        }
+        last_target = program.code.size();
+        return static_cast<uint16_t>(last_target);
+    }
+
+    /**
+     * @brief Append events to the pool, extending the previous Emit when possible
+     */
+    void emit(const std::vector<Event>& events) {
+        if (events.empty()) {
+            return;
+        }
+
+        if (!program.code.empty() && last_target != program.code.size()) {
+            Instruction& previous = program.code.back();
+            if (previous.op == Opcode::Emit &&
+                static_cast<size_t>(previous.b) + previous.a == program.events.size() &&
+                previous.a + events.size() <= max_code_size) {
+                previous.a = static_cast<uint16_t>(previous.a + events.size());
+                program.events.insert(program.events.end(), events.begin(), events.end());
+                return;
+            }
+        }
+
+        for (size_t offset = 0; offset < events.size(); offset += max_code_size) {
+            size_t count = std::min(max_code_size, events.size() - offset);
+            push(Opcode::Emit, 0, static_cast<uint16_t>(count), static_cast<int32_t>(program.events.size()));
+            program.events.insert(program.events.end(), events.begin() + offset, events.begin() + offset + count);
+        }
+    }
+
+    /**
+     * @brief Find a variable's register
+     */
+    std::optional<int32_t> find_register(std::string_view name) const {
+        for (size_t i = 0; i < program.variables.size(); i++) {
+            if (program.variables[i] == name) {
+                return static_cast<int32_t>(i);
+            }
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Find or create a variable's register
+     */
+    int32_t declare(std::string name) {
+        if (auto index = find_register(name)) {
+            return *index;
+        }
+        if (program.variables.size() >= max_code_size) {
+            fail("too many variables");
+        }
+        program.variables.push_back(std::move(name));
+        return static_cast<int32_t>(program.variables.size() - 1);
+    }
+
+    /**
+     * @brief Require an existing variable
+     */
+    int32_t variable(std::string_view word) {
+        if (!is_identifier(word)) {
+            fail("expected a variable name, got '" + std::string(word) + "'");
+        }
+        if (auto index = find_register(word)) {
+            return *index;
+        }
+        fail("unknown variable '" + std::string(word) + "'");
+    }
+
+    /**
+     * @brief Encode an integer or variable operand into an instruction
+     */
+    void operand(std::string_view word, Instruction& instruction) {
+        if (word.empty()) {
+            fail("missing operand");
+        }
+        if (auto value = parse_integer(word)) {
+            instruction.b = *value;
+        } else {
+            instruction.flags |= instruction_flags::Register;
+            instruction.b = variable(word);
+        }
+    }
+
+    /**
+     * @brief Parse an optional direction word, defaulting to a click
+     */
+    Direction direction(std::string_view word) {
+        if (word.empty()) {
+            return Direction::Click;
+        }
+        if (auto parsed = parse_direction(word)) {
+            return *parsed;
+        }
+        fail("invalid direction '" + std::string(word) + "'");
+    }
+
+    /**
+     * @brief Get a required word
+     */
+    std::string_view expect(Tokenizer& tokens, const char* what) {
+        std::string_view word = tokens.next();
+        if (word.empty()) {
+            fail(std::string("missing ") + what);
+        }
+        return word;
+    }
+
+    /**
+     * @brief Reject trailing words
+     */
+    void finish(Tokenizer& tokens) {
+        std::string_view extra = tokens.next();
+        if (!extra.empty()) {
+            fail("unexpected '" + std::string(extra) + "'");
+        }
+    }
+
+    /**
+     * @brief Convert a duration to the 32-bit microsecond operand
+     */
+    int32_t microseconds(std::string_view word) {
+        auto duration = parse_duration(word);
+        if (!duration || duration->count() < 0 || duration->count() > std::numeric_limits<int32_t>::max()) {
+            fail("invalid duration '" + std::string(word) + "'");
+        }
+        return static_cast<int32_t>(duration->count());
+    }
+
+    void compile_line(std::string_view text) {
+        Tokenizer tokens(text);
+        std::string_view command = tokens.next();
+        if (command.empty()) {
+            return;
+        }
+
+        std::vector<Event> events;
+
+        if (same_word(command, "key")) {
+            std::string_view name = expect(tokens, "key name");
+            auto key = key_from_name(name);
+            if (!key) {
+                fail("unknown key '" + std::string(name) + "'");
+            }
+            bego.queue_key(events, *key, direction(tokens.next()));
+            finish(tokens);
+            emit(events);
+        } else if (same_word(command, "raw")) {
+            std::string_view word = expect(tokens, "scan code");
+            auto scan = parse_integer(word);
+            if (!scan || *scan < 0 || *scan > 0xFFFF) {
+                fail("invalid scan code '" + std::string(word) + "'");
+            }
+            bego.queue_raw(events, static_cast<uint16_t>(*scan), direction(tokens.next()));
+            finish(tokens);
+            emit(events);
+        } else if (same_word(command, "button")) {
+            std::string_view name = expect(tokens, "button name");
+            auto button = button_from_name(name);
+            if (!button) {
+                fail("unknown button '" + std::string(name) + "'");
+            }
+            bego.queue_button(events, *button, direction(tokens.next()));
+            finish(tokens);
+            emit(events);
+        } else if (same_word(command, "text")) {
+            std::string_view raw_text = tokens.rest();
+            std::string unescaped;
+            for (size_t i = 0; i < raw_text.size(); i++) {
+                char c = raw_text[i];
+                if (c == '\\' && i + 1 < raw_text.size()) {
+                    char next = raw_text[++i];
+                    c = next == 'n' ? '\n' : next == 't' ? '\t' : next;
+                }
+                unescaped.push_back(c);
+            }
+            if (unescaped.empty()) {
+                fail("missing text");
+            }
+            bego.queue_text(events, unescaped);
+            emit(events);
+        } else if (same_word(command, "scroll")) {
+            Instruction instruction{Opcode::Scroll, 0, 0, 0};
+            operand(expect(tokens, "scroll amount"), instruction);
+            std::string_view axis = tokens.next();
+            if (same_word(axis, "horizontal")) {
+                instruction.flags |= instruction_flags::Alternate;
+            } else if (!axis.empty() && !same_word(axis, "vertical")) {
+                fail("invalid axis '" + std::string(axis) + "'");
+            }
+            finish(tokens);
+
+            if (instruction.flags & instruction_flags::Register) {
+                push(instruction.op, instruction.flags, 0, instruction.b);
+            } else {
+                bego.queue_scroll(events, instruction.b,
+                                  (instruction.flags & instruction_flags::Alternate) ? Axis::Horizontal : Axis::Vertical);
+                emit(events);
+            }
+        } else if (same_word(command, "move")) {
+            // Screen size and cursor position are read when the move runs, not now
+            Instruction x{Opcode::Move, 0, 0, 0};
+            Instruction y{Opcode::Arg, 0, 0, 0};
+            operand(expect(tokens, "x"), x);
+            operand(expect(tokens, "y"), y);
+            std::string_view mode = tokens.next();
+            if (mode.empty() || same_word(mode, "abs")) {
+                x.flags |= instruction_flags::Alternate;
+            } else if (!same_word(mode, "rel")) {
+                fail("invalid coordinate mode '" + std::string(mode) + "'");
+            }
+            finish(tokens);
+            push(x.op, x.flags, 0, x.b);
+            push(y.op, y.flags, 0, y.b);
+        } else if (same_word(command, "sleep")) {
+            std::string_view word = expect(tokens, "duration");
+            finish(tokens);
+            if (is_identifier(word)) {
+                push(Opcode::Sleep, instruction_flags::Register, 0, variable(word));
+            } else {
+                push(Opcode::Sleep, 0, 0, microseconds(word));
+            }
+        } else if (same_word(command, "wait_until")) {
+            std::string_view word = expect(tokens, "duration");
+            finish(tokens);
+            push(Opcode::WaitUntil, 0, 0, microseconds(word));
+        } else if (auto op = arithmetic(command)) {
+            std::string_view name = expect(tokens, "variable name");
+            if (!is_identifier(name)) {
+                fail("invalid variable name '" + std::string(name) + "'");
+            }
+            Instruction instruction{*op, 0, 0, 0};
+            operand(expect(tokens, "operand"), instruction);
+            finish(tokens);
+            int32_t destination = *op == Opcode::Set ? declare(std::string(name)) : variable(name);
+            push(instruction.op, instruction.flags, static_cast<uint16_t>(destination), instruction.b);
+        } else if (same_word(command, "loop")) {
+            Instruction count{Opcode::Set, 0, 0, 0};
+            operand(expect(tokens, "loop count"), count);
+            finish(tokens);
+
+            int32_t counter = declare("#loop" + std::to_string(loops++));
+            push(Opcode::Set, count.flags, static_cast<uint16_t>(counter), count.b);
+            size_t skip = push(Opcode::JumpUnless,
+                               static_cast<uint8_t>(instruction_flags::Register | (static_cast<uint8_t>(Comparison::Greater) << 4)),
+                               0, counter);
+            push(Opcode::Arg, 0, 0, 0);
+            blocks.push_back(Block{Block::Kind::Loop, line, skip, target(), counter});
+        } else if (same_word(command, "if")) {
+            Instruction left{Opcode::JumpUnless, 0, 0, 0};
+            Instruction right{Opcode::Arg, 0, 0, 0};
+            operand(expect(tokens, "left operand"), left);
+            std::string_view op_word = expect(tokens, "comparison");
+            auto comparison = parse_comparison(op_word);
+            if (!comparison) {
+                fail("invalid comparison '" + std::string(op_word) + "'");
+            }
+            operand(expect(tokens, "right operand"), right);
+            finish(tokens);
+
+            size_t test = push(Opcode::JumpUnless,
+                               static_cast<uint8_t>(left.flags | (static_cast<uint8_t>(*comparison) << 4)), 0, left.b);
+            push(Opcode::Arg, right.flags, 0, right.b);
+            blocks.push_back(Block{Block::Kind::If, line, test});
+        } else if (same_word(command, "else")) {
+            finish(tokens);
+            if (blocks.empty() || blocks.back().kind != Block::Kind::If) {
+                fail("else without if");
+            }
+            size_t jump = push(Opcode::Jump, 0, 0, 0);
+            program.code[blocks.back().patch].a = target();
+            blocks.back().kind = Block::Kind::Else;
+            blocks.back().patch = jump;
+        } else if (same_word(command, "end")) {
+            finish(tokens);
+            if (blocks.empty()) {
+                fail("end without loop or if");
+            }
+            Block block = blocks.back();
+            blocks.pop_back();
+            if (block.kind == Block::Kind::Loop) {
+                push(Opcode::Loop, 0, block.body, block.counter);
+            }
+            program.code[block.patch].a = target();
+        } else {
+            fail("unknown command '" + std::string(command) + "'");
+        }
+    }
+
+    /**
+     * @brief Map an arithmetic command to its opcode
+     */
+    static std::optional<Opcode> arithmetic(std::string_view command) {
+        if (same_word(command, "set")) return Opcode::Set;
+        if (same_word(command, "add")) return Opcode::Add;
+        if (same_word(command, "sub")) return Opcode::Sub;
+        if (same_word(command, "mul")) return Opcode::Mul;
+        if (same_word(command, "div")) return Opcode::Div;
+        if (same_word(command, "mod")) return Opcode::Mod;
+        return std::nullopt;
+    }
+
+    Bego& bego;
+    Program program;
+    std::vector<Block> blocks;
+    size_t line = 0;
+    size_t last_target = std::numeric_limits<size_t>::max();
+    size_t loops = 0;
+};
+
+/**
+ * @brief Sleep until a deadline, waking up periodically to check a cancel flag
+ * @return bool False if the wait was cancelled
+ */
+bool wait_until(std::chrono::steady_clock::time_point deadline, const std::atomic<bool>* cancel) {
+    if (!cancel) {
+        std::this_thread::sleep_until(deadline);
+        return true;
+    }
+
+    for (;;) {
+        if (cancel->load(std::memory_order_relaxed)) {
+            return false;
+        }
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            return true;
+        }
+        std::this_thread::sleep_until(std::min(deadline, now + cancel_poll_interval));
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Gets the next word of the line
+ *
+ * @details A word starting with '#' begins a comment, which ends the line.
+ *
+ * @return std::string_view The word, empty at the end of the line or at a comment
+ */
+std::string_view Tokenizer::next() {
+    while (position < line.size() && is_space(line[position])) {
+        position++;
+    }
+    if (position >= line.size() || line[position] == '#') {
+        position = line.size();
+        return {};
+    }
+
+    size_t start = position;
+    while (position < line.size() && !is_space(line[position])) {
+        position++;
+    }
+    return line.substr(start, position - start);
+}
+
+/**
+ * @brief Gets the rest of the line after the next run of whitespace
+ *
+ * @details Trailing carriage returns are dropped so CRLF files behave like LF files.
+ *
+ * @return std::string_view The remaining text, unparsed
+ */
+std::string_view Tokenizer::rest() {
+    while (position < line.size() && is_space(line[position])) {
+        position++;
+    }
+    std::string_view remaining = line.substr(std::min(position, line.size()));
+    while (!remaining.empty() && remaining.back() == '\r') {
+        remaining.remove_suffix(1);
+    }
+    position = line.size();
+    return remaining;
+}
+
+/**
+ * @brief Parses a decimal or 0x-prefixed hexadecimal integer
+ *
+ * @param word The text to parse
+ * @return std::optional<int32_t> The value, or std::nullopt if invalid or out of range
+ */
+std::optional<int32_t> parse_integer(std::string_view word) {
+    bool negative = false;
+    if (!word.empty() && (word[0] == '-' || word[0] == '+')) {
+        negative = word[0] == '-';
+        word.remove_prefix(1);
+    }
+
+    int base = 10;
+    if (word.size() > 2 && word[0] == '0' && (word[1] == 'x' || word[1] == 'X')) {
+        base = 16;
+        word.remove_prefix(2);
+    }
+    if (word.empty()) {
+        return std::nullopt;
+    }
+
+    int64_t value = 0;
+    for (char c : word) {
+        int digit;
+        if (c >= '0' && c <= '9') {
+            digit = c - '0';
+        } else if (base == 16 && std::isxdigit(static_cast<unsigned char>(c))) {
+            digit = std::tolower(static_cast<unsigned char>(c)) - 'a' + 10;
+        } else {
+            return std::nullopt;
+        }
+        value = value * base + digit;
+        if (value > static_cast<int64_t>(std::numeric_limits<int32_t>::max()) + 1) {
+            return std::nullopt;
+        }
+    }
+
+    value = negative ? -value : value;
+    if (value > std::numeric_limits<int32_t>::max()) {
+        return std::nullopt;
+    }
+    return static_cast<int32_t>(value);
+}
+
+/**
+ * @brief Parses a duration with a us, ms or s suffix
+ *
+ * @details A number without suffix counts milliseconds, the unit the rest of the
+ * library uses for durations in settings.
+ *
+ * @param word The text to parse
+ * @return std::optional<std::chrono::microseconds> The duration, or std::nullopt if invalid
+ */
+std::optional<std::chrono::microseconds> parse_duration(std::string_view word) {
+    int64_t scale = 1000;
+    if (word.size() > 2 && word.substr(word.size() - 2) == "us") {
+        scale = 1;
+        word.remove_suffix(2);
+    } else if (word.size() > 2 && word.substr(word.size() - 2) == "ms") {
+        word.remove_suffix(2);
+    } else if (word.size() > 1 && word.back() == 's') {
+        scale = 1000000;
+        word.remove_suffix(1);
+    }
+
+    if (word.empty() || word[0] == '-' || word[0] == '+' || (word.size() > 1 && (word[1] == 'x' || word[1] == 'X'))) {
+        return std::nullopt;
+    }
+    auto value = parse_integer(word);
+    if (!value) {
+        return std::nullopt;
+    }
+    return std::chrono::microseconds(static_cast<int64_t>(*value) * scale);
+}
+
+/**
+ * @brief Parses a direction name
+ *
+ * @param word The text to parse: click, press, down, release or up
+ * @return std::optional<Direction> The direction, or std::nullopt if invalid
+ */
+std::optional<Direction> parse_direction(std::string_view word) {
+    if (same_word(word, "click")) return Direction::Click;
+    if (same_word(word, "press") || same_word(word, "down")) return Direction::Press;
+    if (same_word(word, "release") || same_word(word, "up")) return Direction::Release;
+    return std::nullopt;
+}
+
+/**
+ * @brief Compiles a script into bytecode
+ *
+ * @details Compilation is a single pass; forward jumps of if, else and loop blocks
+ * are patched when the matching end is reached.
+ *
+ * @param source The script text
+ * @param bego Instance used to build key events for the current layout
+ * @return Program The compiled program
+ * @throws InputError If the script is invalid; the message names the line
+ */
+Program compile_script(std::string_view source, Bego& bego) {
+    return ScriptCompiler(bego).compile(source);
+}
+
+/**
+ * @brief Checks that a program is safe to run
+ *
+ * @details ScriptVM::run trusts its program: it neither bounds-checks jump targets,
+ * register indices or Emit ranges nor looks for the Arg that Move and JumpUnless
+ * read. The compiler only produces valid programs, so this is needed for programs
+ * loaded from elsewhere, such as a cache file or a library.
+ *
+ * @param program The program to check
+ * @return bool True if every operand refers to code, registers and events of the program
+ */
+bool validate(const Program& program) {
+    const size_t code_size = program.code.size();
+    const size_t registers = program.variables.size();
+    if (code_size == 0 || code_size > max_code_size || program.code.back().op != Opcode::Halt) {
+        return false;
+    }
+
+    auto is_register = [registers](int32_t index) {
+        return index >= 0 && static_cast<size_t>(index) < registers;
+    };
+    auto operand_ok = [&](const Instruction& instruction) {
+        return !(instruction.flags & instruction_flags::Register) || is_register(instruction.b);
+    };
+    auto followed_by_arg = [&](size_t pc) {
+        return pc + 1 < code_size && program.code[pc + 1].op == Opcode::Arg && operand_ok(program.code[pc + 1]);
+    };
+
+    for (size_t pc = 0; pc < code_size; pc++) {
+        const Instruction& instruction = program.code[pc];
+        switch (instruction.op) {
+            case Opcode::Emit:
+                if (instruction.b < 0 ||
+                    static_cast<size_t>(instruction.b) + instruction.a > program.events.size()) {
+                    return false;
+                }
+                break;
+            case Opcode::Move:
+                if (!operand_ok(instruction) || !followed_by_arg(pc)) {
+                    return false;
+                }
+                break;
+            case Opcode::Scroll:
+            case Opcode::Sleep:
+                if (!operand_ok(instruction)) {
+                    return false;
+                }
+                break;
+            case Opcode::Set:
+            case Opcode::Add:
+            case Opcode::Sub:
+            case Opcode::Mul:
+            case Opcode::Div:
+            case Opcode::Mod:
+                if (instruction.a >= registers || !operand_ok(instruction)) {
+                    return false;
+                }
+                break;
+            case Opcode::Loop:
+                if (instruction.a >= code_size || !is_register(instruction.b)) {
+                    return false;
+                }
+                break;
+            case Opcode::JumpUnless:
+                if (instruction.a >= code_size || (instruction.flags >> 4) > static_cast<uint8_t>(Comparison::GreaterEqual) ||
+                    !operand_ok(instruction) || !followed_by_arg(pc)) {
+                    return false;
+                }
+                break;
+            case Opcode::Jump:
+                if (instruction.a >= code_size) {
+                    return false;
+                }
+                break;
+            case Opcode::Arg:
+            case Opcode::WaitUntil:
+            case Opcode::Halt:
+                break;
+            default:
+                return false;
+        }
+    }
+
+    for (const Event& event : program.events) {
+        if (static_cast<size_t>(event.kind) >= EVENT_KIND_COUNT) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Hashes script source text
+ *
+ * @details FNV-1a: not cryptographic, but fast and stable across platforms and
+ * runs, which is all change detection needs.
+ *
+ * @param source The text to hash
+ * @param seed Starting value, to chain several inputs into one hash
+ * @return uint64_t The hash
+ */
+uint64_t script_hash(std::string_view source, uint64_t seed) {
+    uint64_t hash = seed;
+    for (char c : source) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+/**
+ * @brief Sends the pending batch, if any
+ *
+ * @param stats Counters to update
+ */
+void ScriptVM::flush(ScriptStats& stats) {
+    if (batch.empty()) {
+        return;
+    }
+    bego.send(batch.data(), batch.size());
+    stats.events += batch.size();
+    stats.batches++;
+    batch.clear();
+    cursor.reset();
+}
+
+/**
+ * @brief Runs a program to completion
+ *
+ * @details The dispatch loop is a plain switch rather than computed goto so it
+ * builds with every compiler the library supports; with 8-byte instructions and
+ * no allocation on the hot path the cost per instruction is a few nanoseconds.
+ * The cancel flag is checked at waits and on backward jumps, so even a loop
+ * without waits can be stopped.
+ *
+ * @param program The program to run
+ * @param cancel Optional flag that stops the run
+ * @return ScriptStats Counters for the run
+ * @throws InputError On division by zero or when sending fails
+ */
+ScriptStats ScriptVM::run(const Program& program, const std::atomic<bool>* cancel) {
+    using Clock = std::chrono::steady_clock;
+
+    ScriptStats stats;
+    registers.assign(program.variables.size(), 0);
+    batch.clear();
+    cursor.reset();
+
+    const Instruction* code = program.code.data();
+    const Event* pool = program.events.data();
+    int32_t* reg = registers.data();
+    const Clock::time_point start = Clock::now();
+    size_t pc = 0;
+    uint64_t executed = 0;
+
+    auto value = [reg](const Instruction& instruction) {
+        return (instruction.flags & instruction_flags::Register) ? reg[instruction.b] : instruction.b;
+    };
+    auto cancelled = [cancel, &stats] {
+        if (cancel && cancel->load(std::memory_order_relaxed)) {
+            stats.cancelled = true;
+        }
+        return stats.cancelled;
+    };
+
+    for (;;) {
+        const Instruction& instruction = code[pc++];
+        executed++;
+
+        switch (instruction.op) {
+            case Opcode::Emit:
+                batch.insert(batch.end(), pool + instruction.b, pool + instruction.b + instruction.a);
+                if (batch.size() >= max_batch) {
+                    flush(stats);
+                }
+                break;
+
+            case Opcode::Move: {
+                int32_t x = value(instruction);
+                int32_t y = value(code[pc++]);
+                // Relative moves start where the earlier moves of the batch left the cursor
+                bego.queue_move(batch, x, y,
+                                (instruction.flags & instruction_flags::Alternate) ? Coordinate::Abs : Coordinate::Rel,
+                                cursor);
+                break;
+            }
+
+            case Opcode::Scroll:
+                bego.queue_scroll(batch, value(instruction),
+                                  (instruction.flags & instruction_flags::Alternate) ? Axis::Horizontal : Axis::Vertical);
+                break;
+
+            case Opcode::Sleep: {
+                flush(stats);
+                int64_t us = (instruction.flags & instruction_flags::Register)
+                                 ? static_cast<int64_t>(reg[instruction.b]) * 1000
+                                 : instruction.b;
+                if (cancelled() || (us > 0 && !wait_until(Clock::now() + std::chrono::microseconds(us), cancel))) {
+                    stats.cancelled = true;
+                    stats.instructions = executed;
+                    return stats;
+                }
+                break;
+            }
+
+            case Opcode::WaitUntil:
+                flush(stats);
+                if (cancelled() || !wait_until(start + std::chrono::microseconds(instruction.b), cancel)) {
+                    stats.cancelled = true;
+                    stats.instructions = executed;
+                    return stats;
+                }
+                break;
+
+            case Opcode::Set:
+                reg[instruction.a] = value(instruction);
+                break;
+
+            case Opcode::Add:
+                reg[instruction.a] = wrap(static_cast<uint32_t>(reg[instruction.a]) + static_cast<uint32_t>(value(instruction)));
+                break;
+
+            case Opcode::Sub:
+                reg[instruction.a] = wrap(static_cast<uint32_t>(reg[instruction.a]) - static_cast<uint32_t>(value(instruction)));
+                break;
+
+            case Opcode::Mul:
+                reg[instruction.a] = wrap(static_cast<uint32_t>(reg[instruction.a]) * static_cast<uint32_t>(value(instruction)));
+                break;
+
+            case Opcode::Div:
+            case Opcode::Mod: {
+                int32_t divisor = value(instruction);
+                if (divisor == 0) {
+                    throw InputError(InputError::Type::InvalidInput, "Script divided by zero");
+                }
+                int32_t& target = reg[instruction.a];
+                if (divisor == -1) {
+                    // INT32_MIN / -1 overflows; -1 divides everything exactly
+                    target = instruction.op == Opcode::Div ? wrap(0u - static_cast<uint32_t>(target)) : 0;
+                } else {
+                    target = instruction.op == Opcode::Div ? target / divisor : target % divisor;
+                }
+                break;
+            }
+
+            case Opcode::Loop:
+                if (--reg[instruction.b] > 0) {
+                    if (cancelled()) {
+                        flush(stats);
+                        stats.instructions = executed;
+                        return stats;
+                    }
+                    pc = instruction.a;
+                }
+                break;
+
+            case Opcode::JumpUnless: {
+                int32_t left = value(instruction);
+                int32_t right = value(code[pc++]);
+                if (!compare(static_cast<Comparison>(instruction.flags >> 4), left, right)) {
+                    pc = instruction.a;
+                }
+                break;
+            }
+
+            case Opcode::Jump:
+                pc = instruction.a;
+                break;
+
+            case Opcode::Arg:
+            case Opcode::Halt:
+                flush(stats);
+                stats.instructions = executed;
+                return stats;
+        }
+    }
+}
+
+/**
+ * @brief Gets the value of a variable after a run
+ *
+ * @param program The program that was run
+ * @param name The variable name
+ * @return std::optional<int32_t> The value, or std::nullopt for unknown names
+ */
+std::optional<int32_t> ScriptVM::variable(const Program& program, std::string_view name) const {
+    for (size_t i = 0; i < program.variables.size() && i < registers.size(); i++) {
+        if (program.variables[i] == name) {
+            return registers[i];
+        }
+    }
+    return std::nullopt;
+}
+
+} // namespace bego
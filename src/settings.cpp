@@ -23,13 +23,15 @@ namespace bego {
  * - EVENT_MARKER (0x12345678) as the extra information for input events
  * - Keys are automatically released when the Bego object is destroyed
  * - Mouse movements bypass Windows acceleration for more predictable behavior
+ * - No maximum hold duration, so held inputs stay down until released
  * 
  * These defaults can be modified after construction if needed.
  */
 Settings::Settings() 
     : windows_dw_extra_info(EVENT_MARKER),
       release_keys_when_dropped(true),
-      windows_subject_to_mouse_speed_and_acceleration_level(false) {
+      windows_subject_to_mouse_speed_and_acceleration_level(false),
+      max_hold_duration(0) {
 }
 
 } // namespace bego 
\ No newline at end of file
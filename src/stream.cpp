@@ -0,0 +1,186 @@
+#include "../include/bego_stream.h"
+#include "../include/bego_win.h"
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file stream.cpp
+ * @author Eterninety
+ * @brief Implementation of pull-based event streams and the stream pump
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace bego {
+
+/**
+ * @brief Calls the generator until the buffer is full or the generator is done
+ *
+ * @param out Buffer receiving the events
+ * @param capacity Room in the buffer
+ * @return size_t Number of events written; 0 once the generator is done
+ */
+size_t GeneratorStream::read(Event* out, size_t capacity) {
+    size_t count = 0;
+    while (!done && count < capacity) {
+        if (generator(out[count])) {
+            count++;
+        } else {
+            done = true;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Constructs a pump
+ *
+ * @param bego The instance receiving the events
+ * @param chunk_size Events per chunk
+ * @param chunk_count Chunks in the ring
+ * @throws InputError If either size is zero
+ */
+StreamPump::StreamPump(Bego& bego, size_t chunk_size, size_t chunk_count)
+    : bego(bego), chunk_size(chunk_size), chunk_count(chunk_count) {
+    if (chunk_size == 0 || chunk_count == 0) {
+        throw InputError(InputError::Type::InvalidInput, "Stream chunks must hold at least one event");
+    }
+}
+
+/**
+ * @brief Dispatches a stream until it is exhausted or cancelled
+ *
+ * @details The producer thread fills chunks in ring order and publishes each one by
+ * advancing a counter under the lock; this thread dispatches published chunks in the
+ * same order and hands them back the same way. The lock is never held while events
+ * are generated or sent, so both sides run at once whenever the ring is neither
+ * full nor empty.
+ *
+ * @param source The stream to dispatch
+ * @param cancel Optional flag; setting it stops the run after the current chunk
+ * @return StreamStats What the run did
+ */
+StreamStats StreamPump::run(EventStream& source, const std::atomic<bool>* cancel) {
+    std::vector<Event> storage(chunk_size * chunk_count);
+    std::vector<size_t> counts(chunk_count, 0);
+
+    std::mutex mutex;
+    std::condition_variable filled;  // A chunk was published, or the producer finished
+    std::condition_variable freed;   // A chunk was handed back, or the run is stopping
+    uint64_t produced = 0;           // Chunks published so far
+    uint64_t consumed = 0;           // Chunks dispatched so far
+    bool finished = false;
+    bool stopping = false;
+    std::exception_ptr producer_error;
+    uint64_t producer_waits = 0;
+
+    std::thread producer([&] {
+        try {
+            for (;;) {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    if (!stopping && produced - consumed == chunk_count) {
+                        producer_waits++;
+                        freed.wait(lock, [&] { return stopping || produced - consumed < chunk_count; });
+                    }
+                    if (stopping) {
+                        return;
+                    }
+                }
+
+                // Only this thread touches the slot until it is published
+                const size_t slot = static_cast<size_t>(produced % chunk_count);
+                Event* chunk = storage.data() + slot * chunk_size;
+                size_t count = 0;
+                bool exhausted = false;
+                while (count < chunk_size) {
+                    size_t read = source.read(chunk + count, chunk_size - count);
+                    if (read == 0) {
+                        exhausted = true;
+                        break;
+                    }
+                    count += read;
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    counts[slot] = count;
+                    if (count > 0) {
+                        produced++;
+                    }
+                    finished = exhausted;
+                }
+                filled.notify_one();
+                if (exhausted) {
+                    return;
+                }
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            producer_error = std::current_exception();
+            finished = true;
+            filled.notify_one();
+        }
+    });
+
+    // Stop the producer and wait for it; used on every way out of this function
+    auto stop = [&] {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        freed.notify_one();
+        producer.join();
+    };
+
+    StreamStats stats;
+    try {
+        for (;;) {
+            if (cancel && cancel->load(std::memory_order_relaxed)) {
+                stats.cancelled = true;
+                break;
+            }
+
+            size_t slot;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                if (produced == consumed && !finished) {
+                    stats.consumer_waits++;
+                    filled.wait(lock, [&] { return produced > consumed || finished; });
+                }
+                if (producer_error || produced == consumed) {
+                    break;
+                }
+                slot = static_cast<size_t>(consumed % chunk_count);
+            }
+
+            bego.send(storage.data() + slot * chunk_size, counts[slot]);
+            stats.events += counts[slot];
+            stats.chunks++;
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                consumed++;
+            }
+            freed.notify_one();
+        }
+    } catch (...) {
+        stop();
+        throw;
+    }
+
+    stop();
+    if (producer_error) {
+        std::rethrow_exception(producer_error);
+    }
+    stats.producer_waits = producer_waits;
+    return stats;
+}
+
+} // namespace bego
@@ -0,0 +1,330 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../include/bego_win.h"
+#include "../include/bego_script.h"
+
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <unistd.h>
+#endif
+
+// bego-cli: drive input from a shell pipeline, one command per line on stdin.
+// Lines are tokenized in place in the read buffer, and every event produced between
+// two sleeps is sent as one batch: a batch goes out when a sleep is reached, when it
+// grows to MAX_BATCH events, or when all input read so far has been handled, so
+// commands typed interactively still take effect right away.
+//
+// Usage: bego-cli [--dry-run] [--stats]
+//   --dry-run  parse and build events but do not send them
+//   --stats    print command and event throughput to stderr on exit
+//
+// Commands use the script syntax:
+//   key <name> [click|down|up]        key ctrl down
+//   raw <scan> [click|down|up]        raw 0x1E
+//   button <name> [click|down|up]     button left
+//   move <x> <y> [abs|rel]            move 100 200 abs (abs is the default); rel moves
+//                                     start where the previous move left the cursor
+//   scroll <amount> [vertical|horizontal]
+//   text <rest of line>               \n and \t are unescaped
+//   sleep <duration>                  sleep 5ms
+// Blank lines and lines starting with '#' are ignored. Bad lines are reported on
+// stderr with their line number and skipped.
+
+using Clock = std::chrono::steady_clock;
+
+// Bytes read from stdin at once
+constexpr size_t READ_SIZE = 64 * 1024;
+
+// Largest batch sent in one dispatch
+constexpr size_t MAX_BATCH = 4096;
+
+std::unique_ptr<bego::Bego> g_bego;
+std::vector<bego::Event> g_batch;
+std::optional<std::pair<int, int>> g_cursor;  // Where g_batch leaves the cursor, empty once sent
+size_t g_commands = 0;
+size_t g_events = 0;
+size_t g_batches = 0;
+size_t g_errors = 0;
+
+// Read what is available from stdin, blocking only when nothing is; 0 at end of input
+size_t readInput(char* buffer, size_t size) {
+#if defined(_WIN32)
+    DWORD read = 0;
+    if (!ReadFile(GetStdHandle(STD_INPUT_HANDLE), buffer, static_cast<DWORD>(size), &read, nullptr)) {
+        return 0;
+    }
+    return read;
+#else
+    for (;;) {
+        ssize_t read = ::read(STDIN_FILENO, buffer, size);
+        if (read >= 0) {
+            return static_cast<size_t>(read);
+        }
+        if (errno != EINTR) {
+            return 0;
+        }
+    }
+#endif
+}
+
+// Send the pending batch, if any
+void flush() {
+    if (g_batch.empty()) {
+        return;
+    }
+    g_bego->send(g_batch.data(), g_batch.size());
+    g_events += g_batch.size();
+    g_batches++;
+    g_batch.clear();
+    g_cursor.reset();
+}
+
+// Compare two words ignoring ASCII case
+bool sameWord(std::string_view word, std::string_view expected) {
+    if (word.size() != expected.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < word.size(); i++) {
+        char c = word[i];
+        if (c >= 'A' && c <= 'Z') {
+            c = static_cast<char>(c - 'A' + 'a');
+        }
+        if (c != expected[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Parse an optional direction word; click when absent
+bego::Direction direction(std::string_view word) {
+    if (word.empty()) {
+        return bego::Direction::Click;
+    }
+    auto result = bego::parse_direction(word);
+    if (!result) {
+        throw bego::InputError(bego::InputError::Type::InvalidInput, "invalid direction '" + std::string(word) + "'");
+    }
+    return *result;
+}
+
+// Get a required word
+std::string_view expect(bego::Tokenizer& tokens, const char* what) {
+    std::string_view word = tokens.next();
+    if (word.empty()) {
+        throw bego::InputError(bego::InputError::Type::InvalidInput, std::string("missing ") + what);
+    }
+    return word;
+}
+
+// Get a required integer
+int32_t integer(bego::Tokenizer& tokens, const char* what) {
+    std::string_view word = expect(tokens, what);
+    auto value = bego::parse_integer(word);
+    if (!value) {
+        throw bego::InputError(bego::InputError::Type::InvalidInput,
+                               std::string("invalid ") + what + " '" + std::string(word) + "'");
+    }
+    return *value;
+}
+
+// Reject anything left on the line
+void finish(bego::Tokenizer& tokens) {
+    std::string_view extra = tokens.next();
+    if (!extra.empty()) {
+        throw bego::InputError(bego::InputError::Type::InvalidInput, "unexpected '" + std::string(extra) + "'");
+    }
+}
+
+// Run one line: queue its events, or flush and wait for a sleep
+void runLine(std::string_view line) {
+    bego::Tokenizer tokens(line);
+    std::string_view command = tokens.next();
+    if (command.empty()) {
+        return;
+    }
+
+    if (sameWord(command, "key")) {
+        std::string_view name = expect(tokens, "key name");
+        auto key = bego::key_from_name(name);
+        if (!key) {
+            throw bego::InputError(bego::InputError::Type::Mapping, "unknown key '" + std::string(name) + "'");
+        }
+        bego::Direction dir = direction(tokens.next());
+        finish(tokens);
+        g_bego->queue_key(g_batch, *key, dir);
+    } else if (sameWord(command, "move")) {
+        int32_t x = integer(tokens, "x");
+        int32_t y = integer(tokens, "y");
+        std::string_view mode = tokens.next();
+        bego::Coordinate coordinate = bego::Coordinate::Abs;
+        if (sameWord(mode, "rel")) {
+            coordinate = bego::Coordinate::Rel;
+        } else if (!mode.empty() && !sameWord(mode, "abs")) {
+            throw bego::InputError(bego::InputError::Type::InvalidInput,
+                                   "invalid coordinate mode '" + std::string(mode) + "'");
+        }
+        finish(tokens);
+        g_bego->queue_move(g_batch, x, y, coordinate, g_cursor);
+    } else if (sameWord(command, "button")) {
+        std::string_view name = expect(tokens, "button name");
+        auto button = bego::button_from_name(name);
+        if (!button) {
+            throw bego::InputError(bego::InputError::Type::Mapping, "unknown button '" + std::string(name) + "'");
+        }
+        bego::Direction dir = direction(tokens.next());
+        finish(tokens);
+        g_bego->queue_button(g_batch, *button, dir);
+    } else if (sameWord(command, "raw")) {
+        int32_t scan = integer(tokens, "scan code");
+        if (scan < 0 || scan > 0xFFFF) {
+            throw bego::InputError(bego::InputError::Type::InvalidInput, "scan code out of range");
+        }
+        bego::Direction dir = direction(tokens.next());
+        finish(tokens);
+        g_bego->queue_raw(g_batch, static_cast<uint16_t>(scan), dir);
+    } else if (sameWord(command, "scroll")) {
+        int32_t amount = integer(tokens, "scroll amount");
+        std::string_view word = tokens.next();
+        bego::Axis axis = bego::Axis::Vertical;
+        if (sameWord(word, "horizontal")) {
+            axis = bego::Axis::Horizontal;
+        } else if (!word.empty() && !sameWord(word, "vertical")) {
+            throw bego::InputError(bego::InputError::Type::InvalidInput, "invalid axis '" + std::string(word) + "'");
+        }
+        finish(tokens);
+        g_bego->queue_scroll(g_batch, amount, axis);
+    } else if (sameWord(command, "text")) {
+        std::string_view raw_text = tokens.rest();
+        std::string text;
+        text.reserve(raw_text.size());
+        for (size_t i = 0; i < raw_text.size(); i++) {
+            char c = raw_text[i];
+            if (c == '\\' && i + 1 < raw_text.size()) {
+                char next = raw_text[++i];
+                c = next == 'n' ? '\n' : next == 't' ? '\t' : next;
+            }
+            text.push_back(c);
+        }
+        if (text.empty()) {
+            throw bego::InputError(bego::InputError::Type::InvalidInput, "missing text");
+        }
+        g_bego->queue_text(g_batch, text);
+    } else if (sameWord(command, "sleep")) {
+        std::string_view word = expect(tokens, "duration");
+        auto duration = bego::parse_duration(word);
+        if (!duration) {
+            throw bego::InputError(bego::InputError::Type::InvalidInput, "invalid duration '" + std::string(word) + "'");
+        }
+        finish(tokens);
+        flush();
+        std::this_thread::sleep_for(*duration);
+    } else {
+        throw bego::InputError(bego::InputError::Type::InvalidInput, "unknown command '" + std::string(command) + "'");
+    }
+
+    g_commands++;
+    if (g_batch.size() >= MAX_BATCH) {
+        flush();
+    }
+}
+
+int main(int argc, char** argv) {
+    bool dry_run = false;
+    bool stats = false;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--dry-run") {
+            dry_run = true;
+        } else if (arg == "--stats") {
+            stats = true;
+        } else {
+            std::cerr << "Usage: bego-cli [--dry-run] [--stats]" << std::endl;
+            return 2;
+        }
+    }
+
+    try {
+        g_bego = dry_run ? std::make_unique<bego::Bego>(bego::Settings(), std::make_shared<bego::NullBackend>())
+                         : std::make_unique<bego::Bego>(bego::Settings());
+    } catch (const bego::InputError& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    g_batch.reserve(MAX_BATCH + 64);
+
+    // Unconsumed bytes are kept at the front; the buffer only grows for longer lines
+    std::vector<char> buffer(READ_SIZE);
+    size_t filled = 0;
+    size_t line_number = 0;
+    const auto start = Clock::now();
+
+    try {
+        for (;;) {
+            if (buffer.size() - filled < READ_SIZE / 2) {
+                buffer.resize(buffer.size() * 2);
+            }
+            size_t read = readInput(buffer.data() + filled, buffer.size() - filled);
+            const bool end = read == 0;
+            filled += read;
+
+            const char* begin = buffer.data();
+            const char* const stop = begin + filled;
+            for (;;) {
+                const char* newline = static_cast<const char*>(std::memchr(begin, '\n', stop - begin));
+                if (!newline) {
+                    if (!end || begin == stop) {
+                        break;
+                    }
+                    newline = stop;  // Last line without a newline
+                }
+
+                std::string_view line(begin, newline - begin);
+                if (!line.empty() && line.back() == '\r') {
+                    line.remove_suffix(1);
+                }
+                line_number++;
+                try {
+                    runLine(line);
+                } catch (const bego::InputError& e) {
+                    if (e.get_type() == bego::InputError::Type::Simulate) {
+                        throw;  // Sending failed; later lines would fail the same way
+                    }
+                    std::cerr << "line " << line_number << ": " << e.what() << std::endl;
+                    g_errors++;
+                }
+                begin = newline == stop ? stop : newline + 1;
+            }
+
+            // Everything read so far has run; send it before possibly blocking
+            flush();
+            if (end) {
+                break;
+            }
+            filled = static_cast<size_t>(stop - begin);
+            std::memmove(buffer.data(), begin, filled);
+        }
+    } catch (const bego::InputError& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    if (stats) {
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        std::cerr << std::fixed << std::setprecision(0) << g_commands << " commands, " << g_events << " events in "
+                  << g_batches << " batches, " << g_errors << " errors; " << g_commands / seconds
+                  << " commands/s" << std::endl;
+    }
+    return g_errors == 0 ? 0 : 1;
+}
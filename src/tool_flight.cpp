@@ -0,0 +1,122 @@
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../include/bego_win.h"
+#include "../include/bego_flight.h"
+#include "../include/bego_replay.h"
+
+// bego-flight: list or replay a flight dump written by the flight recorder.
+// Records are listed oldest first with their sequence number, the time relative to
+// the first listed record, the call that dispatched them and the event. Gaps in the
+// sequence numbers (slots overwritten while the dump was taken) are reported.
+//
+// Usage: bego-flight <dump> [--last N] [--replay] [--speed F] [--dry-run]
+//   --last     only the last N records
+//   --replay   replay the records with their original timing instead of listing them
+//   --speed    playback speed factor (default 1)
+//   --dry-run  replay into a backend that discards everything
+
+const char* originName(bego::EventOrigin origin) {
+    static const char* names[] = {"key", "raw", "button", "scroll", "move", "text", "send"};
+    size_t index = static_cast<size_t>(origin);
+    return index < std::size(names) ? names[index] : "?";
+}
+
+std::string describe(const bego::Event& event) {
+    static const char* kinds[] = {"KeyDown", "KeyUp", "ButtonDown", "ButtonUp", "MoveAbs", "MoveRel", "Wheel", "HWheel"};
+    size_t kind = static_cast<size_t>(event.kind);
+    return std::string(kind < std::size(kinds) ? kinds[kind] : "?") + " code=" + std::to_string(event.code) +
+           " payload=" + std::to_string(event.payload) + " flags=" + std::to_string(event.flags);
+}
+
+void listRecords(const std::vector<bego::FlightRecord>& records, size_t first) {
+    const int64_t origin = records[first].timestamp;
+    uint64_t expected = records[first].sequence;
+
+    for (size_t i = first; i < records.size(); i++) {
+        const bego::FlightRecord& record = records[i];
+        if (record.sequence != expected) {
+            std::cout << "  ... " << record.sequence - expected << " record(s) lost" << std::endl;
+        }
+        expected = record.sequence + 1;
+        std::cout << std::setw(10) << record.sequence << std::setw(14) << (record.timestamp - origin) / 1e6 << " ms  "
+                  << std::left << std::setw(7) << originName(record.origin) << std::right << describe(record.event)
+                  << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string path;
+    size_t last = 0;
+    bool replaying = false;
+    bool dry_run = false;
+    double speed = 1.0;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--last" && i + 1 < argc) {
+            last = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--replay") {
+            replaying = true;
+        } else if (arg == "--speed" && i + 1 < argc) {
+            speed = std::atof(argv[++i]);
+        } else if (arg == "--dry-run") {
+            dry_run = true;
+        } else if (path.empty()) {
+            path = arg;
+        } else {
+            path.clear();
+            break;
+        }
+    }
+    if (path.empty() || speed <= 0) {
+        std::cerr << "Usage: bego-flight <dump> [--last N] [--replay] [--speed F] [--dry-run]" << std::endl;
+        return 2;
+    }
+
+    std::cout << std::fixed << std::setprecision(3);
+    try {
+        bego::FlightDumpHeader header;
+        std::vector<bego::FlightRecord> records = bego::FlightRecorder::load(path, header);
+        std::cout << path << ": " << header.record_count << " records of " << header.next_sequence
+                  << " recorded" << std::endl;
+        if (records.empty()) {
+            return 0;
+        }
+
+        const size_t first = last > 0 && last < records.size() ? records.size() - last : 0;
+        std::cout << "Dump taken " << (header.steady_time - records.back().timestamp) / 1e6
+                  << " ms after the last record" << std::endl;
+
+        if (!replaying) {
+            listRecords(records, first);
+            return 0;
+        }
+
+        std::vector<bego::TimedEvent> events;
+        events.reserve(records.size() - first);
+        for (size_t i = first; i < records.size(); i++) {
+            events.push_back({records[i].timestamp - records[first].timestamp, records[i].event});
+        }
+
+        std::shared_ptr<bego::Backend> backend;
+        if (dry_run) {
+            backend = std::make_shared<bego::NullBackend>();
+        } else {
+            backend = std::make_shared<bego::Win32Backend>();
+        }
+        bego::Bego bego(bego::Settings(), backend);
+
+        bego::SpanTrack track(events.data(), events.size());
+        bego::Replay replay;
+        replay.add_track(track, speed);
+        size_t played = replay.play(bego);
+        std::cout << "Replayed " << played << " events" << (dry_run ? " (dry run)" : "") << std::endl;
+        return 0;
+    } catch (const bego::InputError& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,443 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <cstdlib>
+#include <memory>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../include/bego_win.h"
+#include "../include/bego_mapped_file.h"
+#include "../include/bego_recording.h"
+
+// bego-import: convert CSV event logs into binary recordings.
+// The input is memory-mapped, split into one chunk per thread at line boundaries
+// and parsed in parallel; the sorted chunks are then merged into the recording.
+//
+// Usage: bego-import <input.csv> <output> [--threads N]
+//
+// Each line is "timestamp,kind,name,x,y"; trailing empty fields may be left out.
+//   timestamp  milliseconds from the start of the log, with up to six decimals
+//   kind       key_down, key_up, button_down, button_up, move, move_abs, wheel or hwheel
+//   name       a Key name for key events ("W", "PageUp", "enter") or a Button name
+//   x, y       distance for move, normalized 0-65535 coordinates for move_abs,
+//              wheel data (120 per notch) in x for wheel and hwheel
+// Blank lines, lines starting with '#' and a leading "timestamp,..." header are skipped.
+
+using Clock = std::chrono::steady_clock;
+
+// Most errors kept per chunk; the rest are only counted
+constexpr size_t MAX_ERRORS = 10;
+
+// Key down events for every Key, resolved for the current layout before parsing starts
+std::array<bego::Event, static_cast<size_t>(bego::Key::Unicode)> g_keyEvents;
+
+// A parse error; line is counted from the start of its chunk
+struct ParseError {
+    size_t line;
+    std::string message;
+};
+
+// A slice of the input and what was parsed from it
+struct Chunk {
+    const char* begin = nullptr;
+    const char* end = nullptr;
+    std::vector<bego::TimedEvent> records;
+    std::vector<ParseError> errors;
+    size_t lines = 0;
+    size_t error_count = 0;
+};
+
+// Log event kinds and the recording events they become
+struct KindName {
+    const char* name;
+    bego::EventKind kind;
+};
+
+const KindName g_kinds[] = {
+    {"key_down", bego::EventKind::KeyDown}, {"key_up", bego::EventKind::KeyUp},
+    {"button_down", bego::EventKind::ButtonDown}, {"button_up", bego::EventKind::ButtonUp},
+    {"move", bego::EventKind::MoveRel}, {"move_abs", bego::EventKind::MoveAbs},
+    {"wheel", bego::EventKind::Wheel}, {"hwheel", bego::EventKind::HWheel}
+};
+
+// Drop surrounding spaces and tabs
+std::string_view trim(std::string_view text) {
+    size_t first = 0;
+    size_t last = text.size();
+    while (first < last && (text[first] == ' ' || text[first] == '\t')) {
+        first++;
+    }
+    while (last > first && (text[last - 1] == ' ' || text[last - 1] == '\t')) {
+        last--;
+    }
+    return text.substr(first, last - first);
+}
+
+// Compare a field with a lowercase word, ignoring case
+bool sameWord(std::string_view field, const char* word) {
+    size_t i = 0;
+    for (; i < field.size() && word[i] != '\0'; i++) {
+        char c = field[i];
+        if (c >= 'A' && c <= 'Z') {
+            c = static_cast<char>(c - 'A' + 'a');
+        }
+        if (c != word[i]) {
+            return false;
+        }
+    }
+    return i == field.size() && word[i] == '\0';
+}
+
+// Parse a signed decimal integer that fits in 32 bits
+bool parseInt(std::string_view text, int64_t& value) {
+    size_t i = 0;
+    bool negative = false;
+    if (i < text.size() && (text[i] == '-' || text[i] == '+')) {
+        negative = text[i] == '-';
+        i++;
+    }
+    if (i == text.size()) {
+        return false;
+    }
+
+    value = 0;
+    for (; i < text.size(); i++) {
+        if (text[i] < '0' || text[i] > '9' || value > 0xFFFFFFFFLL) {
+            return false;
+        }
+        value = value * 10 + (text[i] - '0');
+    }
+    if (negative) {
+        value = -value;
+    }
+    return value >= INT32_MIN && value <= INT32_MAX;
+}
+
+// Parse milliseconds with up to six decimals into nanoseconds
+bool parseTimestamp(std::string_view text, int64_t& ns) {
+    size_t i = 0;
+    int64_t ms = 0;
+    for (; i < text.size() && text[i] >= '0' && text[i] <= '9'; i++) {
+        if (i == 12) {
+            return false;  // Over 31 years; would overflow once scaled
+        }
+        ms = ms * 10 + (text[i] - '0');
+    }
+    if (i == 0) {
+        return false;
+    }
+
+    int64_t fraction = 0;
+    int64_t scale = 1000000;
+    if (i < text.size() && text[i] == '.') {
+        i++;
+        for (; i < text.size() && text[i] >= '0' && text[i] <= '9'; i++) {
+            scale /= 10;
+            if (scale == 0) {
+                return false;  // Below a nanosecond
+            }
+            fraction += (text[i] - '0') * scale;
+        }
+    }
+
+    ns = ms * 1000000 + fraction;
+    return i == text.size();
+}
+
+// Parse one line into records. Returns false and sets error for a bad line.
+bool parseLine(std::string_view line, std::vector<bego::TimedEvent>& out, std::string& error) {
+    std::string_view fields[5];
+    size_t count = 0;
+    size_t start = 0;
+    for (;;) {
+        size_t comma = line.find(',', start);
+        if (count == 5) {
+            error = "too many fields";
+            return false;
+        }
+        fields[count++] = trim(line.substr(start, comma == std::string_view::npos ? comma : comma - start));
+        if (comma == std::string_view::npos) {
+            break;
+        }
+        start = comma + 1;
+    }
+
+    int64_t time;
+    if (!parseTimestamp(fields[0], time)) {
+        error = "bad timestamp '" + std::string(fields[0]) + "'";
+        return false;
+    }
+
+    const KindName* kind = nullptr;
+    for (const KindName& entry : g_kinds) {
+        if (sameWord(fields[1], entry.name)) {
+            kind = &entry;
+            break;
+        }
+    }
+    if (kind == nullptr) {
+        error = "unknown event kind '" + std::string(fields[1]) + "'";
+        return false;
+    }
+
+    int64_t x = 0;
+    int64_t y = 0;
+    if ((!fields[3].empty() && !parseInt(fields[3], x)) || (!fields[4].empty() && !parseInt(fields[4], y))) {
+        error = "bad coordinate";
+        return false;
+    }
+
+    switch (kind->kind) {
+        case bego::EventKind::KeyDown:
+        case bego::EventKind::KeyUp: {
+            std::optional<bego::Key> key = bego::key_from_name(fields[2]);
+            if (!key || *key == bego::Key::Unicode) {
+                error = "unknown key '" + std::string(fields[2]) + "'";
+                return false;
+            }
+            bego::Event event = g_keyEvents[static_cast<size_t>(*key)];
+            event.kind = kind->kind;
+            out.push_back({time, event});
+            return true;
+        }
+        case bego::EventKind::ButtonDown:
+        case bego::EventKind::ButtonUp: {
+            std::optional<bego::Button> button = bego::button_from_name(fields[2]);
+            if (!button || *button > bego::Button::Forward) {  // Scrolling is logged as wheel events
+                error = "unknown button '" + std::string(fields[2]) + "'";
+                return false;
+            }
+            out.push_back({time, bego::Event::button(kind->kind == bego::EventKind::ButtonUp, *button)});
+            return true;
+        }
+        case bego::EventKind::MoveAbs:
+            if (x < 0 || x > 65535 || y < 0 || y > 65535) {
+                error = "absolute coordinates must be 0-65535";
+                return false;
+            }
+            out.push_back({time, bego::Event::move(true, static_cast<int>(x), static_cast<int>(y))});
+            return true;
+        case bego::EventKind::MoveRel:
+            // Split so each part fits the 16-bit relative range of an Event
+            do {
+                int64_t px = std::clamp<int64_t>(x, -32768, 32767);
+                int64_t py = std::clamp<int64_t>(y, -32768, 32767);
+                out.push_back({time, bego::Event::move(false, static_cast<int>(px), static_cast<int>(py))});
+                x -= px;
+                y -= py;
+            } while (x != 0 || y != 0);
+            return true;
+        default:
+            out.push_back({time, bego::Event::wheel(kind->kind == bego::EventKind::HWheel ? bego::Axis::Horizontal
+                                                                                          : bego::Axis::Vertical,
+                                                    static_cast<int>(x))});
+            return true;
+    }
+}
+
+// Parse a chunk and sort its records by timestamp
+void parseChunk(Chunk& chunk, bool first) {
+    // A rough guess of 24 bytes per line saves most reallocations
+    chunk.records.reserve(static_cast<size_t>(chunk.end - chunk.begin) / 24);
+    std::string error;
+    const char* cursor = chunk.begin;
+
+    while (cursor < chunk.end) {
+        const char* newline = static_cast<const char*>(std::memchr(cursor, '\n', chunk.end - cursor));
+        const char* line_end = newline ? newline : chunk.end;
+        std::string_view line(cursor, line_end - cursor);
+        cursor = newline ? newline + 1 : chunk.end;
+        chunk.lines++;
+
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        std::string_view content = trim(line);
+        if (content.empty() || content[0] == '#') {
+            continue;
+        }
+        if (first && chunk.lines == 1 && sameWord(trim(content.substr(0, content.find(','))), "timestamp")) {
+            continue;
+        }
+
+        if (!parseLine(content, chunk.records, error)) {
+            if (chunk.errors.size() < MAX_ERRORS) {
+                chunk.errors.push_back({chunk.lines, error});
+            }
+            chunk.error_count++;
+        }
+    }
+
+    auto earlier = [](const bego::TimedEvent& a, const bego::TimedEvent& b) { return a.timestamp < b.timestamp; };
+    if (!std::is_sorted(chunk.records.begin(), chunk.records.end(), earlier)) {
+        std::stable_sort(chunk.records.begin(), chunk.records.end(), earlier);
+    }
+}
+
+// Split the input into chunks that start at the beginning of a line
+std::vector<Chunk> splitInput(const char* data, size_t size, size_t count) {
+    std::vector<Chunk> chunks;
+    const char* end = data + size;
+    const char* begin = data;
+    for (size_t i = 1; i <= count && begin < end; i++) {
+        const char* split = i == count ? end : data + size / count * i;
+        if (split < begin) {
+            split = begin;
+        }
+        if (split < end) {
+            const char* newline = static_cast<const char*>(std::memchr(split, '\n', end - split));
+            split = newline ? newline + 1 : end;
+        }
+        chunks.emplace_back();
+        chunks.back().begin = begin;
+        chunks.back().end = split;
+        begin = split;
+    }
+    return chunks;
+}
+
+// Write the sorted chunks to the recording, merging them where they overlap in time
+void writeChunks(const std::vector<Chunk>& chunks, bego::RecordingWriter& writer) {
+    bool ordered = true;
+    int64_t last = INT64_MIN;
+    for (const Chunk& chunk : chunks) {
+        if (!chunk.records.empty()) {
+            ordered = ordered && chunk.records.front().timestamp >= last;
+            last = chunk.records.back().timestamp;
+        }
+    }
+
+    // The usual case: the log is in time order, so the chunks follow each other
+    if (ordered) {
+        for (const Chunk& chunk : chunks) {
+            for (const bego::TimedEvent& record : chunk.records) {
+                writer.append(record);
+            }
+        }
+        return;
+    }
+
+    // Otherwise a k-way merge; ties go to the earlier chunk to keep file order
+    using Head = std::pair<int64_t, size_t>;
+    std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heads;
+    std::vector<size_t> positions(chunks.size(), 0);
+    for (size_t i = 0; i < chunks.size(); i++) {
+        if (!chunks[i].records.empty()) {
+            heads.push({chunks[i].records.front().timestamp, i});
+        }
+    }
+    while (!heads.empty()) {
+        size_t i = heads.top().second;
+        heads.pop();
+        const std::vector<bego::TimedEvent>& records = chunks[i].records;
+        size_t& position = positions[i];
+
+        // Take the whole run that stays ahead of the next chunk
+        const int64_t limit = heads.empty() ? INT64_MAX : heads.top().first;
+        do {
+            writer.append(records[position++]);
+        } while (position < records.size() && records[position].timestamp < limit);
+
+        if (position < records.size()) {
+            heads.push({records[position].timestamp, i});
+        }
+    }
+}
+
+// Bytes per second in GB/s
+double gigabytesPerSecond(size_t bytes, Clock::duration elapsed) {
+    return bytes / 1e9 / std::max(std::chrono::duration<double>(elapsed).count(), 1e-9);
+}
+
+int main(int argc, char** argv) {
+    std::string input;
+    std::string output;
+    size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            threads = std::max<size_t>(1, std::strtoull(argv[++i], nullptr, 10));
+        } else if (input.empty()) {
+            input = arg;
+        } else if (output.empty()) {
+            output = arg;
+        } else {
+            input.clear();
+            break;
+        }
+    }
+    if (input.empty() || output.empty()) {
+        std::cerr << "Usage: bego-import <input.csv> <output> [--threads N]" << std::endl;
+        return 2;
+    }
+
+    try {
+        // Resolve key codes once; the parser threads only read this table
+        bego::Bego bego(bego::Settings(), std::make_shared<bego::NullBackend>());
+        std::vector<bego::Event> events;
+        for (size_t i = 0; i < g_keyEvents.size(); i++) {
+            events.clear();
+            bego.queue_key(events, static_cast<bego::Key>(i), bego::Direction::Press);
+            g_keyEvents[i] = events.front();
+        }
+
+        const auto start = Clock::now();
+        bego::MappedFile file(input);
+        const char* data = reinterpret_cast<const char*>(file.data());
+        std::vector<Chunk> chunks = splitInput(data, file.size(), threads);
+
+        std::vector<std::thread> workers;
+        for (size_t i = 0; i < chunks.size(); i++) {
+            workers.emplace_back(parseChunk, std::ref(chunks[i]), i == 0);
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        const auto parsed = Clock::now();
+
+        // Report errors with line numbers counted from the start of the file
+        size_t errors = 0;
+        size_t first_line = 0;
+        for (const Chunk& chunk : chunks) {
+            for (const ParseError& error : chunk.errors) {
+                if (errors < MAX_ERRORS) {
+                    std::cerr << input << ":" << first_line + error.line << ": " << error.message << std::endl;
+                }
+                errors++;
+            }
+            errors += chunk.error_count - chunk.errors.size();
+            first_line += chunk.lines;
+        }
+        if (errors > 0) {
+            if (errors > MAX_ERRORS) {
+                std::cerr << "... and " << errors - MAX_ERRORS << " more errors" << std::endl;
+            }
+            std::cerr << "Nothing written" << std::endl;
+            return 1;
+        }
+
+        bego::RecordingWriter writer(output);
+        writeChunks(chunks, writer);
+        const uint64_t records = writer.size();
+        writer.close();
+        const auto finished = Clock::now();
+
+        std::cout << std::fixed << std::setprecision(2)
+                  << "Imported " << records << " events from " << first_line << " lines ("
+                  << file.size() / 1e6 << " MB) using " << chunks.size() << " threads" << std::endl
+                  << "Parse: " << std::chrono::duration<double, std::milli>(parsed - start).count() << " ms ("
+                  << gigabytesPerSecond(file.size(), parsed - start) << " GB/s), total: "
+                  << std::chrono::duration<double, std::milli>(finished - start).count() << " ms ("
+                  << gigabytesPerSecond(file.size(), finished - start) << " GB/s)" << std::endl;
+        return 0;
+    } catch (const bego::InputError& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
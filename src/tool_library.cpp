@@ -0,0 +1,97 @@
+#include <iostream>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../include/bego_win.h"
+#include "../include/bego_script_library.h"
+
+// bego-library: build and inspect macro library files.
+//
+// Usage: bego-library build <output> <directory> [--extension EXT]
+//          Compile every script in the directory (default extension .bego) into one
+//          library; each macro is named after its file without the extension.
+//        bego-library list <library>
+//          Print the name and size of every macro.
+
+namespace fs = std::filesystem;
+
+// Compile a directory of scripts into a library
+int buildLibrary(const std::string& output, const std::string& directory, const std::string& extension) {
+    bego::Bego bego(bego::Settings(), std::make_shared<bego::NullBackend>());
+    bego::ScriptLibraryBuilder builder;
+
+    std::vector<fs::path> paths;
+    for (const fs::directory_entry& entry : fs::directory_iterator(directory)) {
+        if (entry.is_regular_file() && entry.path().extension() == extension) {
+            paths.push_back(entry.path());
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+
+    size_t failed = 0;
+    for (const fs::path& path : paths) {
+        std::ifstream in(path, std::ios::binary);
+        std::stringstream source;
+        source << in.rdbuf();
+        try {
+            builder.add_script(path.stem().string(), source.str(), bego);
+        } catch (const bego::InputError& e) {
+            std::cerr << path.string() << ": " << e.what() << std::endl;
+            failed++;
+        }
+    }
+    if (failed > 0) {
+        std::cerr << failed << " scripts failed to compile; nothing written" << std::endl;
+        return 1;
+    }
+
+    builder.write(output);
+    std::cout << "Wrote " << builder.size() << " macros to " << output << std::endl;
+    return 0;
+}
+
+// List the macros of a library
+int listLibrary(const std::string& path) {
+    bego::ScriptLibrary library(path);
+    for (size_t i = 0; i < library.size(); i++) {
+        std::string_view name = library.name(i);
+        std::shared_ptr<const bego::Program> program = library.find(name);
+        std::cout << name << "  " << program->code.size() << " instructions, " << program->events.size()
+                  << " events" << std::endl;
+    }
+    std::cout << library.size() << " macros" << std::endl;
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> args(argv + 1, argv + argc);
+    try {
+        if (args.size() >= 3 && args[0] == "build") {
+            std::string extension = ".bego";
+            if (args.size() == 5 && args[3] == "--extension") {
+                extension = args[4];
+            } else if (args.size() != 3) {
+                args.clear();
+            }
+            if (!args.empty()) {
+                return buildLibrary(args[1], args[2], extension);
+            }
+        } else if (args.size() == 2 && args[0] == "list") {
+            return listLibrary(args[1]);
+        }
+    } catch (const bego::InputError& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    } catch (const fs::filesystem_error& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cerr << "Usage: bego-library build <output> <directory> [--extension EXT]" << std::endl
+              << "       bego-library list <library>" << std::endl;
+    return 2;
+}
@@ -0,0 +1,386 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+#include "../include/bego_win.h"
+#include "../include/bego_recording.h"
+
+// bego-loadgen: push input at a fixed target rate and measure how dispatch keeps up.
+// The generator is open-loop: event i is due at start + i / rate whether or not
+// earlier events have been sent, and is queued with that intended time. A slow
+// backend therefore shows up as growing latency, queue depth and drops instead of
+// silently lowering the offered rate, and latency is measured from the intended
+// time, not from when the event happened to be queued.
+//
+// Usage: bego-loadgen [--rate HZ] [--seconds N] [--seed N] [--mix K,B,M,S]
+//                     [--recording FILE] [--backend os|null|busy] [--cost NS]
+//                     [--queue N] [--batch N]
+//   --rate       events per second to offer (default 10000)
+//   --seconds    length of the run (default 5)
+//   --seed       random seed (default 1)
+//   --mix        relative weights of key, button, move and scroll events (default 4,1,4,1)
+//   --recording  cycle through the events of a recording instead of random ones
+//   --backend    os sends for real, null discards, busy spins for --cost per event (default null)
+//   --cost       simulated dispatch cost per event for the busy backend (default 1000)
+//   --queue      events the queue holds before new ones are dropped; key and button
+//                releases are never dropped, the generator waits for room instead (default 65536)
+//   --batch      most events sent in one dispatch (default 256)
+
+using Clock = std::chrono::steady_clock;
+
+// Nanoseconds on the steady clock
+int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+// Most latency samples kept; later events are counted but not sampled
+constexpr size_t MAX_SAMPLES = 50000000;
+
+// Backend that spins for a fixed time per event, standing in for a slow target
+class BusyBackend : public bego::Backend {
+public:
+    explicit BusyBackend(int64_t cost_ns) : cost_ns(cost_ns) {}
+
+    void dispatch(const bego::Event*, size_t count) override {
+        const int64_t until = nowNs() + cost_ns * static_cast<int64_t>(count);
+        while (nowNs() < until) {
+        }
+    }
+
+private:
+    int64_t cost_ns;
+};
+
+// An event with the time it should have been sent
+struct Offered {
+    int64_t due;
+    bego::Event event;
+};
+
+// Single-producer, single-consumer ring of offered events
+class OfferQueue {
+public:
+    explicit OfferQueue(size_t capacity) : slots(capacity), capacity(capacity) {}
+
+    // Add an event; false if the queue is full
+    bool push(const Offered& offered) {
+        const uint64_t tail = write.load(std::memory_order_relaxed);
+        if (tail - read.load(std::memory_order_acquire) == capacity) {
+            return false;
+        }
+        slots[tail % capacity] = offered;
+        write.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Copy up to max events out; returns how many, and the depth before taking them
+    size_t pop(Offered* out, size_t max, size_t& depth) {
+        const uint64_t head = read.load(std::memory_order_relaxed);
+        depth = static_cast<size_t>(write.load(std::memory_order_acquire) - head);
+        const size_t count = std::min(depth, max);
+        for (size_t i = 0; i < count; i++) {
+            out[i] = slots[(head + i) % capacity];
+        }
+        read.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+private:
+    std::vector<Offered> slots;
+    const size_t capacity;
+    alignas(64) std::atomic<uint64_t> write{0};
+    alignas(64) std::atomic<uint64_t> read{0};
+};
+
+// Produces the offered events: a weighted random mix, or a recording played in a loop
+class Mix {
+public:
+    Mix(bego::Bego& bego, uint32_t seed, const std::vector<int>& weights) : rng(seed) {
+        for (char c = 'a'; c <= 'z'; c++) {
+            std::vector<bego::Event> events;
+            bego.queue_key(events, *bego::key_from_name(std::string(1, c)), bego::Direction::Press);
+            keys.push_back(events.front());
+        }
+        int total = 0;
+        for (int weight : weights) {
+            total += weight;
+            bounds.push_back(total);
+        }
+    }
+
+    explicit Mix(const bego::RecordingTrack& track) : script(track.records()), script_size(track.size()) {}
+
+    bego::Event next() {
+        if (script) {
+            bego::Event event = script[position].event;
+            position = (position + 1) % script_size;
+            return event;
+        }
+
+        // A held key or button is always released next, so nothing is left stuck
+        if (held_key) {
+            bego::Event event = *held_key;
+            event.kind = bego::EventKind::KeyUp;
+            held_key.reset();
+            return event;
+        }
+        if (held_button) {
+            held_button = false;
+            return bego::Event::button(true, bego::Button::Left);
+        }
+
+        const int pick = static_cast<int>(rng() % static_cast<uint32_t>(bounds.back()));
+        if (pick < bounds[0]) {
+            held_key = keys[rng() % keys.size()];
+            return *held_key;
+        }
+        if (pick < bounds[1]) {
+            held_button = true;
+            return bego::Event::button(false, bego::Button::Left);
+        }
+        if (pick < bounds[2]) {
+            return bego::Event::move(false, static_cast<int>(rng() % 21) - 10, static_cast<int>(rng() % 21) - 10);
+        }
+        return bego::Event::wheel(bego::Axis::Vertical, rng() % 2 ? 120 : -120);
+    }
+
+private:
+    std::mt19937 rng;
+    std::vector<bego::Event> keys;
+    std::vector<int> bounds;
+    std::optional<bego::Event> held_key;
+    bool held_button = false;
+
+    const bego::TimedEvent* script = nullptr;
+    size_t script_size = 0;
+    size_t position = 0;
+};
+
+// Stops the generator thread and joins it on every way out of main, including a failing send
+class GeneratorGuard {
+public:
+    GeneratorGuard(std::thread& thread, std::atomic<bool>& stop) : thread(thread), stop(stop) {}
+
+    ~GeneratorGuard() {
+        stop.store(true, std::memory_order_relaxed);
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+
+    GeneratorGuard(const GeneratorGuard&) = delete;
+    GeneratorGuard& operator=(const GeneratorGuard&) = delete;
+
+private:
+    std::thread& thread;
+    std::atomic<bool>& stop;
+};
+
+// Parse "4,1,4,1" into four weights
+bool parseMix(const std::string& text, std::vector<int>& weights) {
+    weights.clear();
+    size_t start = 0;
+    while (start <= text.size()) {
+        size_t comma = text.find(',', start);
+        if (comma == std::string::npos) {
+            comma = text.size();
+        }
+        int weight = std::atoi(text.substr(start, comma - start).c_str());
+        if (weight < 0) {
+            return false;
+        }
+        weights.push_back(weight);
+        start = comma + 1;
+    }
+    return weights.size() == 4 && weights[0] + weights[1] + weights[2] + weights[3] > 0;
+}
+
+int64_t percentile(const std::vector<int64_t>& sorted, double p) {
+    return sorted.empty() ? 0 : sorted[std::min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()))];
+}
+
+int main(int argc, char** argv) {
+    double rate = 10000;
+    double seconds = 5;
+    uint32_t seed = 1;
+    std::vector<int> weights = {4, 1, 4, 1};
+    std::string recording;
+    std::string backend_name = "null";
+    int64_t cost_ns = 1000;
+    size_t queue_size = 65536;
+    size_t batch_size = 256;
+
+    bool ok = true;
+    for (int i = 1; i < argc && ok; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            ok = false;
+        } else if (arg == "--rate") {
+            rate = std::atof(argv[++i]);
+        } else if (arg == "--seconds") {
+            seconds = std::atof(argv[++i]);
+        } else if (arg == "--seed") {
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--mix") {
+            ok = parseMix(argv[++i], weights);
+        } else if (arg == "--recording") {
+            recording = argv[++i];
+        } else if (arg == "--backend") {
+            backend_name = argv[++i];
+        } else if (arg == "--cost") {
+            cost_ns = std::atoll(argv[++i]);
+        } else if (arg == "--queue") {
+            queue_size = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--batch") {
+            batch_size = std::strtoull(argv[++i], nullptr, 10);
+        } else {
+            ok = false;
+        }
+    }
+    if (!ok || rate <= 0 || seconds <= 0 || queue_size == 0 || batch_size == 0 ||
+        (backend_name != "os" && backend_name != "null" && backend_name != "busy")) {
+        std::cerr << "Usage: bego-loadgen [--rate HZ] [--seconds N] [--seed N] [--mix K,B,M,S]" << std::endl
+                  << "                    [--recording FILE] [--backend os|null|busy] [--cost NS]" << std::endl
+                  << "                    [--queue N] [--batch N]" << std::endl;
+        return 2;
+    }
+
+    try {
+        std::shared_ptr<bego::Backend> backend;
+        if (backend_name == "os") {
+            backend = std::make_shared<bego::Win32Backend>();
+        } else if (backend_name == "busy") {
+            backend = std::make_shared<BusyBackend>(cost_ns);
+        } else {
+            backend = std::make_shared<bego::NullBackend>();
+        }
+        bego::Bego bego(bego::Settings(), backend);
+
+        std::unique_ptr<bego::RecordingTrack> track;
+        std::unique_ptr<Mix> mix;
+        if (!recording.empty()) {
+            track = std::make_unique<bego::RecordingTrack>(recording);
+            if (track->size() == 0) {
+                std::cerr << "Error: " << recording << " has no events" << std::endl;
+                return 1;
+            }
+            mix = std::make_unique<Mix>(*track);
+        } else {
+            mix = std::make_unique<Mix>(bego, seed, weights);
+        }
+
+        const uint64_t total = static_cast<uint64_t>(rate * seconds);
+        const double period_ns = 1e9 / rate;
+        OfferQueue queue(queue_size);
+        std::atomic<bool> generating{true};
+        std::atomic<bool> stop{false};
+        uint64_t drops = 0;
+
+        std::vector<int64_t> latency;
+        latency.reserve(static_cast<size_t>(std::min<uint64_t>(total, MAX_SAMPLES)));
+        std::vector<Offered> batch(batch_size);
+        std::vector<bego::Event> events(batch_size);
+        uint64_t sent = 0;
+        uint64_t dispatches = 0;
+        uint64_t depth_sum = 0;
+        size_t depth_max = 0;
+
+        std::cout << "Offering " << total << " events at " << rate << " Hz through the " << backend_name
+                  << " backend" << std::endl;
+
+        const int64_t start = nowNs() + 1000000;
+        std::thread generator;
+        GeneratorGuard guard(generator, stop);
+        generator = std::thread([&] {
+            uint64_t i = 0;
+            while (i < total && !stop.load(std::memory_order_relaxed)) {
+                const int64_t now = nowNs();
+                // Everything due by now is offered at once, each with its own due time
+                while (i < total) {
+                    const int64_t due = start + static_cast<int64_t>(i * period_ns);
+                    if (due > now) {
+                        break;
+                    }
+                    // A dropped release would leave a key or button held, so releases wait for room
+                    const bego::Event event = mix->next();
+                    const bool release = event.kind == bego::EventKind::KeyUp || event.kind == bego::EventKind::ButtonUp;
+                    while (!queue.push({due, event})) {
+                        if (!release || stop.load(std::memory_order_relaxed)) {
+                            drops++;
+                            break;
+                        }
+                        std::this_thread::yield();
+                    }
+                    i++;
+                }
+                if (i < total) {
+                    const int64_t wait = start + static_cast<int64_t>(i * period_ns) - nowNs();
+                    if (wait > 200000) {
+                        std::this_thread::sleep_for(std::chrono::nanoseconds(wait - 100000));
+                    } else if (wait > 0) {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+            generating.store(false, std::memory_order_release);
+        });
+
+        for (;;) {
+            const bool finished = !generating.load(std::memory_order_acquire);
+            size_t depth = 0;
+            const size_t count = queue.pop(batch.data(), batch_size, depth);
+            if (count == 0) {
+                if (finished) {
+                    break;
+                }
+                std::this_thread::yield();
+                continue;
+            }
+
+            for (size_t i = 0; i < count; i++) {
+                events[i] = batch[i].event;
+            }
+            bego.send(events.data(), count);
+            const int64_t done = nowNs();
+
+            for (size_t i = 0; i < count && latency.size() < MAX_SAMPLES; i++) {
+                latency.push_back(done - batch[i].due);
+            }
+            sent += count;
+            dispatches++;
+            depth_sum += depth;
+            depth_max = std::max(depth_max, depth);
+        }
+        generator.join();
+        const double elapsed = (nowNs() - start) / 1e9;
+
+        std::sort(latency.begin(), latency.end());
+        auto us = [](int64_t ns) { return ns / 1000.0; };
+        std::cout << std::fixed << std::setprecision(1);
+        std::cout << "Achieved rate:  " << sent / elapsed << " events/s (" << sent << " sent in " << std::setprecision(3)
+                  << elapsed << " s)" << std::endl;
+        std::cout << "Dropped:        " << drops << " (" << std::setprecision(2)
+                  << (total ? 100.0 * drops / total : 0.0) << "%)" << std::endl;
+        std::cout << std::setprecision(1) << "Dispatches:     " << dispatches << ", "
+                  << (dispatches ? static_cast<double>(sent) / dispatches : 0.0) << " events each" << std::endl;
+        std::cout << "Queue depth:    mean " << (dispatches ? static_cast<double>(depth_sum) / dispatches : 0.0)
+                  << ", max " << depth_max << " of " << queue_size << std::endl;
+        std::cout << "Latency from due time (us):" << std::endl
+                  << "  p50 " << us(percentile(latency, 0.50)) << "  p90 " << us(percentile(latency, 0.90))
+                  << "  p99 " << us(percentile(latency, 0.99)) << "  p99.9 " << us(percentile(latency, 0.999))
+                  << "  p99.99 " << us(percentile(latency, 0.9999))
+                  << "  max " << us(latency.empty() ? 0 : latency.back()) << std::endl;
+        return 0;
+    } catch (const bego::InputError& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,88 @@
+#include <iostream>
+#include <iomanip>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include "../include/bego.h"
+#include "../include/bego_log.h"
+
+// bego-log: decode a binary log file written by bego::log::Collector::to_binary.
+// Every record is printed as one line: seconds since logging was enabled, the thread,
+// the level, the call site and the formatted message.
+//
+// Usage: bego-log <file> [--level debug|info|warning|error] [--thread N]
+//   --level   only records of this level or above
+//   --thread  only records of this thread
+
+// Parse a level name; returns false for an unknown one
+bool parseLevel(const std::string& name, bego::log::Level& level) {
+    static const char* names[] = {"debug", "info", "warning", "error"};
+    for (size_t i = 0; i < std::size(names); i++) {
+        if (name == names[i]) {
+            level = static_cast<bego::log::Level>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Parse a thread id; returns false unless the whole word is a number that fits
+bool parseThread(const char* word, uint32_t& thread) {
+    if (*word < '0' || *word > '9') {
+        return false;  // strtoul would accept a sign or leading blanks
+    }
+    char* end = nullptr;
+    errno = 0;
+    unsigned long value = std::strtoul(word, &end, 10);
+    if (*end != '\0' || errno == ERANGE || value > UINT32_MAX) {
+        return false;
+    }
+    thread = static_cast<uint32_t>(value);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    std::string path;
+    bego::log::Level minimum = bego::log::Level::Debug;
+    uint32_t thread = 0;
+    bool valid = true;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--level" && i + 1 < argc) {
+            valid = parseLevel(argv[++i], minimum) && valid;
+        } else if (arg == "--thread" && i + 1 < argc) {
+            valid = parseThread(argv[++i], thread) && valid;
+        } else if (path.empty()) {
+            path = arg;
+        } else {
+            valid = false;
+        }
+    }
+    if (path.empty() || !valid) {
+        std::cerr << "Usage: bego-log <file> [--level debug|info|warning|error] [--thread N]" << std::endl;
+        return 2;
+    }
+
+    try {
+        bego::log::LogFile file = bego::log::load(path);
+        size_t shown = 0;
+        for (const bego::log::Record& record : file.records) {
+            if (record.format >= file.formats.size() || file.formats[record.format].text.empty()) {
+                std::cout << "Record with unknown format " << record.format << std::endl;
+                continue;
+            }
+            const bego::log::Format& format = file.formats[record.format];
+            if (format.level < minimum || (thread != 0 && record.thread != thread)) {
+                continue;
+            }
+            std::cout << bego::log::render(format, record, file.origin) << '\n';
+            shown++;
+        }
+        std::cout << shown << " of " << file.records.size() << " records" << std::endl;
+        return 0;
+    } catch (const bego::InputError& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
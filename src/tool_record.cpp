@@ -0,0 +1,557 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "../include/bego_win.h"
+#include "../include/bego_recording.h"
+
+#if defined(__linux__)
+#include <dirent.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/input.h>
+#endif
+
+// bego-record: capture real keyboard and mouse input into a binary recording.
+// Input comes from evdev devices on Linux and from raw input on Windows; every
+// event is timestamped on the monotonic clock and appended as a 16-byte record.
+//
+// Usage: bego-record <output> [--device PATH]... [--seconds N] [--synthetic HZ]
+//   --device     evdev device to read (Linux; default: every readable keyboard/mouse)
+//   --seconds    stop after N seconds instead of waiting for Ctrl+C
+//   --synthetic  record generated mouse moves at HZ instead of real input, to check
+//                that the recording path keeps up with a given rate
+
+using Clock = std::chrono::steady_clock;
+
+// Global flag cleared by Ctrl+C
+std::atomic<bool> g_running = true;
+
+// Capture counters reported at the end
+struct CaptureStats {
+    uint64_t gaps = 0;      // Times the input source reported lost input
+    uint64_t skipped = 0;   // Events with no equivalent in the recording format
+};
+
+// Command-line options
+struct Options {
+    std::string output;
+    std::vector<std::string> devices;
+    double seconds = 0;
+    double synthetic_hz = 0;
+};
+
+void onSignal(int) {
+    g_running = false;
+}
+
+// Nanoseconds on the steady clock
+int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+// Whether the capture should go on
+bool keepRunning(Clock::time_point deadline) {
+    return g_running && Clock::now() < deadline;
+}
+
+// Report a gap in the input stream
+void reportGap(CaptureStats& stats, bego::RecordingWriter& writer, const std::string& source, int64_t time) {
+    stats.gaps++;
+    writer.note_dropped(1);
+    std::cerr << "[" << std::fixed << std::setprecision(3) << std::setw(10) << time / 1e9 << " s] gap: " << source
+              << " lost input" << std::endl;
+}
+
+// Append moves, split so each fits the 16-bit relative range of an Event
+void appendMove(bego::RecordingWriter& writer, int64_t time, int dx, int dy) {
+    do {
+        int x = std::clamp(dx, -32768, 32767);
+        int y = std::clamp(dy, -32768, 32767);
+        writer.append({time, bego::Event::move(false, x, y)});
+        dx -= x;
+        dy -= y;
+    } while (dx != 0 || dy != 0);
+}
+
+// Generate relative moves at a fixed rate. A gap is reported whenever the
+// generator falls more than ten periods behind its schedule.
+void captureSynthetic(const Options& options, bego::RecordingWriter& writer, CaptureStats& stats,
+                      Clock::time_point start, Clock::time_point deadline) {
+    const auto period = std::chrono::nanoseconds(static_cast<int64_t>(1e9 / options.synthetic_hz));
+    Clock::time_point next = start;
+    uint64_t index = 0;
+
+    while (keepRunning(deadline)) {
+        std::this_thread::sleep_until(next);
+        Clock::time_point now = Clock::now();
+        // Measured before catching up, which always brings next past now
+        const auto lag = now - next;
+
+        // Emit every event that is due, as a real device delivering a burst would
+        while (next <= now) {
+            int64_t time = std::chrono::duration_cast<std::chrono::nanoseconds>(next - start).count();
+            writer.append({time, bego::Event::move(false, (index & 1) ? 1 : -1, 0)});
+            index++;
+            next += period;
+        }
+
+        if (lag > 10 * period) {
+            reportGap(stats, writer, "synthetic generator", std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count());
+        }
+    }
+}
+
+#if defined(__linux__)
+
+// An open evdev device and its partially assembled motion
+struct Device {
+    int fd;
+    std::string path;
+    int dx = 0;
+    int dy = 0;
+    bool dropping = false;  // Between SYN_DROPPED and the next SYN_REPORT
+};
+
+// Test one bit of an evdev capability bitmap
+bool testBit(const unsigned long* bits, unsigned int bit) {
+    return (bits[bit / (8 * sizeof(unsigned long))] >> (bit % (8 * sizeof(unsigned long)))) & 1;
+}
+
+// Open a device if it produces keys or relative motion
+bool openDevice(const std::string& path, std::vector<Device>& devices, bool verbose) {
+    int fd = open(path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        if (verbose) {
+            std::cerr << "Cannot open " << path << ": " << std::strerror(errno) << std::endl;
+        }
+        return false;
+    }
+
+    unsigned long types[(EV_MAX + 8 * sizeof(unsigned long)) / (8 * sizeof(unsigned long))] = {};
+    if (ioctl(fd, EVIOCGBIT(0, sizeof(types)), types) < 0 || !(testBit(types, EV_KEY) || testBit(types, EV_REL))) {
+        close(fd);
+        return false;
+    }
+
+    // Timestamps on the monotonic clock, the one Clock uses
+    int clock = CLOCK_MONOTONIC;
+    ioctl(fd, EVIOCSCLOCKID, &clock);
+
+    char name[256] = "unknown";
+    ioctl(fd, EVIOCGNAME(sizeof(name)), name);
+    std::cout << "Recording " << path << " (" << name << ")" << std::endl;
+
+    devices.push_back(Device{fd, path});
+    return true;
+}
+
+// Translate an evdev key code to a set-1 scan code and extended flag.
+// Codes 1-88 are identical in both; extended keys need a table.
+bool evdevToScan(unsigned int code, uint16_t& scan, uint8_t& flags) {
+    struct Extended { unsigned int code; uint16_t scan; };
+    static const Extended extended[] = {
+        {KEY_KPENTER, 0x1C}, {KEY_RIGHTCTRL, 0x1D}, {KEY_KPSLASH, 0x35}, {KEY_SYSRQ, 0x37},
+        {KEY_RIGHTALT, 0x38}, {KEY_HOME, 0x47}, {KEY_UP, 0x48}, {KEY_PAGEUP, 0x49},
+        {KEY_LEFT, 0x4B}, {KEY_RIGHT, 0x4D}, {KEY_END, 0x4F}, {KEY_DOWN, 0x50},
+        {KEY_PAGEDOWN, 0x51}, {KEY_INSERT, 0x52}, {KEY_DELETE, 0x53}, {KEY_LEFTMETA, 0x5B},
+        {KEY_RIGHTMETA, 0x5C}, {KEY_COMPOSE, 0x5D}
+    };
+
+    flags = bego::event_flags::Scancode;
+    if (code >= 1 && code <= 88) {
+        scan = static_cast<uint16_t>(code);
+        return true;
+    }
+    for (const Extended& entry : extended) {
+        if (entry.code == code) {
+            scan = entry.scan;
+            flags |= bego::event_flags::Extended;
+            return true;
+        }
+    }
+    return false;
+}
+
+// A translated event; relative moves keep their full-range totals in dx/dy
+struct Captured {
+    int64_t time;
+    bego::Event event;
+    int dx = 0;
+    int dy = 0;
+};
+
+// Translate one evdev event; motion is accumulated until SYN_REPORT
+void translate(Device& device, const input_event& ev, int64_t time, std::vector<Captured>& out,
+               CaptureStats& stats, bego::RecordingWriter& writer) {
+    if (ev.type == EV_SYN) {
+        if (ev.code == SYN_DROPPED) {
+            // The kernel buffer overflowed; the events up to the next report are incomplete
+            device.dropping = true;
+            device.dx = device.dy = 0;
+            reportGap(stats, writer, device.path, time);
+        } else if (ev.code == SYN_REPORT) {
+            if (!device.dropping && (device.dx != 0 || device.dy != 0)) {
+                out.push_back({time, bego::Event::move(false, 0, 0), device.dx, device.dy});
+            }
+            device.dx = device.dy = 0;
+            device.dropping = false;
+        }
+        return;
+    }
+    if (device.dropping) {
+        return;
+    }
+
+    if (ev.type == EV_REL) {
+        switch (ev.code) {
+            case REL_X:
+                device.dx += ev.value;
+                break;
+            case REL_Y:
+                device.dy += ev.value;
+                break;
+            case REL_WHEEL:
+                out.push_back({time, bego::Event::wheel(bego::Axis::Vertical, ev.value * WHEEL_DELTA)});
+                break;
+            case REL_HWHEEL:
+                out.push_back({time, bego::Event::wheel(bego::Axis::Horizontal, ev.value * WHEEL_DELTA)});
+                break;
+            default:
+                break;
+        }
+        return;
+    }
+
+    if (ev.type != EV_KEY) {
+        return;
+    }
+
+    // Autorepeat (value 2) is recorded as another press, as Windows reports it
+    const bool up = ev.value == 0;
+    switch (ev.code) {
+        case BTN_LEFT:
+            out.push_back({time, bego::Event::button(up, bego::Button::Left)});
+            return;
+        case BTN_RIGHT:
+            out.push_back({time, bego::Event::button(up, bego::Button::Right)});
+            return;
+        case BTN_MIDDLE:
+            out.push_back({time, bego::Event::button(up, bego::Button::Middle)});
+            return;
+        case BTN_SIDE:
+            out.push_back({time, bego::Event::button(up, bego::Button::Back)});
+            return;
+        case BTN_EXTRA:
+            out.push_back({time, bego::Event::button(up, bego::Button::Forward)});
+            return;
+        default:
+            break;
+    }
+
+    uint16_t scan;
+    uint8_t flags;
+    if (ev.code < BTN_MISC && evdevToScan(ev.code, scan, flags)) {
+        out.push_back({time, bego::Event::key(up, 0, scan, flags)});
+    } else {
+        stats.skipped++;
+    }
+}
+
+// Read evdev devices until stopped
+bool captureDevices(const Options& options, bego::RecordingWriter& writer, CaptureStats& stats,
+                    Clock::time_point start, Clock::time_point deadline) {
+    std::vector<Device> devices;
+    if (options.devices.empty()) {
+        if (DIR* dir = opendir("/dev/input")) {
+            while (dirent* entry = readdir(dir)) {
+                if (std::strncmp(entry->d_name, "event", 5) == 0) {
+                    openDevice(std::string("/dev/input/") + entry->d_name, devices, false);
+                }
+            }
+            closedir(dir);
+        }
+    } else {
+        for (const std::string& path : options.devices) {
+            openDevice(path, devices, true);
+        }
+    }
+    if (devices.empty()) {
+        std::cerr << "No readable input devices (try running as a member of the 'input' group)" << std::endl;
+        return false;
+    }
+
+    const int64_t start_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(start.time_since_epoch()).count();
+    std::vector<pollfd> fds;
+    for (const Device& device : devices) {
+        fds.push_back(pollfd{device.fd, POLLIN, 0});
+    }
+
+    std::vector<Captured> round;
+    input_event buffer[64];
+    int64_t last = 0;
+    size_t open_devices = devices.size();
+
+    while (open_devices > 0 && keepRunning(deadline)) {
+        if (poll(fds.data(), fds.size(), 100) <= 0) {
+            continue;
+        }
+
+        round.clear();
+        for (size_t i = 0; i < devices.size(); i++) {
+            // An unplugged device reports an error forever; stop polling it
+            if (fds[i].revents & (POLLERR | POLLHUP | POLLNVAL)) {
+                std::cerr << "Lost " << devices[i].path << ", no longer recording it" << std::endl;
+                close(devices[i].fd);
+                devices[i].fd = -1;
+                fds[i].fd = -1;  // poll skips negative descriptors
+                open_devices--;
+                continue;
+            }
+            if (!(fds[i].revents & POLLIN)) {
+                continue;
+            }
+            ssize_t length;
+            while ((length = read(devices[i].fd, buffer, sizeof(buffer))) > 0) {
+                for (size_t j = 0; j < static_cast<size_t>(length) / sizeof(input_event); j++) {
+                    const input_event& ev = buffer[j];
+                    int64_t time = static_cast<int64_t>(ev.input_event_sec) * 1000000000 +
+                                   static_cast<int64_t>(ev.input_event_usec) * 1000 - start_ns;
+                    translate(devices[i], ev, time, round, stats, writer);
+                }
+            }
+        }
+
+        // Devices are read one after another; put their events back in time order
+        std::stable_sort(round.begin(), round.end(),
+                         [](const Captured& a, const Captured& b) { return a.time < b.time; });
+        for (const Captured& record : round) {
+            int64_t time = std::max(record.time, last);
+            last = time;
+            if (record.event.kind == bego::EventKind::MoveRel) {
+                appendMove(writer, time, record.dx, record.dy);
+            } else {
+                writer.append({time, record.event});
+            }
+        }
+    }
+
+    for (const Device& device : devices) {
+        if (device.fd >= 0) {
+            close(device.fd);
+        }
+    }
+    if (open_devices == 0) {
+        std::cerr << "All input devices are gone, stopping" << std::endl;
+    }
+    return true;
+}
+
+#elif defined(_WIN32)
+
+// Raw input state shared with the window procedure
+bego::RecordingWriter* g_writer = nullptr;
+int64_t g_start_ns = 0;
+int64_t g_last_ns = 0;
+CaptureStats* g_stats = nullptr;
+
+// Current time on the performance counter, in nanoseconds
+int64_t counterNs() {
+    static const int64_t frequency = [] {
+        LARGE_INTEGER f;
+        QueryPerformanceFrequency(&f);
+        return static_cast<int64_t>(f.QuadPart);
+    }();
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return counter.QuadPart / frequency * 1000000000 + counter.QuadPart % frequency * 1000000000 / frequency;
+}
+
+// Append one raw input event
+void handleRawInput(const RAWINPUT& input) {
+    int64_t time = std::max(counterNs() - g_start_ns, g_last_ns);
+    g_last_ns = time;
+    bego::RecordingWriter& writer = *g_writer;
+
+    if (input.header.dwType == RIM_TYPEKEYBOARD) {
+        const RAWKEYBOARD& kb = input.data.keyboard;
+        uint8_t flags = bego::event_flags::Scancode;
+        if (kb.Flags & RI_KEY_E0) {
+            flags |= bego::event_flags::Extended;
+        }
+        writer.append({time, bego::Event::key((kb.Flags & RI_KEY_BREAK) != 0, kb.VKey, kb.MakeCode, flags)});
+        return;
+    }
+
+    if (input.header.dwType != RIM_TYPEMOUSE) {
+        return;
+    }
+
+    const RAWMOUSE& mouse = input.data.mouse;
+    if (mouse.usFlags & MOUSE_MOVE_ABSOLUTE) {
+        writer.append({time, bego::Event::move(true, mouse.lLastX, mouse.lLastY)});
+    } else if (mouse.lLastX != 0 || mouse.lLastY != 0) {
+        appendMove(writer, time, mouse.lLastX, mouse.lLastY);
+    }
+
+    struct ButtonFlag { USHORT flag; bool up; bego::Button button; };
+    static const ButtonFlag buttons[] = {
+        {RI_MOUSE_LEFT_BUTTON_DOWN, false, bego::Button::Left}, {RI_MOUSE_LEFT_BUTTON_UP, true, bego::Button::Left},
+        {RI_MOUSE_RIGHT_BUTTON_DOWN, false, bego::Button::Right}, {RI_MOUSE_RIGHT_BUTTON_UP, true, bego::Button::Right},
+        {RI_MOUSE_MIDDLE_BUTTON_DOWN, false, bego::Button::Middle}, {RI_MOUSE_MIDDLE_BUTTON_UP, true, bego::Button::Middle},
+        {RI_MOUSE_BUTTON_4_DOWN, false, bego::Button::Back}, {RI_MOUSE_BUTTON_4_UP, true, bego::Button::Back},
+        {RI_MOUSE_BUTTON_5_DOWN, false, bego::Button::Forward}, {RI_MOUSE_BUTTON_5_UP, true, bego::Button::Forward}
+    };
+    for (const ButtonFlag& entry : buttons) {
+        if (mouse.usButtonFlags & entry.flag) {
+            writer.append({time, bego::Event::button(entry.up, entry.button)});
+        }
+    }
+
+    if (mouse.usButtonFlags & RI_MOUSE_WHEEL) {
+        writer.append({time, bego::Event::wheel(bego::Axis::Vertical, static_cast<SHORT>(mouse.usButtonData))});
+    }
+    if (mouse.usButtonFlags & RI_MOUSE_HWHEEL) {
+        writer.append({time, bego::Event::wheel(bego::Axis::Horizontal, static_cast<SHORT>(mouse.usButtonData))});
+    }
+}
+
+// Window procedure of the hidden message-only window
+LRESULT CALLBACK rawInputProc(HWND hwnd, UINT message, WPARAM wparam, LPARAM lparam) {
+    if (message == WM_INPUT) {
+        alignas(8) BYTE buffer[sizeof(RAWINPUT) + 64];
+        UINT size = sizeof(buffer);
+        if (GetRawInputData(reinterpret_cast<HRAWINPUT>(lparam), RID_INPUT, buffer, &size, sizeof(RAWINPUTHEADER)) != static_cast<UINT>(-1)) {
+            handleRawInput(*reinterpret_cast<const RAWINPUT*>(buffer));
+        }
+    }
+    return DefWindowProcA(hwnd, message, wparam, lparam);
+}
+
+// Stop on Ctrl+C
+BOOL WINAPI onConsoleEvent(DWORD) {
+    g_running = false;
+    return TRUE;
+}
+
+// Read raw input until stopped. Raw input has no overflow notification, so no
+// gaps can be detected here.
+bool captureDevices(const Options& options, bego::RecordingWriter& writer, CaptureStats& stats,
+                    Clock::time_point start, Clock::time_point deadline) {
+    SetConsoleCtrlHandler(onConsoleEvent, TRUE);
+
+    WNDCLASSEXA wc = {};
+    wc.cbSize = sizeof(wc);
+    wc.lpfnWndProc = rawInputProc;
+    wc.hInstance = GetModuleHandleA(nullptr);
+    wc.lpszClassName = "BegoRecordWindow";
+    RegisterClassExA(&wc);
+
+    HWND hwnd = CreateWindowExA(0, wc.lpszClassName, "", 0, 0, 0, 0, 0, HWND_MESSAGE, nullptr, wc.hInstance, nullptr);
+    RAWINPUTDEVICE rid[2] = {
+        {0x01, 0x02, RIDEV_INPUTSINK, hwnd},  // Mouse
+        {0x01, 0x06, RIDEV_INPUTSINK, hwnd}   // Keyboard
+    };
+    if (hwnd == nullptr || !RegisterRawInputDevices(rid, 2, sizeof(RAWINPUTDEVICE))) {
+        std::cerr << "Cannot register for raw input" << std::endl;
+        return false;
+    }
+
+    g_writer = &writer;
+    g_stats = &stats;
+    g_start_ns = counterNs();
+    std::cout << "Recording raw keyboard and mouse input" << std::endl;
+
+    MSG msg;
+    while (keepRunning(deadline)) {
+        MsgWaitForMultipleObjects(0, nullptr, FALSE, 100, QS_RAWINPUT);
+        while (PeekMessageA(&msg, nullptr, 0, 0, PM_REMOVE)) {
+            DispatchMessageA(&msg);
+        }
+    }
+
+    DestroyWindow(hwnd);
+    return true;
+}
+
+#else
+
+bool captureDevices(const Options&, bego::RecordingWriter&, CaptureStats&, Clock::time_point, Clock::time_point) {
+    std::cerr << "Device capture is not supported on this platform; use --synthetic" << std::endl;
+    return false;
+}
+
+#endif
+
+// Parse the command line
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--device" && i + 1 < argc) {
+            options.devices.push_back(argv[++i]);
+        } else if (arg == "--seconds" && i + 1 < argc) {
+            options.seconds = std::atof(argv[++i]);
+        } else if (arg == "--synthetic" && i + 1 < argc) {
+            options.synthetic_hz = std::atof(argv[++i]);
+        } else if (options.output.empty() && !arg.empty() && arg[0] != '-') {
+            options.output = arg;
+        } else {
+            return false;
+        }
+    }
+    return !options.output.empty() && options.seconds >= 0 && options.synthetic_hz >= 0;
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Usage: bego-record <output> [--device PATH]... [--seconds N] [--synthetic HZ]" << std::endl;
+        return 2;
+    }
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    try {
+        bego::RecordingWriter writer(options.output);
+        CaptureStats stats;
+
+        const Clock::time_point start = Clock::now();
+        const Clock::time_point deadline =
+            options.seconds > 0 ? start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.seconds))
+                                : Clock::time_point::max();
+        writer.set_start_time(nowNs());
+
+        std::cout << "Writing " << options.output << ", press Ctrl+C to stop" << std::endl;
+        bool ok = true;
+        if (options.synthetic_hz > 0) {
+            captureSynthetic(options, writer, stats, start, deadline);
+        } else {
+            ok = captureDevices(options, writer, stats, start, deadline);
+        }
+
+        const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        const uint64_t records = writer.size();
+        const uint64_t stalls = writer.stalls();
+        writer.close();
+
+        std::cout << std::fixed << std::setprecision(1)
+                  << "Recorded " << records << " events in " << elapsed << " s (" << records / elapsed << " events/s)" << std::endl
+                  << "Gaps reported: " << stats.gaps << ", writer stalls: " << stalls
+                  << ", untranslatable events: " << stats.skipped << std::endl;
+        return ok ? (stats.gaps == 0 ? 0 : 1) : 1;
+    } catch (const bego::InputError& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,240 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "../include/bego_win.h"
+#include "../include/bego_recording.h"
+#include "../include/bego_replay.h"
+
+// bego-verify: replay a recording through Bego into an in-memory capture and check
+// that what came out matches the recording, event for event and in timing.
+// Events are aligned by sequence number. Content mismatches are listed; timing is
+// reported as the distribution of inter-event error (how much each gap between two
+// consecutive events differs from the recorded gap) and of lag behind the schedule.
+//
+// Usage: bego-verify <recording> [--speed F] [--tolerance US]
+//   --speed      playback speed factor (default 1)
+//   --tolerance  fail if the 99th percentile inter-event error exceeds US microseconds
+
+using Clock = std::chrono::steady_clock;
+
+// Nanoseconds on the steady clock
+int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+// Most mismatches listed; the rest are only counted
+constexpr size_t MAX_LISTED = 10;
+
+// Backend that keeps every event with the time it was dispatched
+class CaptureBackend : public bego::Backend {
+public:
+    explicit CaptureBackend(size_t expected) {
+        captured.reserve(expected);
+    }
+
+    void dispatch(const bego::Event* events, size_t count) override {
+        const int64_t now = nowNs();
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t i = 0; i < count; i++) {
+            captured.push_back({now, events[i]});
+        }
+    }
+
+    // Take the captured events; later dispatches (releases on shutdown) are not included
+    std::vector<bego::TimedEvent> take() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return std::move(captured);
+    }
+
+private:
+    std::mutex mutex;
+    std::vector<bego::TimedEvent> captured;
+};
+
+// Summary of one error distribution, in nanoseconds
+struct Distribution {
+    double mean = 0;
+    double stddev = 0;
+    int64_t min = 0;
+    int64_t p50 = 0;
+    int64_t p90 = 0;
+    int64_t p99 = 0;
+    int64_t p999 = 0;
+    int64_t max = 0;
+};
+
+// Sorts the samples in place
+Distribution summarize(std::vector<int64_t>& samples) {
+    Distribution result;
+    if (samples.empty()) {
+        return result;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    auto percentile = [&](double p) {
+        return samples[std::min(samples.size() - 1, static_cast<size_t>(p * samples.size()))];
+    };
+
+    double sum = 0;
+    for (int64_t sample : samples) {
+        sum += static_cast<double>(sample);
+    }
+    result.mean = sum / samples.size();
+    double squares = 0;
+    for (int64_t sample : samples) {
+        squares += (sample - result.mean) * (sample - result.mean);
+    }
+    result.stddev = std::sqrt(squares / samples.size());
+
+    result.min = samples.front();
+    result.p50 = percentile(0.50);
+    result.p90 = percentile(0.90);
+    result.p99 = percentile(0.99);
+    result.p999 = percentile(0.999);
+    result.max = samples.back();
+    return result;
+}
+
+// Print a distribution in microseconds
+void printDistribution(const std::string& name, const Distribution& d) {
+    auto us = [](double ns) { return ns / 1000.0; };
+    std::cout << std::fixed << std::setprecision(1) << name << " (us): mean " << us(d.mean) << ", stddev "
+              << us(d.stddev) << std::endl
+              << "  min " << us(d.min) << "  p50 " << us(d.p50) << "  p90 " << us(d.p90) << "  p99 " << us(d.p99)
+              << "  p99.9 " << us(d.p999) << "  max " << us(d.max) << std::endl;
+}
+
+// Print how many absolute errors fall in each decade
+void printHistogram(const std::vector<int64_t>& sorted_abs) {
+    static const int64_t bounds[] = {1000, 10000, 100000, 1000000, 10000000};
+    static const char* labels[] = {"< 1 us", "< 10 us", "< 100 us", "< 1 ms", "< 10 ms", ">= 10 ms"};
+
+    size_t begin = 0;
+    for (size_t i = 0; i <= std::size(bounds); i++) {
+        size_t end = i < std::size(bounds)
+                         ? static_cast<size_t>(std::lower_bound(sorted_abs.begin(), sorted_abs.end(), bounds[i]) -
+                                               sorted_abs.begin())
+                         : sorted_abs.size();
+        std::cout << "  " << std::left << std::setw(9) << labels[i] << std::right << std::setw(10) << end - begin
+                  << std::endl;
+        begin = end;
+    }
+}
+
+// Describe an event for mismatch reports
+std::string describe(const bego::Event& event) {
+    static const char* kinds[] = {"KeyDown", "KeyUp", "ButtonDown", "ButtonUp", "MoveAbs", "MoveRel", "Wheel", "HWheel"};
+    size_t kind = static_cast<size_t>(event.kind);
+    return std::string(kind < std::size(kinds) ? kinds[kind] : "?") + " code=" + std::to_string(event.code) +
+           " payload=" + std::to_string(event.payload) + " flags=" + std::to_string(event.flags);
+}
+
+bool sameEvent(const bego::Event& a, const bego::Event& b) {
+    return a.kind == b.kind && a.flags == b.flags && a.code == b.code && a.payload == b.payload;
+}
+
+int main(int argc, char** argv) {
+    std::string path;
+    double speed = 1.0;
+    double tolerance_us = -1;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--speed" && i + 1 < argc) {
+            speed = std::atof(argv[++i]);
+        } else if (arg == "--tolerance" && i + 1 < argc) {
+            tolerance_us = std::atof(argv[++i]);
+        } else if (path.empty()) {
+            path = arg;
+        } else {
+            path.clear();
+            break;
+        }
+    }
+    if (path.empty() || speed <= 0) {
+        std::cerr << "Usage: bego-verify <recording> [--speed F] [--tolerance US]" << std::endl;
+        return 2;
+    }
+
+    try {
+        bego::RecordingTrack track(path);
+        const size_t expected = track.size();
+        const bego::TimedEvent* recorded = track.records();
+        std::cout << "Replaying " << expected << " events from " << path << std::endl;
+
+        auto capture = std::make_shared<CaptureBackend>(expected);
+        bego::Bego bego(bego::Settings(), capture);
+
+        bego::Replay replay;
+        replay.add_track(track, speed);
+        const int64_t start = nowNs();
+        replay.play(bego);
+        std::vector<bego::TimedEvent> captured = capture->take();
+
+        // Content, aligned by sequence
+        const size_t common = std::min(expected, captured.size());
+        size_t mismatches = 0;
+        for (size_t i = 0; i < common; i++) {
+            if (!sameEvent(recorded[i].event, captured[i].event)) {
+                if (mismatches < MAX_LISTED) {
+                    std::cout << "Mismatch at #" << i << ": recorded " << describe(recorded[i].event) << ", replayed "
+                              << describe(captured[i].event) << std::endl;
+                }
+                mismatches++;
+            }
+        }
+        if (mismatches > MAX_LISTED) {
+            std::cout << "... and " << mismatches - MAX_LISTED << " more mismatches" << std::endl;
+        }
+        if (captured.size() != expected) {
+            std::cout << "Event count differs: recorded " << expected << ", replayed " << captured.size() << std::endl;
+        }
+
+        // Timing: each gap against the recorded gap, and each event against its schedule
+        std::vector<int64_t> gap_error;
+        std::vector<int64_t> lag;
+        gap_error.reserve(common);
+        lag.reserve(common);
+        for (size_t i = 0; i < common; i++) {
+            const int64_t scheduled = static_cast<int64_t>(std::llround(recorded[i].timestamp / speed));
+            lag.push_back(captured[i].timestamp - start - scheduled);
+            if (i > 0) {
+                const int64_t recorded_gap =
+                    scheduled - static_cast<int64_t>(std::llround(recorded[i - 1].timestamp / speed));
+                gap_error.push_back(captured[i].timestamp - captured[i - 1].timestamp - recorded_gap);
+            }
+        }
+
+        std::vector<int64_t> abs_error(gap_error);
+        for (int64_t& error : abs_error) {
+            error = std::abs(error);
+        }
+        Distribution gap = summarize(gap_error);
+        Distribution absolute = summarize(abs_error);
+        Distribution behind = summarize(lag);
+
+        std::cout << "Content: " << common - mismatches << " of " << expected << " events match" << std::endl;
+        printDistribution("Inter-event error", gap);
+        printDistribution("Lag behind schedule", behind);
+        std::cout << "Absolute inter-event error:" << std::endl;
+        printHistogram(abs_error);
+
+        bool ok = mismatches == 0 && captured.size() == expected;
+        if (tolerance_us >= 0 && absolute.p99 > tolerance_us * 1000) {
+            std::cout << "p99 absolute inter-event error " << absolute.p99 / 1000.0 << " us exceeds tolerance "
+                      << tolerance_us << " us" << std::endl;
+            ok = false;
+        }
+        std::cout << (ok ? "PASS" : "FAIL") << std::endl;
+        return ok ? 0 : 1;
+    } catch (const bego::InputError& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,364 @@
+#include "../include/bego_virtual_desktop.h"
+#include "../include/bego_win.h"
+#include <algorithm>
+
+/**
+ * @file virtual_desktop.cpp
+ * @author Eterninety
+ * @brief Implementation of the simulated desktop backend
+ *
+ * @note EDUCATIONAL PURPOSE ONLY
+ * This library was developed for studying anti-cheat systems in games through penetration testing.
+ * It is intended strictly for educational purposes to understand hardware-level input simulation.
+ * DO NOT use this to bypass anti-cheat systems or create unfair advantages in games.
+ */
+
+namespace bego {
+
+namespace {
+
+/**
+ * @brief Builds the US QWERTY layout
+ */
+KeyboardLayout make_us_layout() {
+    KeyboardLayout layout;
+    auto add = [&](uint8_t vk, uint16_t scan, char normal, char shifted) {
+        layout.vk_by_scan[(scan & 0xFF) | ((scan >> 8) == 0xE0 ? 0x100 : 0)] = vk;
+        layout.normal[vk] = normal;
+        layout.shifted[vk] = shifted;
+    };
+
+    static const char* const rows[] = {"QWERTYUIOP", "ASDFGHJKL", "ZXCVBNM"};
+    static const uint16_t row_starts[] = {0x10, 0x1E, 0x2C};
+    for (int row = 0; row < 3; row++) {
+        for (int i = 0; rows[row][i]; i++) {
+            char upper = rows[row][i];
+            add(static_cast<uint8_t>(upper), static_cast<uint16_t>(row_starts[row] + i),
+                static_cast<char>(upper - 'A' + 'a'), upper);
+        }
+    }
+
+    static const char digit_shifted[] = ")!@#$%^&*(";
+    for (int digit = 0; digit < 10; digit++) {
+        add(static_cast<uint8_t>('0' + digit), static_cast<uint16_t>(digit == 0 ? 0x0B : 0x01 + digit),
+            static_cast<char>('0' + digit), digit_shifted[digit]);
+    }
+
+    static const uint16_t numpad[] = {0x52, 0x4F, 0x50, 0x51, 0x4B, 0x4C, 0x4D, 0x47, 0x48, 0x49};
+    for (int digit = 0; digit < 10; digit++) {
+        add(static_cast<uint8_t>(VK_NUMPAD0 + digit), numpad[digit], static_cast<char>('0' + digit), 0);
+    }
+    for (int i = 0; i < 10; i++) {
+        add(static_cast<uint8_t>(VK_F1 + i), static_cast<uint16_t>(0x3B + i), 0, 0);
+    }
+    add(VK_F11, 0x57, 0, 0);
+    add(VK_F12, 0x58, 0, 0);
+
+    struct Other {
+        uint8_t vk;
+        uint16_t scan;
+        char normal;
+        char shifted;
+    };
+    static const Other others[] = {
+        {VK_ESCAPE, 0x01, 0, 0}, {VK_BACK, 0x0E, 0, 0}, {VK_TAB, 0x0F, '\t', '\t'},
+        {VK_RETURN, 0x1C, '\n', '\n'}, {VK_SPACE, 0x39, ' ', ' '}, {VK_CAPITAL, 0x3A, 0, 0},
+        {VK_LSHIFT, 0x2A, 0, 0}, {VK_RSHIFT, 0x36, 0, 0}, {VK_LCONTROL, 0x1D, 0, 0},
+        {VK_RCONTROL, 0xE01D, 0, 0}, {VK_LMENU, 0x38, 0, 0}, {VK_RMENU, 0xE038, 0, 0},
+        {VK_PAUSE, 0x45, 0, 0}, {VK_NUMLOCK, 0xE045, 0, 0}, {VK_SCROLL, 0x46, 0, 0},
+        {VK_PRIOR, 0xE049, 0, 0}, {VK_NEXT, 0xE051, 0, 0}, {VK_END, 0xE04F, 0, 0}, {VK_HOME, 0xE047, 0, 0},
+        {VK_LEFT, 0xE04B, 0, 0}, {VK_UP, 0xE048, 0, 0}, {VK_RIGHT, 0xE04D, 0, 0}, {VK_DOWN, 0xE050, 0, 0},
+        {VK_SNAPSHOT, 0xE037, 0, 0}, {VK_INSERT, 0xE052, 0, 0}, {VK_DELETE, 0xE053, 0, 0},
+        {VK_LWIN, 0xE05B, 0, 0}, {VK_RWIN, 0xE05C, 0, 0}, {VK_APPS, 0xE05D, 0, 0},
+        {VK_MULTIPLY, 0x37, '*', 0}, {VK_ADD, 0x4E, '+', 0}, {VK_SUBTRACT, 0x4A, '-', 0},
+        {VK_DECIMAL, 0x53, '.', 0}, {VK_DIVIDE, 0xE035, '/', 0},
+        {VK_OEM_1, 0x27, ';', ':'}, {VK_OEM_PLUS, 0x0D, '=', '+'}, {VK_OEM_COMMA, 0x33, ',', '<'},
+        {VK_OEM_MINUS, 0x0C, '-', '_'}, {VK_OEM_PERIOD, 0x34, '.', '>'}, {VK_OEM_2, 0x35, '/', '?'},
+        {VK_OEM_3, 0x29, '`', '~'}, {VK_OEM_4, 0x1A, '[', '{'}, {VK_OEM_5, 0x2B, '\\', '|'},
+        {VK_OEM_6, 0x1B, ']', '}'}, {VK_OEM_7, 0x28, '\'', '"'},
+    };
+    for (const Other& other : others) {
+        add(other.vk, other.scan, other.normal, other.shifted);
+    }
+    return layout;
+}
+
+} // namespace
+
+/**
+ * @brief Gets the US QWERTY layout
+ *
+ * @return const KeyboardLayout& The layout
+ */
+const KeyboardLayout& KeyboardLayout::us() {
+    static const KeyboardLayout layout = make_us_layout();
+    return layout;
+}
+
+/**
+ * @brief Constructs a desktop with the cursor in the top-left corner
+ *
+ * @param width Screen width in pixels
+ * @param height Screen height in pixels
+ * @param layout Keyboard layout
+ * @throws InputError If either dimension is below 2
+ */
+VirtualDesktop::VirtualDesktop(int width, int height, const KeyboardLayout& layout)
+    : layout(layout), width(width), height(height) {
+    check_size(width, height);
+}
+
+/**
+ * @brief Rejects screens too small for Bego's coordinate normalization
+ */
+void VirtualDesktop::check_size(int width, int height) {
+    if (width < 2 || height < 2) {
+        throw InputError(InputError::Type::InvalidInput, "A virtual screen must be at least 2x2 pixels");
+    }
+}
+
+/**
+ * @brief Applies a batch of events to the model
+ *
+ * @param events Pointer to the first event
+ * @param count Number of events
+ * @throws InputError If an event refers to an unknown mouse button
+ */
+void VirtualDesktop::dispatch(const Event* events, size_t count) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t i = 0; i < count; i++) {
+        apply(events[i]);
+    }
+    this->count += count;
+}
+
+/**
+ * @brief Applies one event; the lock is held
+ *
+ * @param event The event
+ */
+void VirtualDesktop::apply(const Event& event) {
+    switch (event.kind) {
+        case EventKind::KeyDown:
+        case EventKind::KeyUp: {
+            const bool down = event.kind == EventKind::KeyDown;
+            if (event.flags & event_flags::Unicode) {
+                if (down) {
+                    type(event.payload & 0xFFFF);
+                }
+                return;
+            }
+
+            uint8_t vk = static_cast<uint8_t>(event.code);
+            if ((event.flags & event_flags::Scancode) || vk == 0) {
+                // Windows ignores the virtual key of scan code input
+                size_t index = (event.payload & 0xFF) | ((event.flags & event_flags::Extended) ? 0x100 : 0);
+                vk = layout.vk_by_scan[index];
+            }
+            if (vk == 0) {
+                return;
+            }
+
+            if (down) {
+                if (vk == VK_BACK) {
+                    // Drop the last UTF-8 sequence
+                    while (!text.empty() && (static_cast<unsigned char>(text.back()) & 0xC0) == 0x80) {
+                        text.pop_back();
+                    }
+                    if (!text.empty()) {
+                        text.pop_back();
+                    }
+                } else {
+                    char c = keys[VK_SHIFT] ? layout.shifted[vk] : layout.normal[vk];
+                    if (c != 0) {
+                        text.push_back(c);
+                    }
+                }
+            }
+
+            // Generic modifiers follow their left and right keys, and press the left one
+            keys[vk] = down;
+            auto pair = [&](uint8_t generic, uint8_t left, uint8_t right) {
+                if (vk == generic) {
+                    keys[left] = down;
+                } else if (vk == left || vk == right) {
+                    keys[generic] = keys[left] || keys[right];
+                }
+            };
+            pair(VK_SHIFT, VK_LSHIFT, VK_RSHIFT);
+            pair(VK_CONTROL, VK_LCONTROL, VK_RCONTROL);
+            pair(VK_MENU, VK_LMENU, VK_RMENU);
+            return;
+        }
+        case EventKind::ButtonDown:
+        case EventKind::ButtonUp:
+            if (event.code >= buttons.size()) {
+                throw InputError(InputError::Type::InvalidInput, "Invalid button type");
+            }
+            buttons[event.code] = event.kind == EventKind::ButtonDown;
+            return;
+        case EventKind::MoveAbs: {
+            // Inverse of the rounding in Bego::queue_move, so every pixel maps back to itself
+            const int64_t w = width - 1;
+            const int64_t h = height - 1;
+            x = static_cast<int>((event.x() * w + 32767) / 65535);
+            y = static_cast<int>((event.y() * h + 32767) / 65535);
+            return;
+        }
+        case EventKind::MoveRel:
+            x = std::clamp(x + event.x(), 0, width - 1);
+            y = std::clamp(y + event.y(), 0, height - 1);
+            return;
+        case EventKind::Wheel:
+            vertical += event.wheel_data();
+            return;
+        case EventKind::HWheel:
+            horizontal += event.wheel_data();
+            return;
+    }
+}
+
+/**
+ * @brief Appends a UTF-16 code unit to the typed text, pairing surrogates
+ *
+ * @param unit The code unit
+ */
+void VirtualDesktop::type(uint32_t unit) {
+    uint32_t code_point = unit;
+    if (unit >= 0xD800 && unit < 0xDC00) {
+        high_surrogate = static_cast<uint16_t>(unit);
+        return;
+    }
+    if (unit >= 0xDC00 && unit < 0xE000) {
+        if (high_surrogate == 0) {
+            return;
+        }
+        code_point = 0x10000 + ((high_surrogate - 0xD800u) << 10) + (unit - 0xDC00u);
+    }
+    high_surrogate = 0;
+
+    if (code_point < 0x80) {
+        text.push_back(static_cast<char>(code_point));
+    } else if (code_point < 0x800) {
+        text.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+        text.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else if (code_point < 0x10000) {
+        text.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+        text.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        text.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else {
+        text.push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+        text.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+        text.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        text.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+}
+
+std::optional<std::pair<int, int>> VirtualDesktop::screen_size() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return std::make_pair(width, height);
+}
+
+std::optional<std::pair<int, int>> VirtualDesktop::cursor_position() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return std::make_pair(x, y);
+}
+
+/**
+ * @brief Changes the screen size
+ *
+ * @param width Screen width in pixels
+ * @param height Screen height in pixels
+ * @throws InputError If either dimension is below 2
+ */
+void VirtualDesktop::resize(int width, int height) {
+    check_size(width, height);
+    std::lock_guard<std::mutex> lock(mutex);
+    this->width = width;
+    this->height = height;
+    x = std::min(x, width - 1);
+    y = std::min(y, height - 1);
+}
+
+/**
+ * @brief Moves the cursor directly
+ *
+ * @param x Horizontal position
+ * @param y Vertical position
+ */
+void VirtualDesktop::warp(int x, int y) {
+    std::lock_guard<std::mutex> lock(mutex);
+    this->x = std::clamp(x, 0, width - 1);
+    this->y = std::clamp(y, 0, height - 1);
+}
+
+/**
+ * @brief Checks whether a virtual key is down
+ *
+ * @param vk The virtual key code
+ * @return bool True if it is held
+ */
+bool VirtualDesktop::is_down(uint16_t vk) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return vk < keys.size() && keys[vk];
+}
+
+/**
+ * @brief Checks whether a mouse button is down
+ *
+ * @param button The button
+ * @return bool True if it is held
+ */
+bool VirtualDesktop::is_down(Button button) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t index = static_cast<size_t>(button);
+    return index < buttons.size() && buttons[index];
+}
+
+/**
+ * @brief Gets the wheel totals
+ *
+ * @return std::pair<int, int> Vertical and horizontal wheel data
+ */
+std::pair<int, int> VirtualDesktop::wheel() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return {vertical, horizontal};
+}
+
+/**
+ * @brief Gets the text typed so far
+ *
+ * @return std::string The text, as UTF-8
+ */
+std::string VirtualDesktop::typed() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return text;
+}
+
+/**
+ * @brief Gets the number of events applied
+ *
+ * @return uint64_t The event count
+ */
+uint64_t VirtualDesktop::events() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return count;
+}
+
+/**
+ * @brief Releases everything, clears the text and counters and homes the cursor
+ */
+void VirtualDesktop::reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    x = 0;
+    y = 0;
+    keys.fill(false);
+    buttons.fill(false);
+    vertical = 0;
+    horizontal = 0;
+    text.clear();
+    high_surrogate = 0;
+    count = 0;
+}
+
+} // namespace bego